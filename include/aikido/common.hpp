@@ -4,6 +4,7 @@
 #include "aikido/common/RNG.hpp"
 #include "aikido/common/Spline.hpp"
 #include "aikido/common/StepSequence.hpp"
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/common/VanDerCorput.hpp"
 #include "aikido/common/metaprogramming.hpp"
 #include "aikido/common/stream.hpp"
@@ -0,0 +1,85 @@
+#ifndef AIKIDO_COMMON_THREADPOOL_HPP_
+#define AIKIDO_COMMON_THREADPOOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace aikido {
+namespace common {
+
+/// ThreadPool is a fixed set of worker threads that execute submitted tasks in
+/// FIFO order.
+///
+/// \code
+/// ThreadPool pool(4);
+///
+/// auto future = pool.submit([]() { return 42; });
+/// assert(future.get() == 42);
+///
+/// // The destructor of ThreadPool finishes the queued tasks and joins the
+/// // threads.
+/// \endcode
+class ThreadPool final
+{
+public:
+  /// Constructs a pool of \c numThreads worker threads. The threads begin
+  /// waiting for tasks immediately upon construction.
+  /// \param[in] numThreads Number of worker threads. If zero, the number of
+  /// hardware threads is used (at least one).
+  explicit ThreadPool(std::size_t numThreads = 0u);
+
+  /// Finishes all queued tasks and joins the worker threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// Returns the number of worker threads.
+  std::size_t getNumThreads() const;
+
+  /// Queues \c task for execution on one of the worker threads.
+  ///
+  /// Exceptions thrown by \c task are propagated through the returned future.
+  /// \param[in] task Callable with no arguments.
+  /// \return Future holding the return value of \c task.
+  template <typename Callable>
+  std::future<typename std::result_of<Callable()>::type> submit(
+      Callable&& task);
+
+  /// Returns the number of hardware threads, or one if it cannot be detected.
+  static std::size_t getDefaultNumThreads();
+
+private:
+  /// The loop function that will be executed by each worker thread.
+  void spin();
+
+  /// Worker threads.
+  std::vector<std::thread> mThreads;
+
+  /// Tasks waiting to be executed.
+  std::queue<std::function<void()>> mTasks;
+
+  /// Protects mTasks and mIsStopping.
+  std::mutex mMutex;
+
+  /// Notifies the worker threads of new tasks or of stopping.
+  std::condition_variable mCondition;
+
+  /// Flag whether the pool is being destructed.
+  bool mIsStopping;
+};
+
+} // namespace common
+} // namespace aikido
+
+#include "aikido/common/detail/ThreadPool-impl.hpp"
+
+#endif // AIKIDO_COMMON_THREADPOOL_HPP_
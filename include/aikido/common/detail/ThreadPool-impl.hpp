@@ -0,0 +1,35 @@
+#include "aikido/common/ThreadPool.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+namespace aikido {
+namespace common {
+
+//==============================================================================
+template <typename Callable>
+std::future<typename std::result_of<Callable()>::type> ThreadPool::submit(
+    Callable&& task)
+{
+  using ReturnType = typename std::result_of<Callable()>::type;
+
+  // std::function requires a copyable target, so the packaged_task is held by
+  // a shared_ptr.
+  auto packagedTask = std::make_shared<std::packaged_task<ReturnType()>>(
+      std::forward<Callable>(task));
+  auto future = packagedTask->get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mIsStopping)
+      throw std::runtime_error("ThreadPool is stopping.");
+
+    mTasks.emplace([packagedTask]() { (*packagedTask)(); });
+  }
+  mCondition.notify_one();
+
+  return future;
+}
+
+} // namespace common
+} // namespace aikido
@@ -19,6 +19,7 @@
 #include "aikido/constraint/dart/FrameTestable.hpp"
 #include "aikido/constraint/dart/InverseKinematicsSampleable.hpp"
 #include "aikido/constraint/dart/JointStateSpaceHelpers.hpp"
+#include "aikido/constraint/dart/SelfCollisionMatrix.hpp"
 #include "aikido/constraint/dart/TSR.hpp"
 #include "aikido/constraint/uniform/RnBoxConstraint.hpp"
 #include "aikido/constraint/uniform/RnConstantSampler.hpp"
@@ -1,6 +1,11 @@
 #ifndef AIKIDO_CONSTRAINT_NEWTONSMETHODPROJECTABLE_HPP_
 #define AIKIDO_CONSTRAINT_NEWTONSMETHODPROJECTABLE_HPP_
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <Eigen/Dense>
 
 #include "aikido/constraint/Differentiable.hpp"
@@ -10,9 +15,29 @@ namespace aikido {
 namespace constraint {
 
 /// Uses Newton's method to project state.
+///
+/// The temporaries of a projection are kept in workspaces that are reused by
+/// later projections, so that projecting does not allocate once the
+/// workspaces have grown to the size of the problem. Each concurrent call to
+/// \c project takes its own workspace, so one instance may project from
+/// several threads at once.
 class NewtonsMethodProjectable : public Projectable
 {
 public:
+  /// Method used to solve for the Newton step.
+  enum class LinearSolver
+  {
+    /// Step with the pseudoinverse of the Jacobian, as computed by
+    /// common::pseudoinverse: the exact inverse for a square Jacobian with a
+    /// determinant above 1e-6, and otherwise a thresholded SVD.
+    PSEUDOINVERSE,
+
+    /// Damped least-squares step, computed with an LDLT decomposition of
+    /// `J * J^T + damping^2 * I`. Cheaper than PSEUDOINVERSE and better
+    /// behaved near singularities, at the cost of smaller steps.
+    DAMPED_LEAST_SQUARES
+  };
+
   /// Constructor.
   /// \param _differentiable Differentiable constraint to be projected.
   /// \param _tolerance Tolerances for checking whether the constraints
@@ -28,6 +53,8 @@ public:
       int _maxIteration = 1000,
       double _minStepSize = 1e-5);
 
+  ~NewtonsMethodProjectable() override;
+
   // Documentation inherited.
   bool project(
       const statespace::StateSpace::State* _s,
@@ -36,14 +63,76 @@ public:
   // Documentation inherited.
   statespace::ConstStateSpacePtr getStateSpace() const override;
 
+  /// Sets the method used to solve for the Newton step.
+  /// \param _solver Linear solver.
+  /// \param _damping Damping of DAMPED_LEAST_SQUARES. Ignored by
+  ///        PSEUDOINVERSE.
+  /// \throws invalid_argument if \c _damping is not positive.
+  void setLinearSolver(LinearSolver _solver, double _damping = 1e-3);
+
+  /// Returns the method used to solve for the Newton step.
+  LinearSolver getLinearSolver() const;
+
+  /// Returns the damping of DAMPED_LEAST_SQUARES.
+  double getDamping() const;
+
+  /// Sets whether to adapt the step size and carry it over between
+  /// projections.
+  ///
+  /// When enabled, each Newton step is scaled by a step size. A step that
+  /// increases the constraint violation is undone and the step size is
+  /// halved; an accepted step doubles it, up to one. Each projection starts
+  /// with the step size the previous projection ended with, which saves the
+  /// rejected steps when consecutive projections are similar, e.g. the
+  /// extension steps of CRRT. When disabled, full Newton steps are taken.
+  /// \param _warmStart Whether to warm-start the step size.
+  void setWarmStart(bool _warmStart);
+
+  /// Returns whether the step size is warm-started.
+  bool getWarmStart() const;
+
 private:
+  /// Returns true if \c _values satisfy the constraints within mTolerance.
+  bool contains(const Eigen::VectorXd& _values) const;
+
+  /// Returns the squared violation of the constraints by \c _values.
+  double computeViolation(const Eigen::VectorXd& _values) const;
+
+  /// Temporaries of one call to \c project, reused across its iterations and
+  /// by later calls.
+  struct Workspace;
+
+  /// Takes a workspace from mWorkspaces, or creates one if none is free.
+  std::unique_ptr<Workspace> acquireWorkspace() const;
+
+  /// Returns \c _workspace to mWorkspaces for later calls to \c project.
+  void releaseWorkspace(std::unique_ptr<Workspace> _workspace) const;
+
+  /// Sets the tangent step of \c _workspace to the Newton step for its value
+  /// and Jacobian.
+  void computeNewtonStep(Workspace& _workspace) const;
+
   DifferentiablePtr mDifferentiable;
   std::vector<double> mTolerance;
   int mMaxIteration;
   double mMinStepSize;
   statespace::ConstStateSpacePtr mStateSpace;
+  std::vector<ConstraintType> mConstraintTypes;
+
+  LinearSolver mLinearSolver;
+  double mDamping;
+  bool mWarmStart;
+
+  /// Step size the last projection ended with, used if mWarmStart is true.
+  /// Projections on several threads share it.
+  mutable std::atomic<double> mStepSize;
+
+  /// Workspaces that no call to \c project is using. There are at most as
+  /// many as the number of concurrent calls so far.
+  mutable std::vector<std::unique_ptr<Workspace>> mWorkspaces;
 
-  bool contains(const statespace::StateSpace::State* _s) const;
+  /// Protects mWorkspaces.
+  mutable std::mutex mWorkspacesMutex;
 };
 
 } // namespace constraint
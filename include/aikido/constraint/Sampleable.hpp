@@ -3,6 +3,7 @@
 
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -55,6 +56,25 @@ public:
   /// Returns one sample from this constraint; returns true if succeeded.
   virtual bool sample(statespace::StateSpace::State* _state) = 0;
 
+  /// Draws up to \c _numSamples samples into the first states of \c _states,
+  /// in the same order as calling sample() repeatedly would. Sampling stops at
+  /// the first sample that fails.
+  ///
+  /// The default implementation calls sample() for each state. Generators that
+  /// are queried for many samples at once, e.g. for goal biasing or IK
+  /// seeding, override this to amortize the work shared by all samples.
+  ///
+  /// \param[in] _numSamples Number of samples to draw.
+  /// \param[out] _states States allocated in the StateSpace of this
+  /// generator, at least \c _numSamples of them.
+  /// \return Number of samples drawn, i.e. the index of the first state that
+  /// was not set.
+  /// \throws invalid_argument if \c _states has fewer than \c _numSamples
+  /// states.
+  virtual std::size_t sampleBatch(
+      std::size_t _numSamples,
+      const std::vector<statespace::StateSpace::State*>& _states);
+
   /// Gets an upper bound on the number of samples remaining or NO_LIMIT.
   virtual int getNumSamples() const = 0;
 
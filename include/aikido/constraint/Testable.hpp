@@ -2,6 +2,7 @@
 #define AIKIDO_CONSTRAINT_TESTABLE_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "aikido/common/pointers.hpp"
 #include "aikido/constraint/DefaultTestableOutcome.hpp"
@@ -30,6 +31,21 @@ public:
       const statespace::StateSpace::State* _state,
       TestableOutcome* outcome = nullptr) const = 0;
 
+  /// Tests a batch of states against this constraint.
+  ///
+  /// The default implementation calls isSatisfied() on each state in turn.
+  /// Derived classes may override this to test the states concurrently.
+  /// \param[in] states States to test.
+  /// \param[out] firstFailure If not nullptr, set to the index of the first
+  /// state that does not satisfy this constraint, or \c states.size() if all
+  /// of them do. Testing may then stop at the first failure, so only the
+  /// entries up to and including \c *firstFailure are guaranteed to be valid.
+  /// \return Vector whose i-th entry is true if \c states[i] satisfies this
+  /// constraint.
+  virtual std::vector<bool> isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::size_t* firstFailure = nullptr) const;
+
   /// Returns StateSpace in which this constraint operates.
   virtual statespace::ConstStateSpacePtr getStateSpace() const = 0;
 
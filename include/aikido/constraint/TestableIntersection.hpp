@@ -30,6 +30,14 @@ public:
       const aikido::statespace::StateSpace::State* state,
       TestableOutcome* outcome = nullptr) const override;
 
+  /// \copydoc Testable::isSatisfiedBatch()
+  /// \note Each constraint is tested in batch on the states that satisfied all
+  /// previous constraints, so batched implementations (e.g. CollisionFree)
+  /// are used when available.
+  std::vector<bool> isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::size_t* firstFailure = nullptr) const override;
+
   /// Return an instance of DefaultTestableOutcome, since this class doesn't
   /// have a more specialized TestableOutcome derivative assigned to it.
   std::unique_ptr<TestableOutcome> createOutcome() const override;
@@ -2,6 +2,7 @@
 #define AIKIDO_CONSTRAINT_DART_COLLISIONFREE_HPP_
 
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include <dart/collision/CollisionGroup.hpp>
 #include <dart/collision/CollisionOption.hpp>
 
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/common/pointers.hpp"
 #include "aikido/constraint/Testable.hpp"
 #include "aikido/constraint/dart/CollisionFreeOutcome.hpp"
@@ -57,6 +59,30 @@ public:
       const aikido::statespace::StateSpace::State* _state,
       TestableOutcome* outcome = nullptr) const override;
 
+  /// \copydoc Testable::isSatisfiedBatch()
+  /// \note If \c setNumBatchWorkers was called with more than one worker,
+  /// the states are distributed over a pool of worker threads. Each
+  /// worker tests its share of the states on its own clone of the Skeletons
+  /// and CollisionGroups used by this constraint, so the MetaSkeleton passed
+  /// to the constructor is not modified. The clones are created on the first
+  /// call and after the registered collision checks change; the positions of
+  /// the original Skeletons are copied to the clones at the start of every
+  /// call. If the CollisionGroups contain ShapeFrames that are not ShapeNodes,
+  /// the states are tested serially on the original MetaSkeleton.
+  std::vector<bool> isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::size_t* firstFailure = nullptr) const override;
+
+  /// Sets the number of worker threads used by \c isSatisfiedBatch. If this
+  /// is one, which is the default, batches are tested serially on the
+  /// original MetaSkeleton.
+  /// \param numWorkers Number of worker threads. If zero, the number of
+  /// hardware threads is used.
+  void setNumBatchWorkers(std::size_t numWorkers);
+
+  /// Returns the number of worker threads used by \c isSatisfiedBatch.
+  std::size_t getNumBatchWorkers() const;
+
   /// \copydoc Testable::createOutcome()
   /// \note Returns an instance of CollisionFreeOutcome.
   std::unique_ptr<TestableOutcome> createOutcome() const override;
@@ -87,6 +113,39 @@ public:
 private:
   using CollisionGroup = ::dart::collision::CollisionGroup;
 
+  /// Clones of the Skeletons and CollisionGroups used by one worker thread of
+  /// isSatisfiedBatch().
+  struct BatchWorker
+  {
+    /// Clones of mBatchSourceSkeletons, in the same order.
+    std::vector<::dart::dynamics::SkeletonPtr> mSkeletons;
+
+    /// Clone of mMetaSkeleton with the same DOF ordering.
+    ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+    std::shared_ptr<::dart::collision::CollisionDetector> mCollisionDetector;
+    ::dart::collision::CollisionOption mCollisionOptions;
+    std::vector<std::pair<
+        std::shared_ptr<CollisionGroup>,
+        std::shared_ptr<CollisionGroup>>>
+        mGroupsToPairwiseCheck;
+    std::vector<std::shared_ptr<CollisionGroup>> mGroupsToSelfCheck;
+  };
+
+  /// Creates mBatchWorkers if they do not exist. The caller must lock
+  /// mBatchMutex.
+  /// \return False if the collision checks cannot be cloned.
+  bool createBatchWorkers() const;
+
+  /// Discards the clones used by isSatisfiedBatch(), e.g. because the
+  /// registered collision checks changed.
+  void resetBatchWorkers();
+
+  /// Returns true if \c state is collision free on the clones of \c worker.
+  bool isCollisionFree(
+      const aikido::statespace::StateSpace::State* state,
+      BatchWorker& worker) const;
+
   aikido::statespace::dart::ConstMetaSkeletonStateSpacePtr
       mMetaSkeletonStateSpace;
   ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
@@ -97,6 +156,25 @@ private:
       std::shared_ptr<CollisionGroup>>>
       mGroupsToPairwiseCheck;
   std::vector<std::shared_ptr<CollisionGroup>> mGroupsToSelfCheck;
+
+  /// Number of worker threads used by isSatisfiedBatch().
+  std::size_t mNumBatchWorkers;
+
+  /// Protects the members used by isSatisfiedBatch().
+  mutable std::mutex mBatchMutex;
+
+  /// Skeletons referenced by mMetaSkeleton and the registered CollisionGroups.
+  mutable std::vector<::dart::dynamics::ConstSkeletonPtr> mBatchSourceSkeletons;
+
+  /// Per-thread clones, created lazily by isSatisfiedBatch().
+  mutable std::vector<std::unique_ptr<BatchWorker>> mBatchWorkers;
+
+  /// Whether the registered collision checks can be cloned for
+  /// isSatisfiedBatch().
+  mutable bool mBatchCloneable;
+
+  /// Threads that run the workers in mBatchWorkers.
+  mutable std::unique_ptr<common::ThreadPool> mThreadPool;
 };
 
 } // namespace dart
@@ -44,9 +44,31 @@ public:
   // Documentation inherited.
   statespace::ConstStateSpacePtr getStateSpace() const override;
 
-  // Documentation inherited.
+  /// \copydoc Sampleable::createSampleGenerator()
+  /// \note If the number of workers is greater than one, the generator spreads
+  /// the trials of each sample over that many worker threads. Each worker
+  /// solves IK on its own clone of the Skeleton of the InverseKinematics
+  /// solver, so the MetaSkeleton passed to the constructor is not modified.
+  /// Unlike with one worker, it is therefore not left at the sampled solution.
+  /// The clones are created with the generator, and the positions of the
+  /// original Skeleton are copied to them at the start of every sample. Seeds
+  /// and poses are drawn on the calling thread and, of the trials that
+  /// succeed, the first one drawn is returned. Trials drawn after it are kept
+  /// for the next sample, so seeds and poses are used in the same order as
+  /// with one worker and are not discarded. If the MetaSkeleton
+  /// has DegreesOfFreedom outside of the Skeleton of the solver, the trials
+  /// run serially on the original MetaSkeleton.
   std::unique_ptr<SampleGenerator> createSampleGenerator() const override;
 
+  /// Sets the number of worker threads of the generators created afterwards.
+  /// If this is one, IK is solved serially on the original MetaSkeleton.
+  /// \param numWorkers Number of worker threads. If zero, the number of
+  /// hardware threads is used.
+  void setNumWorkers(std::size_t numWorkers);
+
+  /// Returns the number of worker threads of the generators.
+  std::size_t getNumWorkers() const;
+
 private:
   statespace::dart::ConstMetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
   ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
@@ -54,6 +76,9 @@ private:
   SampleablePtr mSeedConstraint;
   ::dart::dynamics::InverseKinematicsPtr mInverseKinematics;
   int mMaxNumTrials;
+
+  /// Number of worker threads of the generators.
+  std::size_t mNumWorkers;
 };
 
 } // namespace dart
@@ -0,0 +1,125 @@
+#ifndef AIKIDO_CONSTRAINT_DART_SELFCOLLISIONMATRIX_HPP_
+#define AIKIDO_CONSTRAINT_DART_SELFCOLLISIONMATRIX_HPP_
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/collision/CollisionFilter.hpp>
+#include <dart/dynamics/MetaSkeleton.hpp>
+
+#include "aikido/common/RNG.hpp"
+#include "aikido/common/pointers.hpp"
+
+namespace aikido {
+namespace constraint {
+namespace dart {
+
+AIKIDO_DECLARE_POINTERS(SelfCollisionMatrix)
+
+/// Pairs of BodyNodes of a robot whose self collisions need not be checked,
+/// similar to the "disable collisions" entries of an SRDF.
+///
+/// BodyNodes are identified by name, so a matrix computed once, e.g. offline
+/// by \c compute, can be applied to any copy of the robot. Applying it to the
+/// BodyNodeCollisionFilter of a CollisionFree constraint skips the narrow
+/// phase of the disabled pairs.
+class SelfCollisionMatrix
+{
+public:
+  /// Why a pair of BodyNodes is disabled.
+  enum class Reason
+  {
+    /// The BodyNodes are connected by a Joint.
+    ADJACENT,
+
+    /// The BodyNodes collided in every sampled configuration.
+    ALWAYS,
+
+    /// The BodyNodes collided in no sampled configuration.
+    NEVER,
+
+    /// The pair was disabled by the user.
+    USER
+  };
+
+  /// Disabled pairs, with the smaller name first.
+  using DisabledPairs = std::map<std::pair<std::string, std::string>, Reason>;
+
+  /// Constructs a matrix without disabled pairs.
+  SelfCollisionMatrix() = default;
+
+  /// Computes a matrix by sampling configurations of \c metaSkeleton uniformly
+  /// within its position limits (or [-pi, pi] for unbounded DOFs) and
+  /// recording which pairs of its BodyNodes collide. The positions of
+  /// \c metaSkeleton are restored afterwards.
+  ///
+  /// Pairs that never collide are only disabled safely if \c numSamples is
+  /// large enough to cover the configuration space, e.g. several thousand for
+  /// a 7-DOF arm.
+  ///
+  /// \param metaSkeleton MetaSkeleton whose BodyNodes and DOFs are sampled
+  /// \param collisionDetector collision detector used to test for collision
+  /// \param rng random number generator
+  /// \param numSamples number of sampled configurations
+  /// \return Matrix of the adjacent pairs and of the pairs that collided in
+  /// all or none of the samples.
+  /// \throws invalid_argument if an argument is nullptr or \c numSamples is
+  /// zero.
+  static SelfCollisionMatrix compute(
+      const ::dart::dynamics::MetaSkeletonPtr& metaSkeleton,
+      const ::dart::collision::CollisionDetectorPtr& collisionDetector,
+      common::RNG* rng,
+      std::size_t numSamples = 10000u);
+
+  /// Disables a pair of BodyNodes.
+  ///
+  /// \param bodyNode1 name of the first BodyNode
+  /// \param bodyNode2 name of the second BodyNode
+  /// \param reason why the pair is disabled
+  void disable(
+      const std::string& bodyNode1,
+      const std::string& bodyNode2,
+      Reason reason = Reason::USER);
+
+  /// Enables a pair of BodyNodes again.
+  ///
+  /// \param bodyNode1 name of the first BodyNode
+  /// \param bodyNode2 name of the second BodyNode
+  void enable(const std::string& bodyNode1, const std::string& bodyNode2);
+
+  /// Returns true if a pair of BodyNodes is disabled.
+  ///
+  /// \param bodyNode1 name of the first BodyNode
+  /// \param bodyNode2 name of the second BodyNode
+  bool isDisabled(
+      const std::string& bodyNode1, const std::string& bodyNode2) const;
+
+  /// Returns the disabled pairs.
+  const DisabledPairs& getDisabledPairs() const;
+
+  /// Adds the disabled pairs of BodyNodes of \c metaSkeleton to the black list
+  /// of \c filter. Pairs whose BodyNodes are not in \c metaSkeleton are
+  /// skipped.
+  ///
+  /// \param metaSkeleton MetaSkeleton whose BodyNodes are matched by name
+  /// \param filter filter to add the pairs to
+  /// \return Number of pairs added to \c filter.
+  std::size_t apply(
+      const ::dart::dynamics::MetaSkeleton& metaSkeleton,
+      ::dart::collision::BodyNodeCollisionFilter& filter) const;
+
+private:
+  /// Returns the key of a pair of BodyNodes in mDisabledPairs.
+  static std::pair<std::string, std::string> makeKey(
+      const std::string& bodyNode1, const std::string& bodyNode2);
+
+  DisabledPairs mDisabledPairs;
+};
+
+} // namespace dart
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_DART_SELFCOLLISIONMATRIX_HPP_
@@ -112,12 +112,26 @@ public:
   /// se(3) tangent vector follows dart convention:
   ///   top 3 rows is the angle-axis representation of _s's rotation.
   ///   bottom 3 rows represent the translation.
+  /// That is, the rotation of _s is perturbed to exp(w) * R and its
+  /// translation to p + v for a tangent vector [w; v], which matches the world
+  /// Jacobian of a BodyNode. The Jacobian is computed in closed form; it is
+  /// undefined where the pitch of the TSR frame is +/- pi/2.
   /// \param _s State to be evaluated at.
   /// \param[out] _out Jacobian, 6 x 6 matrix.
   void getJacobian(
       const statespace::StateSpace::State* _s,
       Eigen::MatrixXd& _out) const override;
 
+  /// Computes the value and the Jacobian (see getJacobian) together, sharing
+  /// the transform of _s into the TSR frame.
+  /// \param _s State to be evaluated at.
+  /// \param[out] _val Value of the constraint, 6 x 1 vector.
+  /// \param[out] _jac Jacobian, 6 x 6 matrix.
+  void getValueAndJacobian(
+      const statespace::StateSpace::State* _s,
+      Eigen::VectorXd& _val,
+      Eigen::MatrixXd& _jac) const override;
+
   // Documentation inherited.
   std::vector<ConstraintType> getConstraintTypes() const override;
 
@@ -146,6 +160,16 @@ public:
   Eigen::Isometry3d mTw_e;
 
 private:
+  /// Computes the distance of _s to the bounds of this TSR along each of the
+  /// six coordinates of the TSR frame, and optionally its Jacobian.
+  /// \param _s State to be evaluated at.
+  /// \param[out] _distances Distances, as returned by getValue.
+  /// \param[out] _jacobian Jacobian, as returned by getJacobian, or nullptr.
+  void computeDistances(
+      const statespace::StateSpace::State* _s,
+      Eigen::Vector6d& _distances,
+      Eigen::Matrix6d* _jacobian) const;
+
   /// Tolerance used in isSatisfied as a testable
   double mTestableTolerance;
   std::unique_ptr<common::RNG> mRng;
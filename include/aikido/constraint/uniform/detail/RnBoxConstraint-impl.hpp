@@ -32,6 +32,10 @@ public:
 
   bool sample(statespace::StateSpace::State* _state) override;
 
+  std::size_t sampleBatch(
+      std::size_t _numSamples,
+      const std::vector<statespace::StateSpace::State*>& _states) override;
+
   int getNumSamples() const override;
 
   bool canSample() const override;
@@ -90,6 +94,31 @@ bool RnBoxConstraintSampleGenerator<N>::sample(
   return true;
 }
 
+//==============================================================================
+template <int N>
+std::size_t RnBoxConstraintSampleGenerator<N>::sampleBatch(
+    std::size_t _numSamples,
+    const std::vector<statespace::StateSpace::State*>& _states)
+{
+  if (_states.size() < _numSamples)
+    throw std::invalid_argument("Not enough states for the requested samples.");
+
+  // Reuse one vector for all samples, which avoids an allocation per sample
+  // when N is Eigen::Dynamic.
+  VectorNd value(mDistributions.size());
+
+  for (std::size_t i = 0; i < _numSamples; ++i)
+  {
+    for (auto j = 0; j < value.size(); ++j)
+      value[j] = mDistributions[j](*mRng);
+
+    mSpace->setValue(
+        static_cast<typename statespace::R<N>::State*>(_states[i]), value);
+  }
+
+  return _numSamples;
+}
+
 //==============================================================================
 template <int N>
 int RnBoxConstraintSampleGenerator<N>::getNumSamples() const
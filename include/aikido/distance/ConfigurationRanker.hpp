@@ -38,6 +38,13 @@ public:
       std::vector<statespace::dart::MetaSkeletonStateSpace::ScopedState>&
           configurations) const;
 
+  /// Returns the cost of a configuration, by which rankConfigurations sorts
+  /// configurations, e.g. to rank configurations as they are sampled.
+  /// \param[in] configuration Configuration to evaluate.
+  double getCost(
+      const statespace::dart::MetaSkeletonStateSpace::State* configuration)
+      const;
+
 protected:
   /// Returns the cost of the configuration.
   /// \param[in] solution Configuration to evaluate.
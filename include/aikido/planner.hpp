@@ -1,3 +1,5 @@
+#include "aikido/planner/CachedTestable.hpp"
+#include "aikido/planner/PlanningContextPool.hpp"
 #include "aikido/planner/PlanningResult.hpp"
 #include "aikido/planner/SnapPlanner.hpp"
 #include "aikido/planner/TrajectoryPostProcessor.hpp"
@@ -0,0 +1,175 @@
+#ifndef AIKIDO_PLANNER_CACHEDTESTABLE_HPP_
+#define AIKIDO_PLANNER_CACHEDTESTABLE_HPP_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <dart/dynamics/MetaSkeleton.hpp>
+
+#include "aikido/common/pointers.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/World.hpp"
+
+namespace aikido {
+namespace planner {
+
+AIKIDO_DECLARE_POINTERS(CachedTestable)
+
+/// A Testable that memoizes the results of another Testable, typically a
+/// CollisionFree constraint.
+///
+/// States are snapped to a grid with spacing \c resolution in the tangent
+/// space of the state space (see StateSpace::logMap), and the result of the
+/// first state tested in a grid cell is reused for every later state in the
+/// same cell. The resolution should therefore be finer than the resolution at
+/// which motions are checked. At most \c capacity results are kept; the least
+/// recently used result is evicted first.
+///
+/// If a World is given, all cached results are discarded whenever the
+/// positions of its Skeletons change, except for the DOFs of the planned
+/// MetaSkeleton, which the wrapped Testable sets itself. Call \c clear to
+/// discard the results after any other change, e.g. to the collision groups.
+class CachedTestable : public constraint::Testable
+{
+public:
+  /// Constructor.
+  ///
+  /// \param[in] testable Testable whose results are cached.
+  /// \param[in] resolution Grid spacing used to quantize states.
+  /// \param[in] capacity Maximum number of cached results.
+  /// \param[in] world World whose state invalidates the cached results, or
+  /// nullptr to only invalidate them through \c clear.
+  /// \param[in] metaSkeleton MetaSkeleton whose DOFs are set by \c testable
+  /// and are therefore ignored when watching \c world.
+  /// \throws invalid_argument if \c testable is nullptr, \c resolution is not
+  /// positive or \c capacity is zero.
+  CachedTestable(
+      constraint::ConstTestablePtr testable,
+      double resolution,
+      std::size_t capacity = 100000u,
+      ConstWorldPtr world = nullptr,
+      ::dart::dynamics::ConstMetaSkeletonPtr metaSkeleton = nullptr);
+
+  /// \copydoc Testable::isSatisfied()
+  /// \note If \c outcome is not nullptr, the wrapped Testable is always called
+  /// so that \c outcome can be populated.
+  bool isSatisfied(
+      const statespace::StateSpace::State* state,
+      constraint::TestableOutcome* outcome = nullptr) const override;
+
+  /// \copydoc Testable::isSatisfiedBatch()
+  /// \note States without a cached result are tested in one batch by the
+  /// wrapped Testable.
+  std::vector<bool> isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::size_t* firstFailure = nullptr) const override;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  /// Returns the outcome of the wrapped Testable.
+  std::unique_ptr<constraint::TestableOutcome> createOutcome() const override;
+
+  /// Returns the wrapped Testable.
+  constraint::ConstTestablePtr getTestable() const;
+
+  /// Returns the number of queries answered from the cache.
+  std::size_t getNumHits() const;
+
+  /// Returns the number of queries forwarded to the wrapped Testable.
+  std::size_t getNumMisses() const;
+
+  /// Returns the number of cached results.
+  std::size_t getSize() const;
+
+  /// Discards all cached results. The hit and miss counters are kept.
+  void clear();
+
+  /// Resets the hit and miss counters to zero.
+  void resetCounters();
+
+private:
+  using Key = std::vector<std::int64_t>;
+  using Entries = std::list<std::pair<Key, bool>>;
+
+  /// Snaps \c state to the grid.
+  Key computeKey(const statespace::StateSpace::State* state) const;
+
+  /// Discards the cached results if the World changed since the last call.
+  /// Skeletons are only read through World::getConstSkeleton and
+  /// World::getSkeletonVersion, so that Skeletons shared by a COPY_ON_WRITE
+  /// World are not cloned. The caller must lock mMutex.
+  void checkWorld() const;
+
+  /// Chooses how each Skeleton of mWorld is watched and records its state.
+  /// The caller must lock mMutex.
+  void watchWorld() const;
+
+  /// Looks up \c key and marks it as most recently used. The caller must lock
+  /// mMutex.
+  /// \return True if \c key was found.
+  bool find(const Key& key, bool& satisfied) const;
+
+  /// Caches \c satisfied for \c key, evicting the least recently used result
+  /// if the cache is full. The caller must lock mMutex.
+  void insert(Key key, bool satisfied) const;
+
+  constraint::ConstTestablePtr mTestable;
+  statespace::ConstStateSpacePtr mStateSpace;
+  double mResolution;
+  std::size_t mCapacity;
+  ConstWorldPtr mWorld;
+  ::dart::dynamics::ConstMetaSkeletonPtr mMetaSkeleton;
+
+  /// Protects the mutable members below.
+  mutable std::mutex mMutex;
+
+  /// Cached results, most recently used first.
+  mutable Entries mEntries;
+
+  /// Index of mEntries by key.
+  mutable std::unordered_map<Key, Entries::iterator, boost::hash<Key>> mIndex;
+
+  /// Skeleton of mWorld with DOFs in mMetaSkeleton, whose other DOFs are
+  /// watched one by one.
+  struct WatchedSkeleton
+  {
+    /// Index of the Skeleton in mWorld.
+    std::size_t mIndex;
+
+    /// Name of the Skeleton, which does not change when a Skeleton shared by
+    /// a COPY_ON_WRITE World is cloned.
+    std::string mName;
+
+    /// Indices of the DOFs that are not in mMetaSkeleton.
+    std::vector<std::size_t> mDofs;
+
+    /// Last recorded positions of mDofs.
+    std::vector<double> mPositions;
+  };
+
+  /// Number of Skeletons of mWorld when the watched Skeletons were chosen.
+  mutable std::size_t mNumWorldSkeletons;
+
+  /// Indices of the Skeletons of mWorld that have no DOF in mMetaSkeleton.
+  mutable std::vector<std::size_t> mVersionedSkeletons;
+
+  /// Last recorded World::getSkeletonVersion of mVersionedSkeletons.
+  mutable std::vector<std::size_t> mSkeletonVersions;
+
+  /// Skeletons of mWorld that have DOFs in mMetaSkeleton.
+  mutable std::vector<WatchedSkeleton> mWatchedSkeletons;
+
+  mutable std::size_t mNumHits;
+  mutable std::size_t mNumMisses;
+};
+
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_CACHEDTESTABLE_HPP_
@@ -46,6 +46,21 @@ public:
       const Problem& problem, Result* result = nullptr)
       = 0;
 
+  /// Requests a call to \c plan that is running on another thread to return
+  /// early, e.g. because a concurrent attempt on another goal succeeded. The
+  /// interrupted call returns \c nullptr.
+  ///
+  /// The default implementation does nothing.
+  /// \return True if this planner supports stopping.
+  virtual bool stopPlanning();
+
+  /// Discards a request made by \c stopPlanning that did not stop a call to
+  /// \c plan, e.g. because that call had already returned, so that it does
+  /// not stop the next call to \c plan.
+  ///
+  /// The default implementation does nothing.
+  virtual void clearStopRequest();
+
 protected:
   /// State space associated with this planner.
   statespace::ConstStateSpacePtr mStateSpace;
@@ -0,0 +1,206 @@
+#ifndef AIKIDO_PLANNER_PLANNINGCONTEXTPOOL_HPP_
+#define AIKIDO_PLANNER_PLANNINGCONTEXTPOOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/dynamics/MetaSkeleton.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+
+#include "aikido/common/pointers.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/World.hpp"
+#include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
+
+namespace aikido {
+namespace planner {
+
+AIKIDO_DECLARE_POINTERS(PlanningContextPool)
+
+/// A fixed set of planning contexts, each of which is an independent clone of
+/// a World that one thread can plan in without locking the original World or
+/// its Skeletons.
+///
+/// A context is checked out with \c acquire, which blocks until a context is
+/// free, and is returned to the pool when the Handle is destructed. On
+/// checkout, the Skeleton configurations of the context are synchronized with
+/// the original World.
+///
+/// All contexts share the MetaSkeletonStateSpace passed to the constructor.
+/// Since state spaces are immutable, states can be passed freely between the
+/// caller and any context.
+///
+/// \code
+/// PlanningContextPool pool(world, stateSpace, robot, 4, createConstraint);
+///
+/// // On each planning thread:
+/// auto context = pool.acquire();
+/// auto trajectory = planToEndEffectorOffset(
+///     context->mStateSpace, *startState, context->mMetaSkeleton, ...,
+///     context->mConstraint, ...);
+/// \endcode
+class PlanningContextPool
+{
+public:
+  /// Resources owned by one planning context.
+  struct Context
+  {
+    /// Clone of the original World.
+    WorldPtr mWorld;
+
+    /// Clone of the planned Skeleton in \c mWorld.
+    ::dart::dynamics::SkeletonPtr mSkeleton;
+
+    /// MetaSkeleton of the DOFs of \c mStateSpace in \c mSkeleton.
+    ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+    /// State space shared by all contexts.
+    statespace::dart::ConstMetaSkeletonStateSpacePtr mStateSpace;
+
+    /// Collision detector used only by this context.
+    ::dart::collision::CollisionDetectorPtr mCollisionDetector;
+
+    /// Constraint created by the ConstraintFactory, or nullptr if the pool was
+    /// constructed without one.
+    constraint::TestablePtr mConstraint;
+
+    /// Versions of the original World and of \c mWorld when \c mWorld was
+    /// last synchronized, so that only the Skeletons that changed since are
+    /// copied. See World::getVersion.
+    std::size_t mSourceVersion = 0u;
+    std::size_t mWorldVersion = 0u;
+  };
+
+  /// Creates the constraint of a context, e.g. a CollisionFree constraint on
+  /// the Skeletons of \c Context::mWorld. The Context itself is only valid
+  /// during the call, but the resources it points to are not.
+  using ConstraintFactory
+      = std::function<constraint::TestablePtr(const Context& context)>;
+
+  /// Exclusive access to a Context. The Context is returned to the pool when
+  /// the Handle is destructed.
+  class Handle
+  {
+  public:
+    /// Constructs an empty Handle.
+    Handle();
+
+    ~Handle();
+
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    Handle(Handle&& other);
+    Handle& operator=(Handle&& other);
+
+    /// Returns the Context, or nullptr if this Handle is empty.
+    Context* get() const;
+
+    /// Returns the Context.
+    Context* operator->() const;
+
+    /// Returns the Context.
+    Context& operator*() const;
+
+    /// Returns true if this Handle holds a Context.
+    explicit operator bool() const;
+
+    /// Returns the Context to the pool early. Does nothing if this Handle is
+    /// empty.
+    void release();
+
+  private:
+    friend class PlanningContextPool;
+
+    Handle(PlanningContextPool* pool, Context* context);
+
+    PlanningContextPool* mPool;
+    Context* mContext;
+  };
+
+  /// Constructs \c numContexts clones of \c world.
+  ///
+  /// \param[in] world World to clone.
+  /// \param[in] stateSpace State space of the DOFs to plan for. All DOFs must
+  /// belong to \c skeleton and must be single-DOF joints.
+  /// \param[in] skeleton Skeleton in \c world to plan for.
+  /// \param[in] numContexts Number of contexts. If zero, the number of
+  /// hardware threads is used.
+  /// \param[in] constraintFactory Optional function that creates the
+  /// constraint of each context.
+  /// \param[in] collisionDetector Collision detector to clone for each
+  /// context. If nullptr, an FCLCollisionDetector is used.
+  /// \throws invalid_argument if \c skeleton is not in \c world.
+  PlanningContextPool(
+      WorldPtr world,
+      statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+      const ::dart::dynamics::ConstSkeletonPtr& skeleton,
+      std::size_t numContexts = 0u,
+      ConstraintFactory constraintFactory = nullptr,
+      ::dart::collision::CollisionDetectorPtr collisionDetector = nullptr);
+
+  virtual ~PlanningContextPool() = default;
+
+  PlanningContextPool(const PlanningContextPool&) = delete;
+  PlanningContextPool& operator=(const PlanningContextPool&) = delete;
+
+  /// Returns the number of contexts.
+  std::size_t getNumContexts() const;
+
+  /// Returns the number of contexts that are not checked out.
+  std::size_t getNumAvailableContexts() const;
+
+  /// Checks out a context, blocking until one is available. The Skeleton
+  /// configurations of the context are set to those of the original World.
+  /// \return Handle to the checked out context.
+  Handle acquire();
+
+  /// Checks out a context if one is available.
+  /// \return Handle to the checked out context, or an empty Handle if all
+  /// contexts are in use.
+  Handle tryAcquire();
+
+private:
+  /// Clones the original World into \c context. If \c context already holds
+  /// a clone of the same Skeletons, only the positions of the Skeletons that
+  /// changed in either World since the last call are updated.
+  void synchronize(Context& context) const;
+
+  /// Puts \c context back into the list of available contexts.
+  void release(Context* context);
+
+  /// Original World.
+  WorldPtr mWorld;
+
+  /// State space shared by all contexts.
+  statespace::dart::ConstMetaSkeletonStateSpacePtr mStateSpace;
+
+  /// Name of the planned Skeleton in mWorld.
+  std::string mSkeletonName;
+
+  ConstraintFactory mConstraintFactory;
+
+  ::dart::collision::CollisionDetectorPtr mCollisionDetector;
+
+  /// All contexts.
+  std::vector<std::unique_ptr<Context>> mContexts;
+
+  /// Contexts that are not checked out.
+  std::vector<Context*> mAvailableContexts;
+
+  /// Protects mAvailableContexts.
+  mutable std::mutex mMutex;
+
+  /// Notifies waiting threads that a context was released.
+  std::condition_variable mCondition;
+};
+
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_PLANNINGCONTEXTPOOL_HPP_
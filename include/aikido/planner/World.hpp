@@ -1,8 +1,10 @@
 #ifndef AIKIDO_PLANNER_WORLD_HPP_
 #define AIKIDO_PLANNER_WORLD_HPP_
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <dart/dart.hpp>
 
@@ -36,6 +38,31 @@ public:
     bool operator!=(const State& other) const;
   };
 
+  /// Positions of the Skeletons of a World, from which the World is restored
+  /// by setting only the Skeletons that changed since. See createSnapshot.
+  struct Snapshot
+  {
+    /// Skeletons of the World when the snapshot was created.
+    std::vector<dart::dynamics::SkeletonPtr> mSkeletons;
+
+    /// Positions of each Skeleton in \c mSkeletons.
+    std::vector<Eigen::VectorXd> mPositions;
+
+    /// Version of each Skeleton in \c mSkeletons. See getSkeletonVersion.
+    std::vector<std::size_t> mVersions;
+  };
+
+  /// How clone copies the Skeletons of a World.
+  enum class CloneMode
+  {
+    /// Clones every Skeleton immediately.
+    DEEP,
+
+    /// Records only the positions of the Skeletons, which are cloned the first
+    /// time they are accessed.
+    COPY_ON_WRITE
+  };
+
   /// Construct a kinematic World.
   /// \param name Name for the new World
   explicit World(const std::string& name = "");
@@ -47,8 +74,26 @@ public:
   static std::unique_ptr<World> create(const std::string& name = "");
 
   /// Create a clone of this World. All Skeletons will be copied over.
+  ///
+  /// In COPY_ON_WRITE mode, the clone shares the Skeletons of this World and
+  /// only records their positions. Each Skeleton is cloned and set to the
+  /// recorded positions the first time it is accessed through getSkeleton or
+  /// setState, since it may then be modified. getConstSkeleton and getState
+  /// clone it only once the original has moved away from the recorded
+  /// positions. getVersion, getSkeletonVersion and createSnapshot do not clone
+  /// Skeletons. Changes to the structure of an original Skeleton before it is
+  /// cloned are reflected in the clone.
+  ///
+  /// Skeletons are read without locking their mutexes, so that this may be
+  /// called while holding them. Lock the mutexes of the Skeletons of this
+  /// World, and of the original Skeletons shared by the clone until they are
+  /// cloned, while modifying them.
+  ///
   /// \param newName Name for the cloned World
-  std::unique_ptr<World> clone(const std::string& newName = "") const;
+  /// \param mode Whether Skeletons are cloned now or when first accessed
+  std::unique_ptr<World> clone(
+      const std::string& newName = "",
+      CloneMode mode = CloneMode::DEEP) const;
 
   /// Set the name of this World
   /// \param newName New name for this World
@@ -65,6 +110,17 @@ public:
   /// \param name Name of desired Skeleton
   dart::dynamics::SkeletonPtr getSkeleton(const std::string& name) const;
 
+  /// Find a Skeleton by index for reading only. Unlike getSkeleton, a
+  /// Skeleton shared by a COPY_ON_WRITE clone is not cloned while the
+  /// original is at the recorded positions; the original is returned instead.
+  /// \param i Index of desired Skeleton
+  dart::dynamics::ConstSkeletonPtr getConstSkeleton(std::size_t i) const;
+
+  /// Find a Skeleton by name for reading only. See getConstSkeleton.
+  /// \param name Name of desired Skeleton
+  dart::dynamics::ConstSkeletonPtr getConstSkeleton(
+      const std::string& name) const;
+
   /// Returns true if the Skeleton is in this World.
   /// \param skel Desired Skeleton
   /// \return True if succeeded to find the Skeleton
@@ -73,6 +129,11 @@ public:
   /// Get the number of Skeletons
   std::size_t getNumSkeletons() const;
 
+  /// Returns true if Skeleton \c i is still shared with the World this World
+  /// was cloned from in COPY_ON_WRITE mode, i.e. it was not accessed yet.
+  /// \param i Index of the Skeleton
+  bool isSkeletonShared(std::size_t i) const;
+
   /// Add a Skeleton to this World
   /// \param skeleton Skeleton to add to the World
   std::string addSkeleton(const dart::dynamics::SkeletonPtr& skeleton);
@@ -107,21 +168,111 @@ public:
   void setState(
       const World::State& state, const std::vector<std::string>& names);
 
+  /// Returns a number that increases whenever the positions of a Skeleton of
+  /// this World change or Skeletons are added or removed. Changes are detected
+  /// by comparing the positions of every Skeleton with those recorded by the
+  /// previous call, so Skeletons may be modified directly.
+  std::size_t getVersion() const;
+
+  /// Returns a number that increases whenever the positions of Skeleton \c i
+  /// change. Only Skeleton \c i is compared, so this is cheaper than
+  /// getVersion when few Skeletons are watched. The versions of all Skeletons
+  /// are at most getVersion().
+  /// \param i Index of the Skeleton
+  /// \throws out_of_range if \c i is not the index of a Skeleton.
+  std::size_t getSkeletonVersion(std::size_t i) const;
+
+  /// Saves the positions of all Skeletons of this World, along with their
+  /// versions.
+  /// \return Snapshot
+  Snapshot createSnapshot() const;
+
+  /// Restores the positions of the Skeletons that changed since \c snapshot
+  /// was created, leaving the others untouched. Skeletons that were removed
+  /// from this World, or whose number of DOFs changed, are ignored.
+  /// The caller of this method MUST LOCK the mutex of this World.
+  /// \param snapshot Snapshot created by createSnapshot of this World.
+  /// \return Number of Skeletons whose positions were restored.
+  std::size_t restoreSnapshot(const Snapshot& snapshot);
+
 protected:
+  /// Positions of a Skeleton when its version was last updated.
+  struct SkeletonRecord
+  {
+    const dart::dynamics::Skeleton* mSkeleton;
+    Eigen::VectorXd mPositions;
+    std::size_t mVersion;
+  };
+
+  /// Skeleton of another World that is shared until it is first accessed.
+  struct SharedSkeleton
+  {
+    /// Skeleton to clone, or nullptr if the Skeleton is not shared.
+    dart::dynamics::SkeletonPtr mSource;
+
+    /// Positions to set the clone of mSource to.
+    Eigen::VectorXd mPositions;
+  };
+
+  /// Updates the record of Skeleton \c i, increasing its version if its
+  /// positions changed. The caller must lock mVersionMutex.
+  /// \return Version of Skeleton \c i.
+  std::size_t updateSkeletonVersion(std::size_t i) const;
+
+  /// Returns the index of \c skeleton, which may be the source of a shared
+  /// Skeleton, or the number of Skeletons if it is not in this World. The
+  /// caller must lock mVersionMutex.
+  std::size_t findSkeleton(const dart::dynamics::SkeletonPtr& skeleton) const;
+
+  /// Returns the names of all Skeletons without cloning them. The caller must
+  /// lock mVersionMutex.
+  std::vector<std::string> getSkeletonNames() const;
+
+  /// Implementation of getConstSkeleton. See unshareSkeleton.
+  dart::dynamics::ConstSkeletonPtr getConstSkeletonImpl(
+      std::size_t i, std::unique_lock<std::mutex>& versionLock) const;
+
+  /// Clones Skeleton \c i if it is still shared. \c versionLock must hold
+  /// mVersionMutex; it is released while the Skeleton is cloned.
+  /// \return Skeleton \c i, or nullptr if it was removed while it was cloned.
+  dart::dynamics::SkeletonPtr unshareSkeleton(
+      std::size_t i, std::unique_lock<std::mutex>& versionLock) const;
+
   /// Name of this World
   std::string mName;
 
-  /// Skeletons in this World
-  std::vector<dart::dynamics::SkeletonPtr> mSkeletons;
+  /// Skeletons in this World. Shared Skeletons are nullptr until they are
+  /// cloned.
+  mutable std::vector<dart::dynamics::SkeletonPtr> mSkeletons;
+
+  /// Shared Skeleton of each Skeleton in mSkeletons, in the same order. The
+  /// source is kept once the Skeleton is cloned, so that snapshots refer to
+  /// it.
+  mutable std::vector<SharedSkeleton> mSharedSkeletons;
+
+  /// Number of Skeletons in mSkeletons that are still shared.
+  mutable std::size_t mNumSharedSkeletons;
 
   /// Mutex to protect this World
   mutable std::mutex mMutex;
 
+  /// Protects mSkeletonRecords and mVersion, which are updated by const
+  /// methods, and the cloning of shared Skeletons.
+  mutable std::mutex mVersionMutex;
+
+  /// Record of each Skeleton in mSkeletons, in the same order.
+  mutable std::vector<SkeletonRecord> mSkeletonRecords;
+
+  /// Latest version issued to a Skeleton or to the list of Skeletons.
+  mutable std::size_t mVersion;
+
   /// NameManager for keeping track of Worlds
   static dart::common::NameManager<World*> mWorldNameManager;
 
-  /// NameManager for keeping track of Skeletons
-  dart::common::NameManager<dart::dynamics::SkeletonPtr> mSkeletonNameManager;
+  /// NameManager for keeping track of Skeletons. Shared Skeletons are
+  /// registered with their source until they are cloned.
+  mutable dart::common::NameManager<dart::dynamics::SkeletonPtr>
+      mSkeletonNameManager;
 };
 
 } // namespace planner
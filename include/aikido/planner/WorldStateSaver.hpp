@@ -7,6 +7,9 @@ namespace aikido {
 namespace planner {
 
 /// RAII class to save and restore a World's state.
+///
+/// Only the Skeletons whose positions changed while the WorldStateSaver was
+/// alive are restored (see World::restoreSnapshot).
 class WorldStateSaver
 {
 public:
@@ -33,7 +36,7 @@ private:
   int mOptions;
 
   /// Saved state
-  World::State mWorldState;
+  World::Snapshot mSnapshot;
 };
 
 } // namespace planner
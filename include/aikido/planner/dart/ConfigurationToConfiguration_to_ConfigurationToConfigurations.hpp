@@ -1,7 +1,13 @@
 #ifndef AIKIDO_PLANNER_DART_CONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONS_HPP_
 #define AIKIDO_PLANNER_DART_CONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONS_HPP_
 
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/planner/ConfigurationToConfigurationPlanner.hpp"
+#include "aikido/planner/PlanningContextPool.hpp"
 #include "aikido/planner/dart/ConfigurationToConfigurationsPlanner.hpp"
 #include "aikido/planner/dart/PlannerAdapter.hpp"
 
@@ -11,12 +17,21 @@ namespace dart {
 
 /// Converts a non-DART ConfigurationToConfiguration planner into a DART
 /// ConfigurationToConfigurations planner.
+///
+/// By default, the goal configurations are ranked and the delegate planner is
+/// called on each of them in turn until one succeeds. In portfolio mode (see
+/// \c setPortfolio), the best ranked goals are instead planned to concurrently
+/// in separate planning contexts, and the first trajectory found is returned.
 class ConfigurationToConfiguration_to_ConfigurationToConfigurations
   : public PlannerAdapter<
         planner::ConfigurationToConfigurationPlanner,
         planner::dart::ConfigurationToConfigurationsPlanner>
 {
 public:
+  /// Creates a delegate planner for portfolio mode.
+  using DelegateFactory = std::function<
+      std::shared_ptr<aikido::planner::ConfigurationToConfigurationPlanner>()>;
+
   /// Constructor
   ///
   /// \param[in] planner Non-DART ConfigurationToConfigurationPlanner planner to
@@ -35,6 +50,45 @@ public:
   virtual trajectory::TrajectoryPtr plan(
       const ConfigurationToConfigurations& problem,
       Planner::Result* result) override;
+
+  /// Enables portfolio mode, in which up to \c numConcurrentGoals of the best
+  /// ranked goals are planned to at once. Each attempt runs in a context of
+  /// \c contextPool, with the constraint of the context in place of the
+  /// constraint of the problem, and with its own delegate planner. When an
+  /// attempt succeeds, the other delegates are stopped (see
+  /// Planner::stopPlanning). \c plan throws invalid_argument if the constraint
+  /// of the problem is not in the state space of the constraints of the
+  /// contexts.
+  ///
+  /// \param[in] contextPool Pool of planning contexts whose constraint is
+  /// equivalent to the constraint of the planned problems. If nullptr,
+  /// portfolio mode is disabled.
+  /// \param[in] delegateFactory Function that creates the delegate planners.
+  /// They must plan in the MetaSkeletonStateSpace of this planner.
+  /// \param[in] numConcurrentGoals Maximum number of goals planned to at once.
+  /// If zero, the number of contexts of \c contextPool is used.
+  /// \throws invalid_argument if \c contextPool is not nullptr and
+  /// \c delegateFactory is empty or creates an invalid delegate planner.
+  void setPortfolio(
+      PlanningContextPoolPtr contextPool,
+      DelegateFactory delegateFactory,
+      std::size_t numConcurrentGoals = 0u);
+
+  /// Returns the pool of planning contexts of portfolio mode, or nullptr if
+  /// portfolio mode is disabled.
+  PlanningContextPoolPtr getPortfolioContextPool() const;
+
+private:
+  /// Pool of planning contexts for portfolio mode.
+  PlanningContextPoolPtr mPortfolioContextPool;
+
+  /// Delegate planners for portfolio mode, one per concurrent goal.
+  std::vector<
+      std::shared_ptr<aikido::planner::ConfigurationToConfigurationPlanner>>
+      mPortfolioDelegates;
+
+  /// Runs the delegate planners of portfolio mode.
+  std::unique_ptr<common::ThreadPool> mPortfolioThreadPool;
 };
 
 } // namespace dart
@@ -1,7 +1,14 @@
 #ifndef AIKIDO_PLANNER_DART_CONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONTOTSR_HPP_
 #define AIKIDO_PLANNER_DART_CONFIGURATIONTOCONFIGURATIONTOCONFIGURATIONTOTSR_HPP_
 
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "aikido/common/ThreadPool.hpp"
+#include "aikido/constraint/Sampleable.hpp"
 #include "aikido/planner/ConfigurationToConfigurationPlanner.hpp"
+#include "aikido/planner/PlanningContextPool.hpp"
 #include "aikido/planner/dart/ConfigurationToTSRPlanner.hpp"
 #include "aikido/planner/dart/PlannerAdapter.hpp"
 
@@ -11,12 +18,27 @@ namespace dart {
 
 /// Converts a non-DART ConfigurationToConfiguration planner into a DART
 /// ConfigurationToTSR planner.
+///
+/// By default, the goal configurations are ranked and the delegate planner is
+/// called on each of them in turn until one succeeds. In portfolio mode (see
+/// \c setPortfolio), the best ranked goals are instead planned to concurrently
+/// in separate planning contexts, and the first trajectory found is returned.
+///
+/// Goal configurations are IK solutions sampled from the goal TSR. By default,
+/// all of them are sampled and ranked before planning starts. In streaming
+/// mode (see \c setGoalQueueCapacity), they are sampled on a separate thread
+/// into a bounded queue ordered by the ConfigurationRanker, and planning
+/// starts as soon as the first one is sampled.
 class ConfigurationToConfiguration_to_ConfigurationToTSR
   : public PlannerAdapter<
         aikido::planner::ConfigurationToConfigurationPlanner,
         ConfigurationToTSRPlanner>
 {
 public:
+  /// Creates a delegate planner for portfolio mode.
+  using DelegateFactory = std::function<
+      std::shared_ptr<aikido::planner::ConfigurationToConfigurationPlanner>()>;
+
   /// Constructor
   ///
   /// \param[in] planner Non-DART ConfigurationToConfigurationPlanner planner to
@@ -34,6 +56,87 @@ public:
   // Documentation inherited.
   virtual trajectory::TrajectoryPtr plan(
       const ConfigurationToTSR& problem, Planner::Result* result) override;
+
+  /// Enables portfolio mode, in which up to \c numConcurrentGoals of the best
+  /// ranked goals are planned to at once. Each attempt runs in a context of
+  /// \c contextPool, with the constraint of the context in place of the
+  /// constraint of the problem, and with its own delegate planner. When an
+  /// attempt succeeds, the other delegates are stopped (see
+  /// Planner::stopPlanning). \c plan throws invalid_argument if the constraint
+  /// of the problem is not in the state space of the constraints of the
+  /// contexts.
+  ///
+  /// \param[in] contextPool Pool of planning contexts whose constraint is
+  /// equivalent to the constraint of the planned problems. If nullptr,
+  /// portfolio mode is disabled.
+  /// \param[in] delegateFactory Function that creates the delegate planners.
+  /// They must plan in the MetaSkeletonStateSpace of this planner.
+  /// \param[in] numConcurrentGoals Maximum number of goals planned to at once.
+  /// If zero, the number of contexts of \c contextPool is used.
+  /// \throws invalid_argument if \c contextPool is not nullptr and
+  /// \c delegateFactory is empty or creates an invalid delegate planner.
+  void setPortfolio(
+      PlanningContextPoolPtr contextPool,
+      DelegateFactory delegateFactory,
+      std::size_t numConcurrentGoals = 0u);
+
+  /// Returns the pool of planning contexts of portfolio mode, or nullptr if
+  /// portfolio mode is disabled.
+  PlanningContextPoolPtr getPortfolioContextPool() const;
+
+  /// Enables streaming mode, in which goal configurations are sampled on a
+  /// separate thread, on a clone of the Skeleton, while the best goal
+  /// configurations sampled so far are planned to. Sampling stops once a
+  /// trajectory is found.
+  ///
+  /// \param[in] capacity Maximum number of sampled goal configurations that
+  /// wait to be planned to. When the queue is full, the worst ranked one is
+  /// discarded. If zero, streaming mode is disabled.
+  void setGoalQueueCapacity(std::size_t capacity);
+
+  /// Returns the capacity of the goal queue of streaming mode, or zero if
+  /// streaming mode is disabled.
+  std::size_t getGoalQueueCapacity() const;
+
+  /// Sets the maximum number of IK solutions sampled from the goal TSR. The
+  /// default is 100.
+  /// \param[in] maxNumGoalSamples Maximum number of samples.
+  void setMaxNumGoalSamples(std::size_t maxNumGoalSamples);
+
+  /// Returns the maximum number of IK solutions sampled from the goal TSR.
+  std::size_t getMaxNumGoalSamples() const;
+
+private:
+  /// Creates a generator of IK solutions to the goal TSR of \c problem.
+  ///
+  /// \param[in] problem Planning problem.
+  /// \param[in] skeleton Skeleton of the end-effector, i.e. the Skeleton of
+  /// mMetaSkeleton or a clone of it.
+  /// \param[in] metaSkeleton MetaSkeleton of the DOFs of mMetaSkeleton in
+  /// \c skeleton.
+  /// \throws invalid_argument if the end-effector is not in \c skeleton.
+  std::unique_ptr<constraint::SampleGenerator> createGoalSampleGenerator(
+      const ConfigurationToTSR& problem,
+      const ::dart::dynamics::SkeletonPtr& skeleton,
+      ::dart::dynamics::MetaSkeletonPtr metaSkeleton);
+
+  /// Maximum number of IK solutions sampled from the goal TSR.
+  std::size_t mMaxNumGoalSamples;
+
+  /// Capacity of the goal queue of streaming mode, or zero if streaming mode
+  /// is disabled.
+  std::size_t mGoalQueueCapacity;
+
+  /// Pool of planning contexts for portfolio mode.
+  PlanningContextPoolPtr mPortfolioContextPool;
+
+  /// Delegate planners for portfolio mode, one per concurrent goal.
+  std::vector<
+      std::shared_ptr<aikido::planner::ConfigurationToConfigurationPlanner>>
+      mPortfolioDelegates;
+
+  /// Runs the delegate planners of portfolio mode.
+  std::unique_ptr<common::ThreadPool> mPortfolioThreadPool;
 };
 
 } // namespace dart
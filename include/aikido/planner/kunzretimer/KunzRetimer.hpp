@@ -27,20 +27,35 @@ constexpr double DEFAULT_TIME_STEP = 0.1;
 /// Additionally, this function requires that \c inputTrajectory to be
 /// interpolated using a \c GeodesicInterpolator.
 ///
+/// If \c splineTolerance is zero, the timed path is sampled every \c timeStep
+/// and the output has one cubic segment per time step. Otherwise the timed
+/// path is sampled at its integration steps and switching points, so that no
+/// segment straddles a change of acceleration, and each segment spans as many
+/// samples as possible while deviating from the samples in between by at most
+/// \c splineTolerance in each dimension and staying within the velocity and
+/// acceleration limits. This typically yields far fewer segments. Segments
+/// match the positions and velocities of the timed path at their ends in both
+/// cases.
+///
 /// \param[in] inputTrajectory Input piecewise Geodesic trajectory
 /// \param[in] maxVelocity Maximum velocity for each dimension
 /// \param[in] maxAcceleration Maximum acceleration for each dimension
 /// \param[in] maxDeviation Maximum deviation from a waypoint in doing circular
 /// blending around the waypoint
 /// \param[in] timeStep Time step in following the path
+/// \param[in] splineTolerance Maximum position error of the output segments,
+/// or zero for one segment per time step
 /// \return Time optimal trajectory that satisfies velocity and acceleration
 /// constraints
+/// \throws invalid_argument if a limit is not positive and finite, or if
+/// \c splineTolerance is negative.
 std::unique_ptr<aikido::trajectory::Spline> computeKunzTiming(
     const aikido::trajectory::Interpolated& inputTrajectory,
     const Eigen::VectorXd& maxVelocity,
     const Eigen::VectorXd& maxAcceleration,
     double maxDeviation = DEFAULT_MAX_DEVIATION,
-    double timeStep = DEFAULT_TIME_STEP);
+    double timeStep = DEFAULT_TIME_STEP,
+    double splineTolerance = 0.);
 
 /// Class for performing time-optimal trajectory retiming following subject to
 /// velocity and acceleration limits.
@@ -53,16 +68,22 @@ public:
     /// \param[in] _maxDeviation Maximum deviation in circular blending (in
     /// configuration space).
     /// \param[in] _timeStep Time step in following the path (in seconds).
+    /// \param[in] _splineTolerance Maximum position error of the output
+    /// segments, or zero for one segment per time step.
     Params(
         double _maxDeviation = DEFAULT_MAX_DEVIATION,
-        double _timeStep = DEFAULT_TIME_STEP)
-      : mMaxDeviation(_maxDeviation), mTimeStep(_timeStep)
+        double _timeStep = DEFAULT_TIME_STEP,
+        double _splineTolerance = 0.)
+      : mMaxDeviation(_maxDeviation)
+      , mTimeStep(_timeStep)
+      , mSplineTolerance(_splineTolerance)
     {
       // Do nothing.
     }
 
     double mMaxDeviation;
     double mTimeStep;
+    double mSplineTolerance;
   };
 
   /// \param[in] velocityLimits Maximum velocity for each dimension.
@@ -70,11 +91,14 @@ public:
   /// \param[in] maxDeviation Maximum deviation in circular blending (in
   /// configuration space).
   /// \param[in] timeStep Time step in following the path (in seconds).
+  /// \param[in] splineTolerance Maximum position error of the output
+  /// segments, or zero for one segment per time step.
   KunzRetimer(
       const Eigen::VectorXd& velocityLimits,
       const Eigen::VectorXd& accelerationLimits,
       double maxDeviation = DEFAULT_MAX_DEVIATION,
-      double timeStep = DEFAULT_TIME_STEP);
+      double timeStep = DEFAULT_TIME_STEP,
+      double splineTolerance = 0.);
 
   /// \param[in] velocityLimits Maximum velocity for each dimension.
   /// \param[in] accelerationLimits Maximum acceleration for each dimension.
@@ -122,6 +146,13 @@ public:
   /// Sets the max deviation of circular blending
   void setMaxDeviation(double maxDeviation);
 
+  /// Returns the maximum position error of the output segments
+  double getSplineTolerance() const;
+
+  /// Sets the maximum position error of the output segments, or zero for one
+  /// segment per time step
+  void setSplineTolerance(double splineTolerance);
+
 private:
   /// Set to the value of \c velocityLimits.
   Eigen::VectorXd mVelocityLimits;
@@ -134,6 +165,9 @@ private:
 
   /// Set to the value of \c timeStep
   double mTimeStep;
+
+  /// Set to the value of \c splineTolerance
+  double mSplineTolerance;
 };
 
 } // namespace kunzretimer
@@ -7,6 +7,7 @@
 
 #include "aikido/constraint/Projectable.hpp"
 #include "aikido/planner/ompl/BackwardCompatibility.hpp"
+#include "aikido/statespace/ArenaStateAllocator.hpp"
 
 namespace aikido {
 namespace planner {
@@ -121,6 +122,21 @@ public:
   /// made and quit extending.
   double getMinStateDifference() const;
 
+  /// Set whether tree extensions are validated lazily. If true, only the
+  /// endpoint of each extension is checked when it is added to the tree. The
+  /// remaining points of an extension are only checked once it is part of a
+  /// candidate solution path. Extensions that turn out to be invalid are
+  /// removed from the tree along with their descendants, and planning resumes.
+  /// This requires the MotionValidator of the SpaceInformation to be an
+  /// aikido::planner::ompl::MotionValidator to resume the validation of
+  /// partially validated extensions. Approximate solutions are not reported
+  /// in lazy mode.
+  /// \param _lazy True to validate extensions lazily
+  void setLazyValidation(bool _lazy);
+
+  /// Get whether tree extensions are validated lazily.
+  bool getLazyValidation() const;
+
   /// Set a nearest neighbors data structure
   template <template <typename T> class NN>
   void setNearestNeighbors();
@@ -137,14 +153,18 @@ protected:
   {
   public:
     /// Constructor. Sets state and parent to null ptr.
-    Motion() : state(nullptr), parent(nullptr)
+    Motion()
+      : state(nullptr), parent(nullptr), numCheckedPoints(0), validated(true)
     {
       // Do nothing
     }
 
     /// Constructor that allocates memory for the state
     explicit Motion(const ::ompl::base::SpaceInformationPtr& _si)
-      : state(_si->allocState()), parent(nullptr)
+      : state(_si->allocState())
+      , parent(nullptr)
+      , numCheckedPoints(0)
+      , validated(true)
     {
       // Do nothing
     }
@@ -160,11 +180,24 @@ protected:
 
     /// The parent of this node
     Motion* parent;
+
+    /// The number of points checked on the edge from the parent to this node.
+    /// Only used for lazy validation.
+    std::size_t numCheckedPoints;
+
+    /// True if the edge from the parent to this node has been validated
+    bool validated;
   };
 
-  /// Free the memory allocated by this planner
+  /// Free the memory allocated by this planner. All motions of the trees are
+  /// released at once.
   virtual void freeMemory();
 
+  /// Allocate a motion and its state in mMotionArena. The motion is valid
+  /// until the next call to freeMemory and must not be deleted.
+  /// \return The new motion, with no parent
+  Motion* allocMotion();
+
   /// Compute distance between motions (actually distance between contained
   /// states
   double distanceFunction(const Motion* a, const Motion* b) const;
@@ -200,6 +233,28 @@ protected:
       double& dist,
       bool& foundgoal);
 
+  /// Validate the unvalidated edges leading to the motions of a candidate
+  /// solution path. One point of each edge is checked in turn, so that an
+  /// invalid point anywhere on the path is found early. The number of points
+  /// checked is stored in each motion, so that partially validated edges do
+  /// not need to be checked again on later paths.
+  /// \param ptc Planner termination conditions. Used to stop validating if
+  /// planning time expires.
+  /// \param path The motions of the path, in any order
+  /// \param[out] invalidMotion The motion at the end of an invalid edge, or
+  /// nullptr if no invalid edge was found
+  /// \return True if all edges of the path are valid
+  bool validatePath(
+      const ::ompl::base::PlannerTerminationCondition& ptc,
+      const std::vector<Motion*>& path,
+      Motion*& invalidMotion);
+
+  /// Remove a motion and all of its descendants from a tree. Their memory is
+  /// reclaimed by freeMemory.
+  /// \param tree The tree containing the motion
+  /// \param motion The root of the subtree to remove
+  void removeSubtree(TreeData& tree, Motion* motion);
+
   /// State sampler
   ::ompl::base::StateSamplerPtr mSampler;
 
@@ -231,6 +286,12 @@ protected:
   /// The minumum step size along the constraint. Used to determine
   /// when projection is no longer making progress during an extension.
   double mMinStepsize;
+
+  /// True if tree extensions are validated lazily
+  bool mLazyValidation;
+
+  /// Memory of the motions in the trees and of their states
+  statespace::ArenaStateAllocator mMotionArena;
 };
 
 } // namespace ompl
@@ -67,9 +67,6 @@ public:
   void setup() override;
 
 protected:
-  /// Free the memory allocated by this planner
-  void freeMemory() override;
-
   /// The goal tree
   TreeData mGoalTree;
 
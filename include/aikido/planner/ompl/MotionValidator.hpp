@@ -43,6 +43,30 @@ public:
       const ::ompl::base::State* _s2,
       std::pair<::ompl::base::State*, double>& _lastValid) const override;
 
+  /// Continue checking the path between two states, _s1 and _s2, where a
+  /// previous call stopped. The points on the segment are checked in the same
+  /// order as checkMotion(_s1, _s2): _s1, _s2 and then the Van der Corput
+  /// sequence between them. This lets a planner validate a segment lazily and
+  /// remember how much of it has been validated.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \param[in,out] _numCheckedPoints The number of points on the segment that
+  /// were already checked. Incremented by the number of points checked.
+  /// \param _maxNumChecks The maximum number of points to check in this call
+  /// \return False if an invalid point was found
+  bool checkMotionIncrementally(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      std::size_t& _numCheckedPoints,
+      std::size_t _maxNumChecks) const;
+
+  /// Get the number of points checkMotion(_s1, _s2) checks on the path between
+  /// two states.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  std::size_t getNumCheckPoints(
+      const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const;
+
 private:
   double mSequenceResolution;
 };
@@ -1,6 +1,8 @@
 #ifndef AIKIDO_PLANNER_OMPL_OMPLCONFIGURATIONTOCONFIGURATIONPLANNER_HPP_
 #define AIKIDO_PLANNER_OMPL_OMPLCONFIGURATIONTOCONFIGURATIONPLANNER_HPP_
 
+#include <atomic>
+
 #include <ompl/base/Planner.h>
 #include <ompl/base/ProblemDefinition.h>
 #include <ompl/base/ScopedState.h>
@@ -75,12 +77,25 @@ public:
   trajectory::TrajectoryPtr plan(
       const SolvableProblem& problem, Result* result = nullptr) override;
 
+  /// Stops a running call to \c plan through the termination condition of
+  /// the OMPL planner. A request made while \c plan is not running stops the
+  /// next call to \c plan.
+  /// \return True.
+  bool stopPlanning() override;
+
+  // Documentation inherited.
+  void clearStopRequest() override;
+
   /// Returns the underlying OMPL planner used.
   ::ompl::base::PlannerPtr getOMPLPlanner();
 
 protected:
   /// Pointer to the underlying OMPL Planner.
   ::ompl::base::PlannerPtr mPlanner;
+
+  /// Whether stopPlanning was called. Cleared when \c plan returns and by
+  /// \c clearStopRequest.
+  std::atomic<bool> mStopRequested;
 };
 
 } // namespace ompl
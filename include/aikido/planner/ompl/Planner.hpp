@@ -138,6 +138,9 @@ trajectory::InterpolatedPtr planOMPL(
 /// extension
 /// \param _minStepsize The minimum distance between two states for the them to
 /// be considered "different"
+/// \param _lazyValidation If true, tree extensions are only fully validated
+/// once they are part of a candidate solution path. See
+/// CRRT::setLazyValidation.
 trajectory::InterpolatedPtr planCRRT(
     const statespace::StateSpace::State* _start,
     constraint::TestablePtr _goalTestable,
@@ -153,7 +156,8 @@ trajectory::InterpolatedPtr planCRRT(
     double _maxPlanTime,
     double _maxExtensionDistance,
     double _maxDistanceBtwProjections,
-    double _minStepsize);
+    double _minStepsize,
+    bool _lazyValidation = false);
 
 /// Use the CRRT planner to plan a trajectory that moves from the
 /// start to a goal region while respecting a constraint
@@ -190,6 +194,9 @@ trajectory::InterpolatedPtr planCRRT(
 /// goal tree to consider them connected
 /// \param _minStepsize The minimum distance between two states for the them to
 /// be considered "different"
+/// \param _lazyValidation If true, tree extensions are only fully validated
+/// once they are part of a candidate solution path. See
+/// CRRT::setLazyValidation.
 trajectory::InterpolatedPtr planCRRTConnect(
     const statespace::StateSpace::State* _start,
     constraint::TestablePtr _goalTestable,
@@ -206,7 +213,8 @@ trajectory::InterpolatedPtr planCRRTConnect(
     double _maxExtensionDistance,
     double _maxDistanceBtwProjections,
     double _minStepsize,
-    double _minTreeConnectionDistance);
+    double _minTreeConnectionDistance,
+    bool _lazyValidation = false);
 
 /// Generate an OMPL SpaceInformation from aikido components
 /// \param _stateSpace The StateSpace that the SpaceInformation operates on
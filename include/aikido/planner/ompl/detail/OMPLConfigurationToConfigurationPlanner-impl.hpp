@@ -37,6 +37,7 @@ OMPLConfigurationToConfigurationPlanner<PlannerType>::
         constraint::ProjectablePtr boundsProjector,
         double maxDistanceBetweenValidityChecks)
   : ConfigurationToConfigurationPlanner(std::move(stateSpace), rng)
+  , mStopRequested(false)
 {
   if (!interpolator)
     interpolator
@@ -142,9 +143,11 @@ OMPLConfigurationToConfigurationPlanner<PlannerType>::plan(
 
   // TODO (avk): Introduce other termination conditions for planners (as in
   // OMPL).
-  auto solved = mPlanner->solve(::ompl::base::plannerNonTerminatingCondition());
+  auto solved = mPlanner->solve(::ompl::base::PlannerTerminationCondition(
+      [this]() { return mStopRequested.load(); }));
+  const bool stopped = mStopRequested.exchange(false);
 
-  if (solved)
+  if (solved && !stopped)
   {
     auto returnTraj = std::make_shared<trajectory::Interpolated>(
         mStateSpace, sspace->getInterpolator());
@@ -175,11 +178,29 @@ OMPLConfigurationToConfigurationPlanner<PlannerType>::plan(
   }
 
   if (result)
-    result->setMessage("Problem could not be solved.");
+  {
+    result->setMessage(
+        stopped ? "Planning was stopped." : "Problem could not be solved.");
+  }
   mPlanner->clear();
   return nullptr;
 }
 
+//==============================================================================
+template <class PlannerType>
+bool OMPLConfigurationToConfigurationPlanner<PlannerType>::stopPlanning()
+{
+  mStopRequested = true;
+  return true;
+}
+
+//==============================================================================
+template <class PlannerType>
+void OMPLConfigurationToConfigurationPlanner<PlannerType>::clearStopRequest()
+{
+  mStopRequested = false;
+}
+
 //==============================================================================
 template <class PlannerType>
 ::ompl::base::PlannerPtr
@@ -1,8 +1,13 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 
+#include <memory>
+#include <vector>
+
 #include <Eigen/Dense>
 
+#include "aikido/common/ThreadPool.hpp"
+#include "aikido/planner/PlanningContextPool.hpp"
 #include "aikido/planner/TrajectoryPostProcessor.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
@@ -55,6 +60,50 @@ std::unique_ptr<trajectory::Spline> doShortcut(
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
     double _tolerance = DEFAULT_TOLERANCE);
 
+/// Shortcut waypoints in a trajectory using parabolic splines, checking
+/// several candidate shortcuts in parallel.
+///
+/// This function works like the other overload of doShortcut, but samples
+/// \c _numCandidates pairs of times in each iteration. The shortcuts between
+/// them are checked concurrently on \c _threadPool against the current
+/// trajectory, spread over the elements of \c _feasibilityChecks, each of
+/// which is used by one thread at a time. The feasible shortcuts that do not
+/// overlap are then applied in the order they were sampled, so for a fixed
+/// seed of \c _rng the result only depends on \c _numCandidates and on the
+/// number of iterations that fit in \c _timelimit, and not on the number of
+/// feasibility checks.
+///
+/// \param _inputTrajectory input piecewise Geodesic trajectory
+/// \param _threadPool thread pool to check the shortcuts on
+/// \param _feasibilityChecks equivalent feasibility checks that can be used
+/// concurrently, e.g. the constraints of the contexts of a
+/// PlanningContextPool
+/// \param _numCandidates number of candidate shortcuts per iteration
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _rng A random generator for sampling time in shortcut.
+/// \param _timelimit The maximum time to allow for doing shortcut
+/// \param _checkResolution the resolution in discretizing a segment in
+/// checking the feasibility of the segment
+/// \param _tolerance this tolerance is used in a piecewise linear
+/// discretization that deviates no more than \c _tolerance
+/// from the parabolic ramp along any axis, and then checks for
+/// configuration and segment feasibility along that piecewise linear path.
+/// \return smoothed trajectory that satisfies acceleration constraints
+/// \throws invalid_argument if \c _feasibilityChecks is empty or contains
+/// nullptr, or if \c _numCandidates is zero.
+std::unique_ptr<trajectory::Spline> doShortcut(
+    const trajectory::Spline& _inputTrajectory,
+    common::ThreadPool& _threadPool,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    std::size_t _numCandidates,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit = DEFAULT_TIMELIMIT,
+    double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+    double _tolerance = DEFAULT_TOLERANCE);
+
 /// Blend around waypoints in a trajectory using parabolic splines.
 ///
 /// This function smooths `_inputTrajectory` by blending around
@@ -131,6 +180,47 @@ std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
     double _tolerance = DEFAULT_TOLERANCE);
 
+/// Shortcut and blends waypoints in a trajectory using parabolic splines,
+/// checking several candidate shortcuts in parallel.
+///
+/// Shortcutting works like the parallel overload of doShortcut. Blending is
+/// sequential and uses the first element of \c _feasibilityChecks.
+///
+/// \param _inputTrajectory input piecewise Geodesic trajectory
+/// \param _threadPool thread pool to check the shortcuts on
+/// \param _feasibilityChecks equivalent feasibility checks that can be used
+/// concurrently
+/// \param _numCandidates number of candidate shortcuts per iteration
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _rng A random generator for sampling time in shortcut.
+/// \param _timelimit The maximum time to allow for doing shortcut
+/// (unit in second)
+/// \param _blendRadius the radius used in doing blend
+/// \param _blendIterations the maximum iteration number in doing blend
+/// \param _checkResolution the resolution in discretizing a segment in
+/// checking the feasibility of the segment
+/// \param _tolerance this tolerance is used in a piecewise linear
+/// discretization that deviates no more than \c _tolerance
+/// from the parabolic ramp along any axis, and then checks for
+/// configuration and segment feasibility along that piecewise linear path.
+/// \return smoothed trajectory that satisfies acceleration constraints
+/// \throws invalid_argument if \c _feasibilityChecks is empty or contains
+/// nullptr, or if \c _numCandidates is zero.
+std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
+    const trajectory::Spline& _inputTrajectory,
+    common::ThreadPool& _threadPool,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    std::size_t _numCandidates,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit = DEFAULT_TIMELIMIT,
+    double _blendRadius = DEFAULT_BLEND_RADIUS,
+    int _blendIterations = DEFAULT_BLEND_ITERATIONS,
+    double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+    double _tolerance = DEFAULT_TOLERANCE);
+
 /// Class for performing parabolic smoothing on trajectories
 class ParabolicSmoother : public aikido::planner::TrajectoryPostProcessor
 {
@@ -237,6 +327,29 @@ public:
       const aikido::common::RNG& _rng,
       const aikido::constraint::TestablePtr& _collisionTestable) override;
 
+  /// Enables parallel shortcutting. \c _numCandidates candidate shortcuts
+  /// are then checked per iteration, concurrently on \c _threadPool: with the
+  /// constraint passed to postprocess, and with the constraints of contexts
+  /// checked out of \c _contextPool for the duration of smoothing. Contexts
+  /// are checked out without waiting, so that a caller holding one cannot
+  /// deadlock. If fewer are free, each constraint checks more of the
+  /// candidates, so the result does not depend on how many are free.
+  ///
+  /// \param _contextPool Pool of contexts whose constraints are equivalent to
+  /// the constraint passed to postprocess, or nullptr to shortcut
+  /// sequentially. postprocess throws invalid_argument if the constraint of
+  /// a context has a different StateSpace.
+  /// \param _threadPool Thread pool to check the shortcuts on. If nullptr, a
+  /// pool with one thread per context, plus one, is created.
+  /// \param _numCandidates Number of candidate shortcuts per iteration, or
+  /// zero for one per thread of the thread pool.
+  /// \throws invalid_argument if \c _threadPool is not nullptr but
+  /// \c _contextPool is.
+  void setParallelShortcut(
+      PlanningContextPoolPtr _contextPool,
+      std::shared_ptr<common::ThreadPool> _threadPool = nullptr,
+      std::size_t _numCandidates = 0u);
+
 private:
   /// Common logic to do shortcutting and/or blending on the input trajectory
   /// as dictated by mEnableShortcut and mEnableBlend.
@@ -271,6 +384,16 @@ private:
 
   /// Set to the value of \c _blendIterations.
   int mBlendIterations;
+
+  /// Contexts whose constraints are used for parallel shortcutting, or
+  /// nullptr if shortcutting is sequential.
+  PlanningContextPoolPtr mContextPool;
+
+  /// Thread pool used for parallel shortcutting.
+  std::shared_ptr<common::ThreadPool> mThreadPool;
+
+  /// Number of candidate shortcuts per iteration of parallel shortcutting.
+  std::size_t mNumCandidates;
 };
 
 } // namespace parabolic
@@ -0,0 +1,131 @@
+#ifndef AIKIDO_PLANNER_PARABOLIC_STREAMINGPARABOLICTIMER_HPP_
+#define AIKIDO_PLANNER_PARABOLIC_STREAMINGPARABOLICTIMER_HPP_
+
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "aikido/statespace/GeodesicInterpolator.hpp"
+#include "aikido/statespace/StateSpace.hpp"
+#include "aikido/trajectory/Spline.hpp"
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+
+/// Incrementally computes the parabolic timing of a piecewise Geodesic path
+/// whose waypoints arrive one at a time, e.g. from a planner that is still
+/// running. Timed \c Spline segments are emitted as soon as they are final,
+/// so execution can start before the whole path is known.
+///
+/// Like \c computeParabolicTiming, the output \b exactly follows the input
+/// path and stops at each waypoint. Each segment therefore depends only on
+/// its two end waypoints, and with the default lookahead of one the emitted
+/// segments are identical to those of \c computeParabolicTiming on the whole
+/// path.
+///
+/// With a larger lookahead, the timer holds back up to \c _maxLookahead input
+/// segments that continue in the same direction and times them as a single
+/// straight segment. The robot then does not stop at the intermediate
+/// waypoints, which are within \c _collinearTolerance of the output path.
+/// Waypoints are held back only until a waypoint that changes direction
+/// arrives, the lookahead is full, or \c finish is called.
+///
+/// This class curently only supports \c RealVector, \c SO2, and compound
+/// state spaces of those types.
+class StreamingParabolicTimer
+{
+public:
+  /// \param _stateSpace State space of the input waypoints.
+  /// \param _velocityLimits Maximum velocity for each dimension.
+  /// \param _accelerationLimits Maximum acceleration for each dimension.
+  /// \param _startTime Start time of the first emitted segment.
+  /// \param _maxLookahead Maximum number of input segments that are timed
+  /// as one output segment. Must be positive.
+  /// \param _collinearTolerance Maximum distance of each held back waypoint
+  /// from the straight segment that replaces the held back segments.
+  StreamingParabolicTimer(
+      statespace::ConstStateSpacePtr _stateSpace,
+      const Eigen::VectorXd& _velocityLimits,
+      const Eigen::VectorXd& _accelerationLimits,
+      double _startTime = 0.,
+      std::size_t _maxLookahead = 1,
+      double _collinearTolerance = 1e-6);
+
+  /// Appends a waypoint to the path.
+  ///
+  /// \param _state Next waypoint of the path.
+  /// \return Segments that were timed by this waypoint, starting at the end
+  /// time of the previously emitted segments, or \c nullptr if there are none.
+  std::unique_ptr<trajectory::Spline> addWaypoint(
+      const statespace::StateSpace::State* _state);
+
+  /// Times all held back segments. Call this after the last waypoint.
+  ///
+  /// \return Remaining segments, or \c nullptr if there are none.
+  std::unique_ptr<trajectory::Spline> finish();
+
+  /// Discards all waypoints and restarts the timing at \c _startTime.
+  ///
+  /// \param _startTime Start time of the next emitted segment.
+  void reset(double _startTime = 0.);
+
+  /// Returns the end time of the segments emitted so far.
+  double getEndTime() const;
+
+  /// Returns the number of input segments that are held back.
+  std::size_t getNumPendingSegments() const;
+
+private:
+  /// Returns true if the held back segments, extended to \c _end, can be
+  /// replaced by the straight segment from \c mRunStart to \c _end: every
+  /// held back waypoint is within \c mCollinearTolerance of it, and the
+  /// waypoints advance along it.
+  bool continuesRun(const Eigen::VectorXd& _end) const;
+
+  /// Times the straight segment from \c mRunStart to \c mRunEnd.
+  std::unique_ptr<trajectory::Spline> emitRun();
+
+  /// State space of the input waypoints.
+  const statespace::ConstStateSpacePtr mStateSpace;
+
+  /// Interpolator used to compute the step between waypoints.
+  const statespace::GeodesicInterpolator mInterpolator;
+
+  /// Set to the value of \c _velocityLimits.
+  const Eigen::VectorXd mVelocityLimits;
+
+  /// Set to the value of \c _accelerationLimits.
+  const Eigen::VectorXd mAccelerationLimits;
+
+  /// Set to the value of \c _maxLookahead.
+  const std::size_t mMaxLookahead;
+
+  /// Set to the value of \c _collinearTolerance.
+  const double mCollinearTolerance;
+
+  /// End time of the segments emitted so far.
+  double mEndTime;
+
+  /// Last waypoint. Only valid if \c mHasLastState is true.
+  statespace::StateSpace::ScopedState mLastState;
+
+  /// Whether a waypoint was added since construction or the last reset.
+  bool mHasLastState;
+
+  /// Start and end of the held back segments in unwrapped coordinates.
+  Eigen::VectorXd mRunStart;
+  Eigen::VectorXd mRunEnd;
+
+  /// Held back waypoints between \c mRunStart and \c mRunEnd.
+  std::vector<Eigen::VectorXd> mRunWaypoints;
+
+  /// Number of held back input segments.
+  std::size_t mNumPendingSegments;
+};
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
+
+#endif // ifndef AIKIDO_PLANNER_PARABOLIC_STREAMINGPARABOLICTIMER_HPP_
@@ -11,6 +11,7 @@
 #include "aikido/common/ExecutorThread.hpp"
 #include "aikido/common/RNG.hpp"
 #include "aikido/constraint/dart/CollisionFree.hpp"
+#include "aikido/constraint/dart/SelfCollisionMatrix.hpp"
 #include "aikido/constraint/dart/TSR.hpp"
 #include "aikido/control/TrajectoryExecutor.hpp"
 #include "aikido/distance/ConfigurationRanker.hpp"
@@ -93,6 +94,30 @@ public:
       const dart::dynamics::MetaSkeletonPtr& metaSkeleton,
       const constraint::dart::CollisionFreePtr& collisionFree) const override;
 
+  /// Sets the pairs of BodyNodes whose collisions are skipped by the self
+  /// collision constraint. The pairs are added to the self collision filter,
+  /// which is created if this robot has none, so they stay disabled if the
+  /// matrix is replaced later. A sub-robot forwards the matrix to its root
+  /// robot, whose filter is used by the self collision constraint.
+  /// \param[in] matrix Pairs of BodyNodes of this robot to skip.
+  /// \throw std::runtime_error if this is a sub-robot of a robot that is not
+  /// a ConcreteRobot.
+  void setSelfCollisionMatrix(
+      constraint::dart::ConstSelfCollisionMatrixPtr matrix);
+
+  /// Returns the matrix set by \c setSelfCollisionMatrix, or nullptr. A
+  /// sub-robot returns the matrix of its root robot.
+  constraint::dart::ConstSelfCollisionMatrixPtr getSelfCollisionMatrix() const;
+
+  /// Computes a SelfCollisionMatrix by sampling configurations of this robot
+  /// with its random number generator and collision detector, and sets it
+  /// with \c setSelfCollisionMatrix. The caller must lock the Skeleton of
+  /// this robot.
+  /// \param[in] numSamples Number of sampled configurations.
+  /// \return The computed matrix.
+  constraint::dart::ConstSelfCollisionMatrixPtr computeSelfCollisionMatrix(
+      std::size_t numSamples = 10000u);
+
   /// Get a postprocessor that respects velocity and acceleration limits. The
   /// specific postprocessor returned is controlled by `postProcessorParams`.
   /// \param[in] metaSkeleton Metaskeleton of the path.
@@ -266,6 +291,10 @@ private:
 
   std::unique_ptr<aikido::common::RNG> cloneRNG();
 
+  /// Returns mRootRobot, which keeps the self collision matrix of this robot.
+  /// \throw std::runtime_error if mRootRobot is not a ConcreteRobot.
+  ConcreteRobot* getConcreteRootRobot() const;
+
   /// If this robot belongs to another (Composite)Robot,
   /// mRootRobot is the topmost robot containing this robot.
   Robot* mRootRobot;
@@ -297,6 +326,9 @@ private:
   ::dart::collision::CollisionDetectorPtr mCollisionDetector;
   std::shared_ptr<dart::collision::BodyNodeCollisionFilter>
       mSelfCollisionFilter;
+
+  /// Pairs of BodyNodes added to mSelfCollisionFilter.
+  constraint::dart::ConstSelfCollisionMatrixPtr mSelfCollisionMatrix;
 };
 
 } // namespace robot
@@ -1,12 +1,16 @@
+#include "aikido/statespace/ArenaStateAllocator.hpp"
 #include "aikido/statespace/CartesianProduct.hpp"
 #include "aikido/statespace/GeodesicInterpolator.hpp"
 #include "aikido/statespace/Interpolator.hpp"
+#include "aikido/statespace/PoolStateAllocator.hpp"
 #include "aikido/statespace/Rn.hpp"
 #include "aikido/statespace/SE2.hpp"
 #include "aikido/statespace/SE3.hpp"
 #include "aikido/statespace/SO2.hpp"
 #include "aikido/statespace/SO3.hpp"
 #include "aikido/statespace/ScopedState.hpp"
+#include "aikido/statespace/StateAllocator.hpp"
+#include "aikido/statespace/StateBatch.hpp"
 #include "aikido/statespace/StateHandle.hpp"
 #include "aikido/statespace/StateSpace.hpp"
 #include "aikido/statespace/dart/JointStateSpace.hpp"
@@ -0,0 +1,62 @@
+#ifndef AIKIDO_STATESPACE_ARENASTATEALLOCATOR_HPP_
+#define AIKIDO_STATESPACE_ARENASTATEALLOCATOR_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aikido/statespace/StateAllocator.hpp"
+
+namespace aikido {
+namespace statespace {
+
+AIKIDO_DECLARE_POINTERS(ArenaStateAllocator)
+
+/// StateAllocator that hands out memory sequentially from large chunks.
+/// Deallocating does nothing. Instead, all memory is released at once by
+/// \c release, e.g. when a planner discards its search tree.
+///
+/// Since the objects in the arena are not destructed, it must only hold
+/// objects that are trivially destructible, such as States.
+class ArenaStateAllocator : public StateAllocator
+{
+public:
+  /// Constructor.
+  ///
+  /// \param chunkSize number of bytes allocated at once when the arena runs
+  /// out of memory
+  /// \throws invalid_argument if \c chunkSize is zero.
+  explicit ArenaStateAllocator(std::size_t chunkSize = 65536u);
+
+  // Documentation inherited.
+  void* allocate(std::size_t size) override;
+
+  /// Does nothing. The memory is reclaimed by \c release.
+  void deallocate(void* buffer, std::size_t size) override;
+
+  /// Releases all memory allocated by this arena. It is undefined behavior
+  /// to access any object in the arena afterwards.
+  void release();
+
+  /// Returns the number of chunks allocated from the heap.
+  std::size_t getNumChunks() const;
+
+private:
+  std::size_t mChunkSize;
+
+  /// Protects the members below.
+  mutable std::mutex mMutex;
+
+  std::vector<std::unique_ptr<char[]>> mChunks;
+
+  /// Number of bytes used in the last chunk.
+  std::size_t mUsed;
+
+  /// Size of the last chunk.
+  std::size_t mCapacity;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // AIKIDO_STATESPACE_ARENASTATEALLOCATOR_HPP_
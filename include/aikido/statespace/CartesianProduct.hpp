@@ -152,6 +152,13 @@ public:
   /// Format: [0: ...] [1: ...] ... [n: ...]
   void print(const StateSpace::State* _state, std::ostream& _os) const override;
 
+protected:
+  /// Returns the offset of a substate in bytes, without the type check of
+  /// \c getSubState.
+  ///
+  /// \param _index Index of the subspace.
+  std::size_t getSubStateOffset(std::size_t _index) const;
+
 private:
   std::vector<ConstStateSpacePtr> mSubspaces;
   std::vector<std::size_t> mOffsets;
@@ -0,0 +1,89 @@
+#ifndef AIKIDO_STATESPACE_POOLSTATEALLOCATOR_HPP_
+#define AIKIDO_STATESPACE_POOLSTATEALLOCATOR_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aikido/statespace/StateAllocator.hpp"
+#include "aikido/statespace/StateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+
+AIKIDO_DECLARE_POINTERS(PoolStateAllocator)
+
+/// StateAllocator that hands out fixed-size blocks from large chunks of
+/// memory. Deallocated blocks are kept on a free list and reused, and chunks
+/// are only returned to the heap when the allocator is destructed.
+///
+/// \code
+/// stateSpace->setStateAllocator(
+///     std::make_shared<PoolStateAllocator>(*stateSpace));
+/// \endcode
+class PoolStateAllocator : public StateAllocator
+{
+public:
+  /// Constructs a pool of blocks of \c blockSize bytes.
+  ///
+  /// \param blockSize size of each block, in bytes
+  /// \param numBlocksPerChunk number of blocks allocated at once when the
+  /// pool runs out of blocks
+  /// \throws invalid_argument if \c blockSize or \c numBlocksPerChunk is zero.
+  explicit PoolStateAllocator(
+      std::size_t blockSize, std::size_t numBlocksPerChunk = 1024u);
+
+  /// Constructs a pool of blocks that each hold a state of \c stateSpace.
+  ///
+  /// \param stateSpace state space whose states are allocated
+  /// \param numBlocksPerChunk number of blocks allocated at once when the
+  /// pool runs out of blocks
+  explicit PoolStateAllocator(
+      const StateSpace& stateSpace, std::size_t numBlocksPerChunk = 1024u);
+
+  /// \copydoc StateAllocator::allocate()
+  /// \throws invalid_argument if \c size is larger than the block size.
+  void* allocate(std::size_t size) override;
+
+  // Documentation inherited.
+  void deallocate(void* buffer, std::size_t size) override;
+
+  /// Returns the size of each block, in bytes.
+  std::size_t getBlockSize() const;
+
+  /// Returns the number of blocks that are currently allocated.
+  std::size_t getNumAllocatedBlocks() const;
+
+  /// Returns the number of chunks allocated from the heap.
+  std::size_t getNumChunks() const;
+
+private:
+  /// Header of a block on the free list.
+  struct FreeBlock
+  {
+    FreeBlock* mNext;
+  };
+
+  /// Allocates a new chunk and adds its blocks to the free list. The caller
+  /// must lock mMutex.
+  void addChunk();
+
+  /// Size of each block, rounded up to keep blocks aligned.
+  std::size_t mBlockSize;
+
+  std::size_t mNumBlocksPerChunk;
+
+  /// Protects the members below.
+  mutable std::mutex mMutex;
+
+  std::vector<std::unique_ptr<char[]>> mChunks;
+
+  FreeBlock* mFreeList;
+
+  std::size_t mNumAllocatedBlocks;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // AIKIDO_STATESPACE_POOLSTATEALLOCATOR_HPP_
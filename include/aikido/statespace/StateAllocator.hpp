@@ -0,0 +1,38 @@
+#ifndef AIKIDO_STATESPACE_STATEALLOCATOR_HPP_
+#define AIKIDO_STATESPACE_STATEALLOCATOR_HPP_
+
+#include <cstddef>
+
+#include "aikido/common/pointers.hpp"
+
+namespace aikido {
+namespace statespace {
+
+AIKIDO_DECLARE_POINTERS(StateAllocator)
+
+/// Allocates the memory of the states created by StateSpace::allocateState.
+///
+/// Implementations must be thread-safe, since a StateSpace is usually shared
+/// between threads.
+class StateAllocator
+{
+public:
+  virtual ~StateAllocator() = default;
+
+  /// Allocates memory for a state.
+  ///
+  /// \param size number of bytes to allocate
+  /// \return buffer of at least \c size bytes, aligned for any State
+  virtual void* allocate(std::size_t size) = 0;
+
+  /// Returns memory previously returned by \c allocate.
+  ///
+  /// \param buffer buffer returned by \c allocate
+  /// \param size number of bytes passed to \c allocate
+  virtual void deallocate(void* buffer, std::size_t size) = 0;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // AIKIDO_STATESPACE_STATEALLOCATOR_HPP_
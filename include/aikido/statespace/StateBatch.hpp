@@ -0,0 +1,168 @@
+#ifndef AIKIDO_STATESPACE_STATEBATCH_HPP_
+#define AIKIDO_STATESPACE_STATEBATCH_HPP_
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "aikido/statespace/StateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+
+/// A batch of states of one StateSpace, stored as a structure of arrays.
+///
+/// Each state is stored as its log map coordinates (see StateSpace::logMap).
+/// Coordinate \c j of all states is stored contiguously in column \c j of
+/// \c getCoordinates(), so that operations over the whole batch run over
+/// contiguous, aligned arrays.
+///
+/// Subspaces of type R<N> and SO2, which include the joint state spaces of
+/// most manipulators in a MetaSkeletonStateSpace, are handled directly on the
+/// coordinates. Other subspaces fall back to converting each state with the
+/// operations of the subspace.
+class StateBatch
+{
+public:
+  /// Constructs a batch of identity states.
+  ///
+  /// \param stateSpace state space of the states
+  /// \param numStates number of states
+  explicit StateBatch(ConstStateSpacePtr stateSpace, std::size_t numStates = 0);
+
+  /// Returns the state space of the states.
+  const ConstStateSpacePtr& getStateSpace() const;
+
+  /// Returns the number of states.
+  std::size_t getNumStates() const;
+
+  /// Changes the number of states. New states are set to the identity.
+  ///
+  /// \param numStates number of states
+  void resize(std::size_t numStates);
+
+  /// Returns true if all operations work directly on the coordinates, i.e. if
+  /// the state space is made only of R<N> and SO2 spaces.
+  bool isVectorized() const;
+
+  /// Returns the coordinates of the states, with one row per state and one
+  /// column per dimension of the state space.
+  const Eigen::MatrixXd& getCoordinates() const;
+
+  /// Sets a state of the batch.
+  ///
+  /// \param index index of the state in the batch
+  /// \param state state in the state space of the batch
+  void setState(std::size_t index, const StateSpace::State* state);
+
+  /// Gets a state of the batch.
+  ///
+  /// \param index index of the state in the batch
+  /// \param[out] state state in the state space of the batch
+  void getState(std::size_t index, StateSpace::State* state) const;
+
+  /// Sets all states from elements of the tangent space, as
+  /// StateSpace::expMap does for each state. The batch is resized to the
+  /// number of rows of \c tangents.
+  ///
+  /// \param tangents one tangent vector per row
+  void expMap(const Eigen::MatrixXd& tangents);
+
+  /// Gets the elements of the tangent space of all states, as
+  /// StateSpace::logMap does for each state.
+  ///
+  /// \param[out] tangents one tangent vector per row
+  void logMap(Eigen::MatrixXd& tangents) const;
+
+  /// Sets state \c i to the geodesic interpolation between state \c i of
+  /// \c from and state \c i of \c to, as GeodesicInterpolator does. The batch
+  /// is resized to the size of \c from.
+  ///
+  /// \param from start states
+  /// \param to end states, with as many states as \c from
+  /// \param alpha interpolation parameter, where zero is \c from and one is
+  /// \c to
+  /// \throws invalid_argument if the batches have different state spaces or
+  /// sizes.
+  void interpolate(const StateBatch& from, const StateBatch& to, double alpha);
+
+  /// Sets state \c i to the geodesic interpolation between \c from and \c to
+  /// at <tt>alphas[i]</tt>, e.g. to check a motion at many points at once. The
+  /// batch is resized to the size of \c alphas.
+  ///
+  /// \param from start state
+  /// \param to end state
+  /// \param alphas interpolation parameters, where zero is \c from and one is
+  /// \c to
+  void interpolate(
+      const StateSpace::State* from,
+      const StateSpace::State* to,
+      const Eigen::VectorXd& alphas);
+
+  /// Computes the distance between state \c i of this batch and state \c i of
+  /// \c other. The distance is the sum over subspaces of the norm of the
+  /// tangent vector between the substates, which matches the default distance
+  /// metric of R<N>, SO2, SO3 and Cartesian products of them.
+  ///
+  /// \param other batch with as many states as this one
+  /// \param[out] distances one distance per state
+  /// \throws invalid_argument if the batches have different state spaces or
+  /// sizes.
+  void distance(const StateBatch& other, Eigen::VectorXd& distances) const;
+
+  /// Computes the distance between each state of this batch and \c state,
+  /// e.g. for nearest neighbor queries. See the other overload of distance.
+  ///
+  /// \param state state in the state space of the batch
+  /// \param[out] distances one distance per state
+  void distance(
+      const StateSpace::State* state, Eigen::VectorXd& distances) const;
+
+private:
+  /// Coordinates of one subspace.
+  struct Block
+  {
+    enum class Type
+    {
+      RealVector,
+      Angle,
+      Generic
+    };
+
+    Type mType;
+
+    /// Subspace, or the state space of the batch if it is not a
+    /// CartesianProduct.
+    ConstStateSpacePtr mSpace;
+
+    /// First column of the subspace in the coordinates.
+    std::size_t mOffset;
+
+    std::size_t mDimension;
+  };
+
+  /// Throws if \c other is not compatible with this batch.
+  void checkCompatible(const StateBatch& other) const;
+
+  /// Replaces each row of \c coordinates, which are elements of the tangent
+  /// space, with the coordinates of the state they map to. For example,
+  /// angles are wrapped to (-pi, pi].
+  void normalize(Eigen::MatrixXd& coordinates) const;
+
+  ConstStateSpacePtr mStateSpace;
+
+  std::vector<Block> mBlocks;
+
+  /// True if no block is Generic.
+  bool mIsVectorized;
+
+  /// Coordinates of the identity state.
+  Eigen::RowVectorXd mIdentity;
+
+  Eigen::MatrixXd mCoordinates;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // AIKIDO_STATESPACE_STATEBATCH_HPP_
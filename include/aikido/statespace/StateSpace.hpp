@@ -8,6 +8,7 @@
 #include "aikido/common/RNG.hpp"
 #include "aikido/common/pointers.hpp"
 #include "aikido/statespace/ScopedState.hpp"
+#include "aikido/statespace/StateAllocator.hpp"
 
 namespace aikido {
 namespace statespace {
@@ -54,7 +55,9 @@ public:
 
   /// Allocate a new state. This must be deleted with \c freeState. This is a
   /// helper function that allocates memory, uses \c allocateStateInBuffer to
-  /// create a \c State, and returns that pointer.
+  /// create a \c State, and returns that pointer. The memory is allocated by
+  /// the \c StateAllocator of this space if one is set, and on the heap
+  /// otherwise.
   ///
   /// \return state in this space
   virtual State* allocateState() const;
@@ -162,6 +165,22 @@ public:
   /// \param _state The element to print
   /// \param _os The stream to print to
   virtual void print(const State* _state, std::ostream& _os) const = 0;
+
+  /// Sets the allocator used by \c allocateState and \c freeState, e.g. a
+  /// PoolStateAllocator. All states created by \c allocateState must be freed
+  /// before the allocator is changed.
+  ///
+  /// \param _allocator allocator, or nullptr to allocate states on the heap
+  void setStateAllocator(StateAllocatorPtr _allocator);
+
+  /// Returns the allocator used by \c allocateState and \c freeState, or
+  /// nullptr if states are allocated on the heap.
+  ///
+  /// \return allocator of this space
+  const StateAllocatorPtr& getStateAllocator() const;
+
+private:
+  StateAllocatorPtr mStateAllocator;
 };
 
 class StateSpace::State
@@ -9,6 +9,8 @@
 #include "aikido/common/pointers.hpp"
 #include "aikido/statespace/CartesianProduct.hpp"
 #include "aikido/statespace/dart/JointStateSpace.hpp"
+#include "aikido/statespace/dart/RnJoint.hpp"
+#include "aikido/statespace/dart/SO2Joint.hpp"
 
 namespace aikido {
 namespace statespace {
@@ -201,7 +203,44 @@ public:
       const ::dart::dynamics::SkeletonPtr& _skeleton) const;
 
 private:
+  /// Layout of the positions of one joint, precomputed by the constructor so
+  /// that conversions neither look up DOF indices nor allocate.
+  struct JointLayout
+  {
+    const JointStateSpace* mSpace;
+
+    /// Non-null if the joint state space is an SO2Joint.
+    const SO2Joint* mSO2Joint;
+
+    /// Non-null if the joint state space is an R1Joint.
+    const R1Joint* mR1Joint;
+
+    /// Index of the first DOF of the joint in mDofIndices.
+    std::size_t mFirstDof;
+
+    std::size_t mNumDofs;
+  };
+
+  /// Calls \c setPosition(dofIndex, position) for each DOF of \c _state,
+  /// where \c dofIndex is the index of the DOF in the MetaSkeleton.
+  template <class SetPosition>
+  void forEachPosition(const State* _state, SetPosition&& setPosition) const;
+
+  /// Sets \c _state from \c getPosition(dofIndex) for each DOF, where
+  /// \c dofIndex is the index of the DOF in the MetaSkeleton.
+  template <class GetPosition>
+  void setFromPositions(GetPosition&& getPosition, State* _state) const;
+
   Properties mProperties;
+
+  std::vector<JointLayout> mJointLayouts;
+
+  /// MetaSkeleton DOF index of each joint DOF, in joint order.
+  std::vector<std::size_t> mDofIndices;
+
+  /// True if mDofIndices is the identity, i.e. if the joint DOFs are already
+  /// in MetaSkeleton order.
+  bool mIsIdentityLayout;
 };
 
 } // namespace dart
@@ -225,10 +225,23 @@ public:
   // Documentation inherited.
   void evaluate(double t, statespace::StateSpace::State* state) const override;
 
-  // Documentation inherited.
+  /// \copydoc Trajectory::evaluateDerivative()
+  /// \throw If the state space is not a real vector space, SO2 or a Cartesian
+  /// product of them, where the derivatives of the coordinates are the tangent
+  /// vectors.
   void evaluateDerivative(
       double t, int derivative, Eigen::VectorXd& tangentVector) const override;
 
+  /// \copydoc Trajectory::evaluateBatch()
+  /// \note The basis functions at each time are shared by all dimensions.
+  /// \throw If \c derivative is positive and the state space is not a real
+  /// vector space, SO2 or a Cartesian product of them.
+  void evaluateBatch(
+      const Eigen::VectorXd& times,
+      Eigen::MatrixXd& values,
+      int derivative = 0,
+      common::ThreadPool* threadPool = nullptr) const override;
+
   /// Computes arc length.
   ///
   /// \param[in] distanceMetric Distance metric to measure the arc length.
@@ -258,6 +271,15 @@ protected:
       double startTime = 0.0,
       double endTime = 1.0);
 
+  /// Computes a derivative of the coordinates of all dimensions at \c t,
+  /// computing the basis functions once for all dimensions.
+  ///
+  /// \param[in] t Time parameter. Must be within the duration.
+  /// \param[in] derivative Order of derivative, or zero for the coordinates.
+  /// \param[out] values Derivative of the coordinates.
+  void evaluateCoordinates(
+      double t, int derivative, Eigen::VectorXd& values) const;
+
   /// State space.
   statespace::ConstStateSpacePtr mStateSpace;
 
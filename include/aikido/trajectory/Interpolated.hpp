@@ -1,6 +1,8 @@
 #ifndef AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 
+#include <atomic>
+
 #include "aikido/common/pointers.hpp"
 #include "aikido/statespace/GeodesicInterpolator.hpp"
 #include "aikido/trajectory/Trajectory.hpp"
@@ -72,6 +74,14 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  /// \copydoc Trajectory::evaluateBatch()
+  /// \note Sorted times share waypoint lookups.
+  void evaluateBatch(
+      const Eigen::VectorXd& _times,
+      Eigen::MatrixXd& _values,
+      int _derivative = 0,
+      common::ThreadPool* _threadPool = nullptr) const override;
+
 private:
   /// Waypoint in the trajectory.
   struct Waypoint
@@ -92,14 +102,38 @@ private:
     statespace::StateSpace::State* state;
   };
 
-  /// Get the index of the first waypoint whose time value is larger than _t.
-  /// Throws std::domain_error if _t is larger than last waypoint in the
-  /// trajectory.
-  int getWaypointIndexAfterTime(double _t) const;
+  /// Get the index of the first waypoint whose time value is not less than
+  /// _t, or the number of waypoints if _t is larger than the time of the last
+  /// waypoint. The segment found by the previous call, and the one after it,
+  /// are checked before searching all waypoints, so that monotone queries
+  /// take constant time.
+  std::size_t getWaypointIndexAfterTime(double _t) const;
+
+  /// Same as getWaypointIndexAfterTime, but checks the segment ending at
+  /// waypoint \c _hint instead of the one found by the previous call.
+  std::size_t getWaypointIndexAfterTime(double _t, std::size_t _hint) const;
+
+  /// Evaluates the segment that ends at waypoint \c _index, which must be
+  /// the result of getWaypointIndexAfterTime for \c _t.
+  void evaluateSegment(
+      std::size_t _index,
+      double _t,
+      statespace::StateSpace::State* _state) const;
+
+  /// Evaluates the derivative of the segment that ends at waypoint \c _index,
+  /// which must be the result of getWaypointIndexAfterTime for \c _t.
+  void evaluateSegmentDerivative(
+      std::size_t _index,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const;
 
   statespace::ConstStateSpacePtr mStateSpace;
   statespace::ConstInterpolatorPtr mInterpolator;
   std::vector<Waypoint> mWaypoints;
+
+  /// Index returned by the last call to getWaypointIndexAfterTime.
+  mutable std::atomic<std::size_t> mLastWaypointIndex;
 };
 
 } // namespace trajectory
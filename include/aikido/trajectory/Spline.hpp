@@ -25,6 +25,59 @@ AIKIDO_DECLARE_POINTERS(Spline)
 class Spline : public Trajectory
 {
 public:
+  /// Evaluates a \c Spline at a sequence of times, e.g. in a control loop.
+  ///
+  /// The cursor remembers the segment of the last evaluated time. Evaluating
+  /// at the same or a slightly later time only checks that segment and the
+  /// next one, so sampling a spline in order takes amortized constant time
+  /// per sample, regardless of the number of segments. Evaluating at any
+  /// other time falls back to a binary search.
+  ///
+  /// The spline must outlive the cursor. Segments may be added to the spline
+  /// while the cursor is in use.
+  class Cursor
+  {
+  public:
+    /// Constructs a cursor at the start of \c _spline.
+    ///
+    /// \param _spline Spline to evaluate
+    explicit Cursor(const Spline& _spline);
+
+    /// Evaluates the spline at time \c _t. See \c Spline::evaluate. Unlike
+    /// \c Spline::evaluate, this reuses the temporaries of the cursor and does
+    /// not allocate memory.
+    ///
+    /// \param _t Time at which to evaluate the spline
+    /// \param[out] _state State at time \c _t
+    void evaluate(double _t, statespace::StateSpace::State* _state);
+
+    /// Evaluates a derivative of the spline at time \c _t. See
+    /// \c Spline::evaluateDerivative. This does not allocate memory if
+    /// \c _tangentVector already has the dimension of the state space.
+    ///
+    /// \param _t Time at which to evaluate the spline
+    /// \param _derivative Order of derivative
+    /// \param[out] _tangentVector Derivative at time \c _t
+    void evaluateDerivative(
+        double _t, int _derivative, Eigen::VectorXd& _tangentVector);
+
+    /// Gets the index of the segment of the last evaluated time.
+    ///
+    /// \return Segment index
+    std::size_t getSegmentIndex() const;
+
+    /// Moves the cursor back to the first segment.
+    void reset();
+
+  private:
+    const Spline& mSpline;
+    std::size_t mSegmentIndex;
+
+    /// Temporaries used by \c evaluate.
+    statespace::StateSpace::ScopedState mRelativeState;
+    Eigen::VectorXd mTangentVector;
+  };
+
   /// Constructs an empty trajectory.
   ///
   /// \param _stateSpace State space this trajectory is defined in
@@ -106,6 +159,15 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  /// \copydoc Trajectory::evaluateBatch()
+  /// \note Each range of times is evaluated with a \c Cursor, so sorted
+  /// times share segment lookups.
+  void evaluateBatch(
+      const Eigen::VectorXd& _times,
+      Eigen::MatrixXd& _values,
+      int _derivative = 0,
+      common::ThreadPool* _threadPool = nullptr) const override;
+
   /// Gets the number of waypoints.
   /// \return The number of waypoints
   std::size_t getNumWaypoints() const;
@@ -153,17 +215,65 @@ private:
   {
     statespace::StateSpace::State* mStartState;
     Eigen::MatrixXd mCoefficients;
+
+    /// Coefficients of the derivatives of the polynomial. Element \c i holds
+    /// the coefficients of derivative <tt>i + 1</tt>.
+    std::vector<Eigen::MatrixXd> mDerivativeCoefficients;
+
     double mDuration;
   };
 
-  static Eigen::VectorXd evaluatePolynomial(
-      const Eigen::MatrixXd& _coefficients, double _t, int _derivative);
+  /// Evaluates a polynomial with Horner's method.
+  ///
+  /// \param _coefficients Polynomial coefficients, as in \c addSegment
+  /// \param _t Evaluation time
+  /// \param[out] _output Value of the polynomial, resized if needed
+  static void evaluatePolynomial(
+      const Eigen::MatrixXd& _coefficients,
+      double _t,
+      Eigen::VectorXd& _output);
 
+  /// Finds the segment that contains time \c _t by binary search.
+  ///
+  /// \return Index and start time of the segment
   std::pair<std::size_t, double> getSegmentForTime(double _t) const;
 
+  /// Finds the segment that contains time \c _t, checking segment \c _hint
+  /// and the one after it before falling back to a binary search.
+  ///
+  /// \return Index and start time of the segment
+  std::pair<std::size_t, double> getSegmentForTime(
+      double _t, std::size_t _hint) const;
+
+  /// Evaluates segment \c _index, which starts at \c _segmentStartTime, at
+  /// time \c _t. \c _tangentVector and \c _relativeState are temporaries.
+  void evaluateSegment(
+      std::size_t _index,
+      double _segmentStartTime,
+      double _t,
+      statespace::StateSpace::State* _state,
+      Eigen::VectorXd& _tangentVector,
+      statespace::StateSpace::State* _relativeState) const;
+
+  /// Evaluates a derivative of segment \c _index, which starts at
+  /// \c _segmentStartTime, at time \c _t.
+  void evaluateSegmentDerivative(
+      std::size_t _index,
+      double _segmentStartTime,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const;
+
   statespace::ConstStateSpacePtr mStateSpace;
   double mStartTime;
   std::vector<PolynomialSegment> mSegments;
+
+  /// End time of each segment, i.e. the start time plus the cumulative
+  /// duration of the segments up to and including it.
+  std::vector<double> mSegmentEndTimes;
+
+  /// Sum of the durations of all segments.
+  double mDuration;
 };
 
 } // namespace trajectory
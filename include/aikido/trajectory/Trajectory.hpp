@@ -1,8 +1,11 @@
 #ifndef AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 
+#include <functional>
+
 #include <Eigen/Core>
 
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/common/pointers.hpp"
 #include "aikido/statespace/StateSpace.hpp"
 #include "aikido/trajectory/TrajectoryMetadata.hpp"
@@ -72,9 +75,48 @@ public:
   virtual void evaluateDerivative(
       double _t, int _derivative, Eigen::VectorXd& _tangentVector) const = 0;
 
+  /// Evaluates the trajectory at many times, e.g. to sample it densely for
+  /// execution or visualization. If \c _derivative is zero, row \c i of
+  /// \c _values is the log map (see \c StateSpace::logMap) of the state at
+  /// time <tt>_times[i]</tt>, as computed by \c evaluate. Otherwise, it is the
+  /// tangent vector computed by \c evaluateDerivative.
+  ///
+  /// The default implementation evaluates one time at a time. Derived classes
+  /// may share work between the times, and split large batches between the
+  /// threads of \c _threadPool.
+  ///
+  /// \param _times time parameters
+  /// \param[out] _values one row per time and one column per dimension of the
+  /// state space, resized if needed
+  /// \param _derivative order of derivative, or zero to evaluate states
+  /// \param _threadPool thread pool to evaluate large batches on, or nullptr
+  /// to evaluate the whole batch on the calling thread. Must not be the pool
+  /// the caller runs on.
+  virtual void evaluateBatch(
+      const Eigen::VectorXd& _times,
+      Eigen::MatrixXd& _values,
+      int _derivative = 0,
+      common::ThreadPool* _threadPool = nullptr) const;
+
   /// Trajectory metadata
   // TODO: Is metadata required anymore? Delete if not.
   TrajectoryMetadata metadata;
+
+protected:
+  /// Calls \c _function on consecutive ranges of indices [begin, end) that
+  /// together cover [0, \c _numTimes). If \c _threadPool is not nullptr,
+  /// large batches are split into several ranges that are processed in
+  /// parallel on it, so \c _function must be safe to call concurrently on
+  /// different ranges.
+  ///
+  /// \param _numTimes number of times in the batch
+  /// \param _threadPool thread pool to process the ranges on, or nullptr to
+  /// process the whole batch on the calling thread
+  /// \param _function function called with the begin and end of each range
+  static void forEachTimeRange(
+      std::size_t _numTimes,
+      common::ThreadPool* _threadPool,
+      const std::function<void(std::size_t, std::size_t)>& _function);
 };
 
 } // namespace trajectory
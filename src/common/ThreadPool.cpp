@@ -0,0 +1,72 @@
+#include "aikido/common/ThreadPool.hpp"
+
+namespace aikido {
+namespace common {
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t numThreads) : mIsStopping(false)
+{
+  if (numThreads == 0u)
+    numThreads = getDefaultNumThreads();
+
+  mThreads.reserve(numThreads);
+  for (std::size_t i = 0; i < numThreads; ++i)
+    mThreads.emplace_back(&ThreadPool::spin, this);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsStopping = true;
+  }
+  mCondition.notify_all();
+
+  for (auto& thread : mThreads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return mThreads.size();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getDefaultNumThreads()
+{
+  const auto numThreads = std::thread::hardware_concurrency();
+  return numThreads == 0u ? 1u : numThreads;
+}
+
+//==============================================================================
+void ThreadPool::spin()
+{
+  while (true)
+  {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]() { return mIsStopping || !mTasks.empty(); });
+
+      // Drain the queue before stopping so that no future is left without a
+      // value.
+      if (mTasks.empty())
+        return;
+
+      task = std::move(mTasks.front());
+      mTasks.pop();
+    }
+
+    // Exceptions are captured by the packaged_task wrapped in the task.
+    task();
+  }
+}
+
+} // namespace common
+} // namespace aikido
@@ -1,16 +1,48 @@
 #include "aikido/constraint/NewtonsMethodProjectable.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <iostream>
-#include <limits>
-
-#include <dart/math/Geometry.hpp>
-
-#include "aikido/common/PseudoInverse.hpp"
+#include <sstream>
+#include <stdexcept>
 
 namespace aikido {
 namespace constraint {
 
+namespace {
+
+/// Threshold of the PSEUDOINVERSE solver, as in common::pseudoinverse: a
+/// square Jacobian with a larger determinant is inverted exactly, and smaller
+/// singular values are otherwise treated as zero.
+constexpr double kPseudoinverseEpsilon = 1e-6;
+
+} // namespace
+
+//==============================================================================
+struct NewtonsMethodProjectable::Workspace
+{
+  explicit Workspace(const statespace::StateSpace* _stateSpace)
+    : mStep(_stateSpace)
+    , mComposedState(_stateSpace)
+    , mPreviousState(_stateSpace)
+  {
+    // Do nothing
+  }
+
+  statespace::StateSpace::ScopedState mStep;
+  statespace::StateSpace::ScopedState mComposedState;
+  statespace::StateSpace::ScopedState mPreviousState;
+  Eigen::VectorXd mValue;
+  Eigen::MatrixXd mJacobian;
+  Eigen::VectorXd mPreviousValue;
+  Eigen::MatrixXd mPreviousJacobian;
+  Eigen::VectorXd mTangentStep;
+  Eigen::VectorXd mSolverStep;
+  Eigen::MatrixXd mNormalMatrix;
+  Eigen::PartialPivLU<Eigen::MatrixXd> mLu;
+  Eigen::JacobiSVD<Eigen::MatrixXd> mSvd;
+  Eigen::LDLT<Eigen::MatrixXd> mLdlt;
+};
+
 //==============================================================================
 NewtonsMethodProjectable::NewtonsMethodProjectable(
     DifferentiablePtr _differentiable,
@@ -21,6 +53,10 @@ NewtonsMethodProjectable::NewtonsMethodProjectable(
   , mTolerance(std::move(_tolerance))
   , mMaxIteration(_maxIteration)
   , mMinStepSize(_minStepSize)
+  , mLinearSolver(LinearSolver::PSEUDOINVERSE)
+  , mDamping(1e-3)
+  , mWarmStart(false)
+  , mStepSize(1.0)
 {
   if (!mDifferentiable)
     throw std::invalid_argument("_differentiable is nullptr.");
@@ -47,27 +83,26 @@ NewtonsMethodProjectable::NewtonsMethodProjectable(
     throw std::invalid_argument("_minStepsize should be positive.");
 
   mStateSpace = mDifferentiable->getStateSpace();
+  mConstraintTypes = mDifferentiable->getConstraintTypes();
 }
 
 //==============================================================================
-bool NewtonsMethodProjectable::contains(
-    const statespace::StateSpace::State* _s) const
-{
-  Eigen::VectorXd values;
-  mDifferentiable->getValue(_s, values);
-  std::vector<ConstraintType> types = mDifferentiable->getConstraintTypes();
+NewtonsMethodProjectable::~NewtonsMethodProjectable() = default;
 
-  for (int i = 0; i < values.size(); i++)
+//==============================================================================
+bool NewtonsMethodProjectable::contains(const Eigen::VectorXd& _values) const
+{
+  for (int i = 0; i < _values.size(); i++)
   {
-    if (types.at(i) == ConstraintType::EQUALITY)
+    if (mConstraintTypes[i] == ConstraintType::EQUALITY)
     {
-      if (std::abs(values(i)) > mTolerance.at(i))
+      if (std::abs(_values(i)) > mTolerance[i])
         return false;
     }
     else
     {
       // Inequality constraints are satisfied when value <= 0.
-      if (values(i) > mTolerance.at(i))
+      if (_values(i) > mTolerance[i])
         return false;
     }
   }
@@ -75,47 +110,176 @@ bool NewtonsMethodProjectable::contains(
   return true;
 }
 
+//==============================================================================
+double NewtonsMethodProjectable::computeViolation(
+    const Eigen::VectorXd& _values) const
+{
+  double violation = 0.0;
+  for (int i = 0; i < _values.size(); i++)
+  {
+    const double value = mConstraintTypes[i] == ConstraintType::EQUALITY
+                             ? _values(i)
+                             : std::max(_values(i), 0.0);
+    violation += value * value;
+  }
+
+  return violation;
+}
+
+//==============================================================================
+void NewtonsMethodProjectable::computeNewtonStep(Workspace& _workspace) const
+{
+  const Eigen::MatrixXd& jacobian = _workspace.mJacobian;
+  const Eigen::VectorXd& value = _workspace.mValue;
+  Eigen::VectorXd& solverStep = _workspace.mSolverStep;
+  Eigen::VectorXd& tangentStep = _workspace.mTangentStep;
+
+  if (mLinearSolver == LinearSolver::DAMPED_LEAST_SQUARES)
+  {
+    // tangentStep = -J^T * (J * J^T + damping^2 * I)^-1 * value
+    Eigen::MatrixXd& normalMatrix = _workspace.mNormalMatrix;
+    normalMatrix.noalias() = jacobian * jacobian.transpose();
+    normalMatrix.diagonal().array() += mDamping * mDamping;
+    _workspace.mLdlt.compute(normalMatrix);
+    solverStep = _workspace.mLdlt.solve(value);
+    tangentStep.noalias() = -jacobian.transpose() * solverStep;
+    return;
+  }
+
+  // tangentStep = -pinv(J) * value, with the same cases as
+  // common::pseudoinverse.
+  if (jacobian.rows() == jacobian.cols())
+  {
+    _workspace.mLu.compute(jacobian);
+    if (_workspace.mLu.determinant() > kPseudoinverseEpsilon)
+    {
+      tangentStep = _workspace.mLu.solve(value);
+      tangentStep *= -1.0;
+      return;
+    }
+  }
+
+  if (jacobian.cols() == 1)
+  {
+    if (jacobian.isApproxToConstant(0))
+      tangentStep.setZero(1);
+    else
+      tangentStep.noalias()
+          = -jacobian.transpose() * value / jacobian.squaredNorm();
+    return;
+  }
+
+  // pinv(J) = V * pinv(S) * U^T
+  auto& svd = _workspace.mSvd;
+  svd.compute(jacobian, Eigen::ComputeThinU | Eigen::ComputeThinV);
+  const auto& singularValues = svd.singularValues();
+
+  solverStep.noalias() = svd.matrixU().transpose() * value;
+  for (int i = 0; i < singularValues.size(); i++)
+  {
+    if (singularValues(i) > kPseudoinverseEpsilon)
+      solverStep(i) /= singularValues(i);
+    else
+      solverStep(i) = 0;
+  }
+  tangentStep.noalias() = -svd.matrixV() * solverStep;
+}
+
 //==============================================================================
 bool NewtonsMethodProjectable::project(
     const statespace::StateSpace::State* _s,
     statespace::StateSpace::State* _out) const
 {
-  using StateSpace = statespace::StateSpace;
-
   int iteration = 0;
+  auto workspacePtr = acquireWorkspace();
+  Workspace& workspace = *workspacePtr;
+  Eigen::VectorXd& value = workspace.mValue;
+  Eigen::MatrixXd& jacobian = workspace.mJacobian;
+  Eigen::VectorXd& tangentStep = workspace.mTangentStep;
 
   // Initialize _out.
   mStateSpace->copyState(_s, _out);
+  mDifferentiable->getValueAndJacobian(_out, value, jacobian);
 
-  StateSpace::ScopedState step(mStateSpace.get());
+  double stepSize = mWarmStart ? mStepSize.load() : 1.0;
+  double violation = mWarmStart ? computeViolation(value) : 0.0;
 
   /// Newton's method on mDifferentiable
-  while (!contains(_out) && iteration < mMaxIteration)
+  while (!contains(value) && iteration < mMaxIteration)
   {
     iteration++;
 
-    Eigen::VectorXd value;
-    mDifferentiable->getValue(_out, value);
-    Eigen::MatrixXd jac;
-    mDifferentiable->getJacobian(_out, jac);
-
     // Minimization step in tangent space.
-    Eigen::VectorXd tangentStep = -1 * common::pseudoinverse(jac) * value;
+    computeNewtonStep(workspace);
+    tangentStep *= stepSize;
 
     // Break if tangent step is too small.
-    if (tangentStep.maxCoeff() < mMinStepSize
-        && (-1 * tangentStep).maxCoeff() < mMinStepSize)
+    if (tangentStep.lpNorm<Eigen::Infinity>() < mMinStepSize)
       break;
 
+    if (mWarmStart)
+    {
+      mStateSpace->copyState(_out, workspace.mPreviousState);
+      value.swap(workspace.mPreviousValue);
+      jacobian.swap(workspace.mPreviousJacobian);
+    }
+
     // Minimization step in state space.
-    mStateSpace->expMap(tangentStep, step);
-    mStateSpace->compose(_out, step);
+    mStateSpace->expMap(tangentStep, workspace.mStep);
+    mStateSpace->compose(_out, workspace.mStep, workspace.mComposedState);
+    mStateSpace->copyState(workspace.mComposedState, _out);
+    mDifferentiable->getValueAndJacobian(_out, value, jacobian);
+
+    if (mWarmStart)
+    {
+      const double newViolation = computeViolation(value);
+      if (newViolation > violation)
+      {
+        // Undo the step and retry with a smaller one.
+        mStateSpace->copyState(workspace.mPreviousState, _out);
+        value.swap(workspace.mPreviousValue);
+        jacobian.swap(workspace.mPreviousJacobian);
+        stepSize *= 0.5;
+      }
+      else
+      {
+        violation = newViolation;
+        stepSize = std::min(2.0 * stepSize, 1.0);
+      }
+    }
   }
 
-  if (!contains(_out))
-    return false;
+  if (mWarmStart)
+    mStepSize = stepSize;
 
-  return true;
+  const bool projected = contains(value);
+  releaseWorkspace(std::move(workspacePtr));
+  return projected;
+}
+
+//==============================================================================
+std::unique_ptr<NewtonsMethodProjectable::Workspace>
+NewtonsMethodProjectable::acquireWorkspace() const
+{
+  {
+    std::lock_guard<std::mutex> lock(mWorkspacesMutex);
+    if (!mWorkspaces.empty())
+    {
+      auto workspace = std::move(mWorkspaces.back());
+      mWorkspaces.pop_back();
+      return workspace;
+    }
+  }
+
+  return std::unique_ptr<Workspace>(new Workspace(mStateSpace.get()));
+}
+
+//==============================================================================
+void NewtonsMethodProjectable::releaseWorkspace(
+    std::unique_ptr<Workspace> _workspace) const
+{
+  std::lock_guard<std::mutex> lock(mWorkspacesMutex);
+  mWorkspaces.emplace_back(std::move(_workspace));
 }
 
 //==============================================================================
@@ -124,5 +288,42 @@ statespace::ConstStateSpacePtr NewtonsMethodProjectable::getStateSpace() const
   return mDifferentiable->getStateSpace();
 }
 
+//==============================================================================
+void NewtonsMethodProjectable::setLinearSolver(
+    LinearSolver _solver, double _damping)
+{
+  if (_damping <= 0)
+    throw std::invalid_argument("_damping should be positive.");
+
+  mLinearSolver = _solver;
+  mDamping = _damping;
+}
+
+//==============================================================================
+NewtonsMethodProjectable::LinearSolver
+NewtonsMethodProjectable::getLinearSolver() const
+{
+  return mLinearSolver;
+}
+
+//==============================================================================
+double NewtonsMethodProjectable::getDamping() const
+{
+  return mDamping;
+}
+
+//==============================================================================
+void NewtonsMethodProjectable::setWarmStart(bool _warmStart)
+{
+  mWarmStart = _warmStart;
+  mStepSize = 1.0;
+}
+
+//==============================================================================
+bool NewtonsMethodProjectable::getWarmStart() const
+{
+  return mWarmStart;
+}
+
 } // namespace constraint
 } // namespace aikido
@@ -1,10 +1,29 @@
 #include "aikido/constraint/Sampleable.hpp"
 
+#include <stdexcept>
+
 namespace aikido {
 namespace constraint {
 
 /// Value used to represent a potentially infinite number of samples.
 constexpr int SampleGenerator::NO_LIMIT;
 
+//==============================================================================
+std::size_t SampleGenerator::sampleBatch(
+    std::size_t _numSamples,
+    const std::vector<statespace::StateSpace::State*>& _states)
+{
+  if (_states.size() < _numSamples)
+    throw std::invalid_argument("Not enough states for the requested samples.");
+
+  for (std::size_t i = 0; i < _numSamples; ++i)
+  {
+    if (!sample(_states[i]))
+      return i;
+  }
+
+  return _numSamples;
+}
+
 } // namespace constraint
 } // namespace aikido
@@ -0,0 +1,31 @@
+#include "aikido/constraint/Testable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+//==============================================================================
+std::vector<bool> Testable::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::size_t* firstFailure) const
+{
+  std::vector<bool> satisfied(states.size(), false);
+
+  if (firstFailure)
+    *firstFailure = states.size();
+
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    satisfied[i] = isSatisfied(states[i]);
+
+    if (!satisfied[i] && firstFailure)
+    {
+      *firstFailure = i;
+      break;
+    }
+  }
+
+  return satisfied;
+}
+
+} // namespace constraint
+} // namespace aikido
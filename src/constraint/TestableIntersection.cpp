@@ -1,5 +1,6 @@
 #include "aikido/constraint/TestableIntersection.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace aikido {
@@ -41,6 +42,66 @@ bool TestableIntersection::isSatisfied(
   return true;
 }
 
+//==============================================================================
+std::vector<bool> TestableIntersection::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::size_t* firstFailure) const
+{
+  std::vector<bool> satisfied(states.size(), true);
+
+  // Each constraint only tests the states that passed all previous ones.
+  std::vector<const statespace::StateSpace::State*> remainingStates(states);
+  std::vector<std::size_t> remainingIndices(states.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    remainingIndices[i] = i;
+
+  for (const auto& c : mConstraints)
+  {
+    if (remainingStates.empty())
+      break;
+
+    std::size_t subFirstFailure = remainingStates.size();
+    const auto subSatisfied = c->isSatisfiedBatch(
+        remainingStates, firstFailure ? &subFirstFailure : nullptr);
+
+    // Entries past subFirstFailure are unspecified, so they are dropped. None
+    // of them can precede the first failure.
+    const auto numValid = std::min(subFirstFailure + 1, remainingStates.size());
+
+    std::size_t numRemaining = 0;
+    for (std::size_t i = 0; i < numValid; ++i)
+    {
+      if (subSatisfied[i])
+      {
+        remainingStates[numRemaining] = remainingStates[i];
+        remainingIndices[numRemaining] = remainingIndices[i];
+        ++numRemaining;
+      }
+      else
+      {
+        satisfied[remainingIndices[i]] = false;
+      }
+    }
+    remainingStates.resize(numRemaining);
+    remainingIndices.resize(numRemaining);
+  }
+
+  if (firstFailure)
+  {
+    *firstFailure = states.size();
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+      if (!satisfied[i])
+      {
+        *firstFailure = i;
+        break;
+      }
+    }
+  }
+
+  return satisfied;
+}
+
 //==============================================================================
 std::unique_ptr<TestableOutcome> TestableIntersection::createOutcome() const
 {
@@ -1,9 +1,89 @@
 #include "aikido/constraint/dart/CollisionFree.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <unordered_map>
+
+#include <dart/collision/CollisionObject.hpp>
+#include <dart/config.hpp>
+#include <dart/dynamics/Group.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+
 namespace aikido {
 namespace constraint {
 namespace dart {
 
+namespace {
+
+using ::dart::dynamics::ShapeFrame;
+
+//==============================================================================
+/// CollisionObject that only exposes a ShapeFrame. It is used to query a
+/// CollisionFilter about ShapeFrames that belong to another CollisionDetector.
+class ShapeFrameCollisionObject : public ::dart::collision::CollisionObject
+{
+public:
+  ShapeFrameCollisionObject(
+      ::dart::collision::CollisionDetector* collisionDetector,
+      const ShapeFrame* shapeFrame)
+    : ::dart::collision::CollisionObject(collisionDetector, shapeFrame)
+  {
+    // Do nothing
+  }
+
+protected:
+  void updateEngineData() override
+  {
+    // Do nothing
+  }
+};
+
+//==============================================================================
+/// CollisionFilter for cloned ShapeFrames that forwards each query to the
+/// filter of the original ShapeFrames. This keeps e.g. the blacklist of a
+/// BodyNodeCollisionFilter in effect for the clones.
+class ClonedCollisionFilter : public ::dart::collision::CollisionFilter
+{
+public:
+  ClonedCollisionFilter(
+      std::shared_ptr<::dart::collision::CollisionFilter> filter,
+      ::dart::collision::CollisionDetector* collisionDetector,
+      std::unordered_map<const ShapeFrame*, const ShapeFrame*> originals)
+    : mFilter(std::move(filter))
+    , mCollisionDetector(collisionDetector)
+    , mOriginals(std::move(originals))
+  {
+    // Do nothing
+  }
+
+  bool ignoresCollision(
+      const ::dart::collision::CollisionObject* object1,
+      const ::dart::collision::CollisionObject* object2) const override
+  {
+    const ShapeFrameCollisionObject original1(
+        mCollisionDetector, getOriginal(object1->getShapeFrame()));
+    const ShapeFrameCollisionObject original2(
+        mCollisionDetector, getOriginal(object2->getShapeFrame()));
+
+    return mFilter->ignoresCollision(&original1, &original2);
+  }
+
+private:
+  const ShapeFrame* getOriginal(const ShapeFrame* clone) const
+  {
+    const auto it = mOriginals.find(clone);
+    return it == mOriginals.end() ? clone : it->second;
+  }
+
+  std::shared_ptr<::dart::collision::CollisionFilter> mFilter;
+  ::dart::collision::CollisionDetector* mCollisionDetector;
+  std::unordered_map<const ShapeFrame*, const ShapeFrame*> mOriginals;
+};
+
+} // namespace
+
 //==============================================================================
 CollisionFree::CollisionFree(
     statespace::dart::ConstMetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
@@ -14,6 +94,8 @@ CollisionFree::CollisionFree(
   , mMetaSkeleton(std::move(_metaskeleton))
   , mCollisionDetector(std::move(_collisionDetector))
   , mCollisionOptions(std::move(_collisionOptions))
+  , mNumBatchWorkers(1u)
+  , mBatchCloneable(true)
 {
   if (!mMetaSkeletonStateSpace)
     throw std::invalid_argument("_metaSkeletonStateSpace is nullptr.");
@@ -85,6 +167,263 @@ bool CollisionFree::isSatisfied(
   return true;
 }
 
+//==============================================================================
+std::vector<bool> CollisionFree::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::size_t* firstFailure) const
+{
+  std::lock_guard<std::mutex> lock(mBatchMutex);
+
+  if (mNumBatchWorkers <= 1u || states.size() <= 1u || !createBatchWorkers())
+    return Testable::isSatisfiedBatch(states, firstFailure);
+
+  // Read the current positions on the calling thread, so the original
+  // Skeletons are never accessed by the workers.
+  std::vector<Eigen::VectorXd> positions;
+  positions.reserve(mBatchSourceSkeletons.size());
+  for (const auto& skeleton : mBatchSourceSkeletons)
+    positions.emplace_back(skeleton->getPositions());
+
+  // std::vector<bool> is not safe for concurrent writes to distinct entries.
+  std::vector<char> satisfied(states.size(), false);
+  std::atomic<std::size_t> knownFirstFailure(states.size());
+  const bool stopOnFailure = firstFailure != nullptr;
+
+  const auto numWorkers = std::min(mBatchWorkers.size(), states.size());
+  std::vector<std::future<void>> futures;
+  futures.reserve(numWorkers);
+
+  for (std::size_t iworker = 0; iworker < numWorkers; ++iworker)
+  {
+    futures.emplace_back(mThreadPool->submit([&, iworker]() {
+      auto& worker = *mBatchWorkers[iworker];
+
+      for (std::size_t i = 0; i < worker.mSkeletons.size(); ++i)
+        worker.mSkeletons[i]->setPositions(positions[i]);
+
+      // Interleave the states so that all workers start with the states at
+      // the front of the batch, which matters when stopping on failure.
+      for (std::size_t i = iworker; i < states.size(); i += numWorkers)
+      {
+        if (stopOnFailure && i > knownFirstFailure.load())
+          break;
+
+        satisfied[i] = isCollisionFree(states[i], worker);
+
+        if (!satisfied[i])
+        {
+          auto current = knownFirstFailure.load();
+          while (i < current
+                 && !knownFirstFailure.compare_exchange_weak(current, i))
+          {
+            // Retry with the updated value of current.
+          }
+        }
+      }
+    }));
+  }
+
+  for (auto& future : futures)
+    future.get();
+
+  if (firstFailure)
+    *firstFailure = knownFirstFailure.load();
+
+  return std::vector<bool>(satisfied.begin(), satisfied.end());
+}
+
+//==============================================================================
+void CollisionFree::setNumBatchWorkers(std::size_t numWorkers)
+{
+  std::lock_guard<std::mutex> lock(mBatchMutex);
+
+  mNumBatchWorkers = numWorkers == 0u
+                         ? common::ThreadPool::getDefaultNumThreads()
+                         : numWorkers;
+  mBatchWorkers.clear();
+  mBatchSourceSkeletons.clear();
+  mBatchCloneable = true;
+  mThreadPool.reset();
+}
+
+//==============================================================================
+std::size_t CollisionFree::getNumBatchWorkers() const
+{
+  std::lock_guard<std::mutex> lock(mBatchMutex);
+  return mNumBatchWorkers;
+}
+
+//==============================================================================
+bool CollisionFree::createBatchWorkers() const
+{
+  using ::dart::dynamics::ConstSkeletonPtr;
+  using ::dart::dynamics::DegreeOfFreedom;
+  using ::dart::dynamics::Group;
+  using ::dart::dynamics::SkeletonPtr;
+
+  if (!mBatchCloneable)
+    return false;
+
+  if (!mBatchWorkers.empty())
+    return true;
+
+  // Collect the Skeletons whose state affects the collision checks.
+  std::vector<std::shared_ptr<CollisionGroup>> groups(mGroupsToSelfCheck);
+  for (const auto& pair : mGroupsToPairwiseCheck)
+  {
+    groups.emplace_back(pair.first);
+    groups.emplace_back(pair.second);
+  }
+
+  std::unordered_map<const ::dart::dynamics::Skeleton*, std::size_t>
+      skeletonIndices;
+  const auto addSkeleton = [&](ConstSkeletonPtr skeleton) {
+    if (skeletonIndices.emplace(skeleton.get(), mBatchSourceSkeletons.size())
+            .second)
+      mBatchSourceSkeletons.emplace_back(std::move(skeleton));
+  };
+
+  for (std::size_t i = 0; i < mMetaSkeleton->getNumDofs(); ++i)
+    addSkeleton(mMetaSkeleton->getDof(i)->getSkeleton());
+
+  for (const auto& group : groups)
+  {
+    for (std::size_t i = 0; i < group->getNumShapeFrames(); ++i)
+    {
+      const auto shapeNode = group->getShapeFrame(i)->asShapeNode();
+      if (!shapeNode)
+      {
+        // Frames that are not attached to a Skeleton cannot be cloned.
+        mBatchSourceSkeletons.clear();
+        mBatchCloneable = false;
+        return false;
+      }
+      addSkeleton(shapeNode->getSkeleton());
+    }
+  }
+
+  mThreadPool.reset(new common::ThreadPool(mNumBatchWorkers));
+  mBatchWorkers.reserve(mNumBatchWorkers);
+
+  for (std::size_t iworker = 0; iworker < mNumBatchWorkers; ++iworker)
+  {
+    std::unique_ptr<BatchWorker> worker(new BatchWorker);
+
+    worker->mSkeletons.reserve(mBatchSourceSkeletons.size());
+    for (const auto& skeleton : mBatchSourceSkeletons)
+    {
+#if DART_VERSION_AT_LEAST(6, 7, 0)
+      worker->mSkeletons.emplace_back(skeleton->cloneSkeleton());
+#else
+      worker->mSkeletons.emplace_back(skeleton->clone());
+#endif
+    }
+
+    const auto getClonedSkeleton
+        = [&](const ConstSkeletonPtr& skeleton) -> const SkeletonPtr& {
+      return worker->mSkeletons[skeletonIndices.at(skeleton.get())];
+    };
+
+    std::vector<DegreeOfFreedom*> dofs;
+    dofs.reserve(mMetaSkeleton->getNumDofs());
+    for (std::size_t i = 0; i < mMetaSkeleton->getNumDofs(); ++i)
+    {
+      const auto dof = mMetaSkeleton->getDof(i);
+      dofs.emplace_back(
+          getClonedSkeleton(dof->getSkeleton())->getDof(dof->getName()));
+    }
+    worker->mMetaSkeleton
+        = Group::create(mMetaSkeleton->getName(), dofs, false, false);
+
+    worker->mCollisionDetector
+        = mCollisionDetector->cloneWithoutCollisionObjects();
+
+    std::unordered_map<const ShapeFrame*, const ShapeFrame*> originals;
+    std::unordered_map<CollisionGroup*, std::shared_ptr<CollisionGroup>>
+        clonedGroups;
+    const auto cloneGroup = [&](const std::shared_ptr<CollisionGroup>& group) {
+      auto& clonedGroup = clonedGroups[group.get()];
+      if (clonedGroup)
+        return clonedGroup;
+
+      clonedGroup = worker->mCollisionDetector->createCollisionGroup();
+      for (std::size_t i = 0; i < group->getNumShapeFrames(); ++i)
+      {
+        const auto shapeNode = group->getShapeFrame(i)->asShapeNode();
+        const auto clonedShapeNode
+            = getClonedSkeleton(shapeNode->getSkeleton())
+                  ->getBodyNode(shapeNode->getBodyNodePtr()->getName())
+                  ->getShapeNode(shapeNode->getIndexInBodyNode());
+
+        originals[clonedShapeNode] = shapeNode;
+        clonedGroup->addShapeFrame(clonedShapeNode);
+      }
+      return clonedGroup;
+    };
+
+    for (const auto& pair : mGroupsToPairwiseCheck)
+    {
+      worker->mGroupsToPairwiseCheck.emplace_back(
+          cloneGroup(pair.first), cloneGroup(pair.second));
+    }
+    for (const auto& group : mGroupsToSelfCheck)
+      worker->mGroupsToSelfCheck.emplace_back(cloneGroup(group));
+
+    worker->mCollisionOptions = mCollisionOptions;
+    if (mCollisionOptions.collisionFilter)
+    {
+      worker->mCollisionOptions.collisionFilter
+          = std::make_shared<ClonedCollisionFilter>(
+              mCollisionOptions.collisionFilter,
+              mCollisionDetector.get(),
+              std::move(originals));
+    }
+
+    mBatchWorkers.emplace_back(std::move(worker));
+  }
+
+  return true;
+}
+
+//==============================================================================
+void CollisionFree::resetBatchWorkers()
+{
+  std::lock_guard<std::mutex> lock(mBatchMutex);
+
+  mBatchWorkers.clear();
+  mBatchSourceSkeletons.clear();
+  mBatchCloneable = true;
+}
+
+//==============================================================================
+bool CollisionFree::isCollisionFree(
+    const aikido::statespace::StateSpace::State* state,
+    BatchWorker& worker) const
+{
+  auto skelStatePtr = static_cast<
+      const aikido::statespace::dart::MetaSkeletonStateSpace::State*>(state);
+  mMetaSkeletonStateSpace->setState(worker.mMetaSkeleton.get(), skelStatePtr);
+
+  for (const auto& groups : worker.mGroupsToPairwiseCheck)
+  {
+    if (worker.mCollisionDetector->collide(
+            groups.first.get(),
+            groups.second.get(),
+            worker.mCollisionOptions,
+            nullptr))
+      return false;
+  }
+
+  for (const auto& group : worker.mGroupsToSelfCheck)
+  {
+    if (worker.mCollisionDetector->collide(
+            group.get(), worker.mCollisionOptions, nullptr))
+      return false;
+  }
+
+  return true;
+}
+
 //==============================================================================
 std::unique_ptr<TestableOutcome> CollisionFree::createOutcome() const
 {
@@ -100,6 +439,8 @@ void CollisionFree::addPairwiseCheck(
     mGroupsToPairwiseCheck.emplace_back(std::move(_group1), std::move(_group2));
   else
     mGroupsToPairwiseCheck.emplace_back(std::move(_group2), std::move(_group1));
+
+  resetBatchWorkers();
 }
 
 //==============================================================================
@@ -121,6 +462,8 @@ void CollisionFree::removePairwiseCheck(
             mGroupsToPairwiseCheck.end(),
             std::make_pair(_group2, _group1)),
         mGroupsToPairwiseCheck.end());
+
+  resetBatchWorkers();
 }
 
 //==============================================================================
@@ -128,6 +471,8 @@ void CollisionFree::addSelfCheck(
     std::shared_ptr<::dart::collision::CollisionGroup> _group)
 {
   mGroupsToSelfCheck.emplace_back(std::move(_group));
+
+  resetBatchWorkers();
 }
 
 //==============================================================================
@@ -137,6 +482,8 @@ void CollisionFree::removeSelfCheck(
   mGroupsToSelfCheck.erase(
       std::remove(mGroupsToSelfCheck.begin(), mGroupsToSelfCheck.end(), _group),
       mGroupsToSelfCheck.end());
+
+  resetBatchWorkers();
 }
 
 } // namespace dart
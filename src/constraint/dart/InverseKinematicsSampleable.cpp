@@ -1,5 +1,12 @@
 #include "aikido/constraint/dart/InverseKinematicsSampleable.hpp"
 
+#include <algorithm>
+#include <future>
+
+#include <dart/config.hpp>
+#include <dart/dynamics/Group.hpp>
+
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/statespace/SE3.hpp"
 
 namespace aikido {
@@ -56,6 +63,91 @@ private:
   friend class InverseKinematicsSampleable;
 };
 
+// For internal use only.
+class ParallelIkSampleGenerator : public SampleGenerator
+{
+public:
+  ParallelIkSampleGenerator(const ParallelIkSampleGenerator&) = delete;
+  ParallelIkSampleGenerator(ParallelIkSampleGenerator&& other) = delete;
+
+  ParallelIkSampleGenerator& operator=(const ParallelIkSampleGenerator& other)
+      = delete;
+  ParallelIkSampleGenerator& operator=(ParallelIkSampleGenerator&& other)
+      = delete;
+
+  virtual ~ParallelIkSampleGenerator() = default;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  bool sample(statespace::StateSpace::State* _state) override;
+
+  // Documentation inherited.
+  bool canSample() const override;
+
+  // Documentation inherited.
+  int getNumSamples() const override;
+
+private:
+  /// Clones used by one worker thread, and the trial it runs.
+  struct Worker
+  {
+    Worker(
+        const MetaSkeletonStateSpace* _metaSkeletonStateSpace,
+        const SE3* _poseStateSpace);
+
+    ::dart::dynamics::SkeletonPtr mSkeleton;
+
+    /// Clone of the MetaSkeleton with the same DOF ordering.
+    ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+    ::dart::dynamics::InverseKinematicsPtr mInverseKinematics;
+
+    MetaSkeletonStateSpace::ScopedState mSeed;
+    SE3::ScopedState mPose;
+    MetaSkeletonStateSpace::ScopedState mSolution;
+
+    /// Whether the seed and the pose of the trial were sampled.
+    bool mIsSampled;
+
+    /// Whether IK found a solution for the trial.
+    bool mIsSolved;
+  };
+
+  // For internal use only.
+  ParallelIkSampleGenerator(
+      ConstMetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
+      ::dart::dynamics::MetaSkeletonPtr _metaskeleton,
+      ::dart::dynamics::InverseKinematicsPtr _inverseKinematics,
+      std::unique_ptr<SampleGenerator> _poseSampler,
+      std::unique_ptr<SampleGenerator> _seedSampler,
+      int _maxNumTrials,
+      std::size_t _numWorkers);
+
+  /// Solves the trial of \c _worker on its clones.
+  void solve(Worker& _worker) const;
+
+  ConstMetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
+  ::dart::dynamics::SkeletonPtr mSkeleton;
+  std::shared_ptr<const statespace::SE3> mPoseStateSpace;
+  std::unique_ptr<SampleGenerator> mPoseSampler;
+  std::unique_ptr<SampleGenerator> mSeedSampler;
+  int mMaxNumTrials;
+
+  std::vector<std::unique_ptr<Worker>> mWorkers;
+
+  /// Number of trials at the front of mWorkers that were drawn, but not
+  /// needed, by the previous call to \c sample. They are the first trials of
+  /// the next call, so that seeds and poses are used in the order in which
+  /// they are drawn, like in IkSampleGenerator.
+  std::size_t mNumPendingTrials;
+
+  common::ThreadPool mThreadPool;
+
+  friend class InverseKinematicsSampleable;
+};
+
 //==============================================================================
 InverseKinematicsSampleable::InverseKinematicsSampleable(
     ConstMetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
@@ -70,6 +162,7 @@ InverseKinematicsSampleable::InverseKinematicsSampleable(
   , mSeedConstraint(std::move(_seedConstraint))
   , mInverseKinematics(std::move(_inverseKinematics))
   , mMaxNumTrials(_maxNumTrials)
+  , mNumWorkers(1u)
 {
   if (!mMetaSkeletonStateSpace)
     throw std::invalid_argument("MetaSkeletonStateSpace is nullptr.");
@@ -130,6 +223,35 @@ statespace::ConstStateSpacePtr InverseKinematicsSampleable::getStateSpace()
 std::unique_ptr<SampleGenerator>
 InverseKinematicsSampleable::createSampleGenerator() const
 {
+  if (mNumWorkers > 1u)
+  {
+    // The workers only clone the Skeleton of the IK solver.
+    const auto ikSkeleton = mInverseKinematics->getNode()->getSkeleton();
+
+    bool isCloneable = true;
+    for (std::size_t i = 0; i < mMetaSkeleton->getNumDofs(); ++i)
+    {
+      if (mMetaSkeleton->getDof(i)->getSkeleton() != ikSkeleton)
+      {
+        isCloneable = false;
+        break;
+      }
+    }
+
+    if (isCloneable)
+    {
+      return std::unique_ptr<ParallelIkSampleGenerator>(
+          new ParallelIkSampleGenerator(
+              mMetaSkeletonStateSpace,
+              mMetaSkeleton,
+              mInverseKinematics,
+              mPoseConstraint->createSampleGenerator(),
+              mSeedConstraint->createSampleGenerator(),
+              mMaxNumTrials,
+              mNumWorkers));
+    }
+  }
+
   return std::unique_ptr<IkSampleGenerator>(new IkSampleGenerator(
       mMetaSkeletonStateSpace,
       mMetaSkeleton,
@@ -139,6 +261,19 @@ InverseKinematicsSampleable::createSampleGenerator() const
       mMaxNumTrials));
 }
 
+//==============================================================================
+void InverseKinematicsSampleable::setNumWorkers(std::size_t numWorkers)
+{
+  mNumWorkers = numWorkers == 0u ? common::ThreadPool::getDefaultNumThreads()
+                                 : numWorkers;
+}
+
+//==============================================================================
+std::size_t InverseKinematicsSampleable::getNumWorkers() const
+{
+  return mNumWorkers;
+}
+
 //==============================================================================
 IkSampleGenerator::IkSampleGenerator(
     ConstMetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
@@ -245,6 +380,223 @@ int IkSampleGenerator::getNumSamples() const
   return std::min(mSeedSampler->getNumSamples(), mPoseSampler->getNumSamples());
 }
 
+//==============================================================================
+ParallelIkSampleGenerator::Worker::Worker(
+    const MetaSkeletonStateSpace* _metaSkeletonStateSpace,
+    const SE3* _poseStateSpace)
+  : mSeed(_metaSkeletonStateSpace)
+  , mPose(_poseStateSpace)
+  , mSolution(_metaSkeletonStateSpace)
+  , mIsSampled(false)
+  , mIsSolved(false)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ParallelIkSampleGenerator::ParallelIkSampleGenerator(
+    ConstMetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
+    ::dart::dynamics::MetaSkeletonPtr _metaskeleton,
+    ::dart::dynamics::InverseKinematicsPtr _inverseKinematics,
+    std::unique_ptr<SampleGenerator> _poseSampler,
+    std::unique_ptr<SampleGenerator> _seedSampler,
+    int _maxNumTrials,
+    std::size_t _numWorkers)
+  : mMetaSkeletonStateSpace(std::move(_metaSkeletonStateSpace))
+  , mSkeleton(_inverseKinematics->getNode()->getSkeleton())
+  , mPoseStateSpace(
+        std::dynamic_pointer_cast<const SE3>(_poseSampler->getStateSpace()))
+  , mPoseSampler(std::move(_poseSampler))
+  , mSeedSampler(std::move(_seedSampler))
+  , mMaxNumTrials(_maxNumTrials)
+  , mNumPendingTrials(0u)
+  , mThreadPool(_numWorkers)
+{
+  using ::dart::dynamics::BodyNode;
+  using ::dart::dynamics::DegreeOfFreedom;
+  using ::dart::dynamics::EndEffector;
+  using ::dart::dynamics::Group;
+  using ::dart::dynamics::JacobianNode;
+  using ::dart::dynamics::SimpleFrame;
+
+  assert(mMetaSkeletonStateSpace);
+  assert(_metaskeleton);
+  assert(mPoseStateSpace);
+  assert(mPoseSampler);
+  assert(mSeedSampler);
+  assert(mSeedSampler->getStateSpace() == mMetaSkeletonStateSpace);
+  assert(mMaxNumTrials > 0);
+  assert(_numWorkers > 0u);
+
+  const auto node = _inverseKinematics->getNode();
+
+  mWorkers.reserve(_numWorkers);
+  for (std::size_t iworker = 0; iworker < _numWorkers; ++iworker)
+  {
+    std::unique_ptr<Worker> worker(
+        new Worker(mMetaSkeletonStateSpace.get(), mPoseStateSpace.get()));
+
+#if DART_VERSION_AT_LEAST(6, 7, 0)
+    worker->mSkeleton = mSkeleton->cloneSkeleton();
+#else
+    worker->mSkeleton = mSkeleton->clone();
+#endif
+
+    std::vector<DegreeOfFreedom*> dofs;
+    dofs.reserve(_metaskeleton->getNumDofs());
+    for (std::size_t i = 0; i < _metaskeleton->getNumDofs(); ++i)
+    {
+      dofs.emplace_back(
+          worker->mSkeleton->getDof(_metaskeleton->getDof(i)->getName()));
+    }
+    worker->mMetaSkeleton
+        = Group::create(_metaskeleton->getName(), dofs, false, false);
+
+    JacobianNode* clonedNode = nullptr;
+    if (dynamic_cast<const BodyNode*>(node))
+      clonedNode = worker->mSkeleton->getBodyNode(node->getName());
+    else if (dynamic_cast<const EndEffector*>(node))
+      clonedNode = worker->mSkeleton->getEndEffector(node->getName());
+
+    if (!clonedNode)
+    {
+      throw std::invalid_argument(
+          "InverseKinematics node is neither a BodyNode nor an EndEffector.");
+    }
+
+    // The clone shares the target of the original solver, so each worker
+    // gets its own.
+    worker->mInverseKinematics = _inverseKinematics->clone(clonedNode);
+    worker->mInverseKinematics->setTarget(
+        std::make_shared<SimpleFrame>(
+            ::dart::dynamics::Frame::World(),
+            _inverseKinematics->getTarget()->getName()));
+
+    mWorkers.emplace_back(std::move(worker));
+  }
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr ParallelIkSampleGenerator::getStateSpace() const
+{
+  return mMetaSkeletonStateSpace;
+}
+
+//==============================================================================
+bool ParallelIkSampleGenerator::sample(statespace::StateSpace::State* _state)
+{
+  if (!canSample())
+    return false;
+
+  const Eigen::VectorXd positions = mSkeleton->getPositions();
+  for (const auto& worker : mWorkers)
+    worker->mSkeleton->setPositions(positions);
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(mWorkers.size());
+
+  int numTrials = 0;
+  while (numTrials < mMaxNumTrials)
+  {
+    const auto numRoundTrials = std::min(
+        mWorkers.size(), static_cast<std::size_t>(mMaxNumTrials - numTrials));
+
+    // Sample the seeds and poses on this thread, in the same order as
+    // IkSampleGenerator, so that the samples do not depend on thread timing.
+    // Pending trials were already sampled by the previous call.
+    for (std::size_t i = 0; i < numRoundTrials; ++i)
+    {
+      auto& worker = *mWorkers[i];
+      if (i >= mNumPendingTrials)
+      {
+        worker.mIsSampled = mSeedSampler->sample(worker.mSeed)
+                            && mPoseSampler->sample(worker.mPose);
+      }
+      worker.mIsSolved = false;
+    }
+
+    // Trials that were drawn, in order, after those of this round.
+    const auto numDrawnTrials = std::max(numRoundTrials, mNumPendingTrials);
+
+    futures.clear();
+    for (std::size_t i = 0; i < numRoundTrials; ++i)
+    {
+      const auto worker = mWorkers[i].get();
+      if (worker->mIsSampled)
+      {
+        futures.emplace_back(
+            mThreadPool.submit([this, worker]() { solve(*worker); }));
+      }
+    }
+
+    // Wait for all workers before rethrowing, since they use this frame.
+    for (auto& future : futures)
+      future.wait();
+    for (auto& future : futures)
+      future.get();
+
+    for (std::size_t i = 0; i < numRoundTrials; ++i)
+    {
+      const auto& worker = *mWorkers[i];
+      if (worker.mIsSolved)
+      {
+        mMetaSkeletonStateSpace->copyState(worker.mSolution, _state);
+
+        // Keep the trials drawn after this one for the next call.
+        std::rotate(
+            mWorkers.begin(),
+            mWorkers.begin() + i + 1,
+            mWorkers.begin() + numDrawnTrials);
+        mNumPendingTrials = numDrawnTrials - i - 1;
+        return true;
+      }
+    }
+
+    std::rotate(
+        mWorkers.begin(),
+        mWorkers.begin() + numRoundTrials,
+        mWorkers.begin() + numDrawnTrials);
+    mNumPendingTrials = numDrawnTrials - numRoundTrials;
+    numTrials += static_cast<int>(numRoundTrials);
+  }
+
+  return false;
+}
+
+//==============================================================================
+void ParallelIkSampleGenerator::solve(Worker& _worker) const
+{
+  mMetaSkeletonStateSpace->setState(
+      _worker.mMetaSkeleton.get(), _worker.mSeed);
+
+  _worker.mInverseKinematics->getTarget()->setTransform(
+      _worker.mPose.getIsometry());
+
+#if DART_VERSION_AT_LEAST(6, 8, 0)
+  if (_worker.mInverseKinematics->solveAndApply(true))
+#else
+  if (_worker.mInverseKinematics->solve(true))
+#endif
+  {
+    mMetaSkeletonStateSpace->getState(
+        _worker.mMetaSkeleton.get(), _worker.mSolution);
+    _worker.mIsSolved = true;
+  }
+}
+
+//==============================================================================
+bool ParallelIkSampleGenerator::canSample() const
+{
+  return mNumPendingTrials > 0u
+         || (mSeedSampler->canSample() && mPoseSampler->canSample());
+}
+
+//==============================================================================
+int ParallelIkSampleGenerator::getNumSamples() const
+{
+  return std::min(mSeedSampler->getNumSamples(), mPoseSampler->getNumSamples());
+}
+
 } // namespace dart
 } // namespace constraint
 } // namespace aikido
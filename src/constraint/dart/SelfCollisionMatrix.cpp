@@ -0,0 +1,223 @@
+#include "aikido/constraint/dart/SelfCollisionMatrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <dart/collision/CollisionGroup.hpp>
+#include <dart/collision/CollisionObject.hpp>
+#include <dart/collision/CollisionOption.hpp>
+#include <dart/collision/CollisionResult.hpp>
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/DegreeOfFreedom.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
+
+namespace aikido {
+namespace constraint {
+namespace dart {
+
+namespace {
+
+//==============================================================================
+const ::dart::dynamics::BodyNode* getBodyNode(
+    const ::dart::collision::CollisionObject* collisionObject)
+{
+  const auto shapeNode = collisionObject->getShapeFrame()->asShapeNode();
+  if (!shapeNode)
+    return nullptr;
+
+  return shapeNode->getBodyNodePtr().get();
+}
+
+//==============================================================================
+bool areAdjacent(
+    const ::dart::dynamics::BodyNode* bodyNode1,
+    const ::dart::dynamics::BodyNode* bodyNode2)
+{
+  return bodyNode1->getParentBodyNode() == bodyNode2
+         || bodyNode2->getParentBodyNode() == bodyNode1;
+}
+
+} // namespace
+
+//==============================================================================
+SelfCollisionMatrix SelfCollisionMatrix::compute(
+    const ::dart::dynamics::MetaSkeletonPtr& metaSkeleton,
+    const ::dart::collision::CollisionDetectorPtr& collisionDetector,
+    common::RNG* rng,
+    std::size_t numSamples)
+{
+  if (!metaSkeleton)
+    throw std::invalid_argument("MetaSkeleton is nullptr.");
+
+  if (!collisionDetector)
+    throw std::invalid_argument("CollisionDetector is nullptr.");
+
+  if (!rng)
+    throw std::invalid_argument("RNG is nullptr.");
+
+  if (numSamples == 0u)
+    throw std::invalid_argument("Number of samples must be positive.");
+
+  const auto numBodyNodes = metaSkeleton->getNumBodyNodes();
+  std::unordered_map<const ::dart::dynamics::BodyNode*, std::size_t> indices;
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+    indices.emplace(metaSkeleton->getBodyNode(i), i);
+
+  const auto numDofs = metaSkeleton->getNumDofs();
+  std::vector<std::uniform_real_distribution<double>> distributions;
+  distributions.reserve(numDofs);
+  for (std::size_t i = 0; i < numDofs; ++i)
+  {
+    const auto dof = metaSkeleton->getDof(i);
+    auto lower = dof->getPositionLowerLimit();
+    auto upper = dof->getPositionUpperLimit();
+    if (!std::isfinite(lower) || !std::isfinite(upper))
+    {
+      lower = -M_PI;
+      upper = M_PI;
+    }
+    distributions.emplace_back(lower, upper);
+  }
+
+  const auto group
+      = collisionDetector->createCollisionGroup(metaSkeleton.get());
+
+  // Every colliding pair of shapes must be reported, so the number of contacts
+  // is not limited.
+  const ::dart::collision::CollisionOption option(
+      false, std::numeric_limits<std::size_t>::max(), nullptr);
+  ::dart::collision::CollisionResult result;
+
+  // Number of samples in which BodyNodes i < j collide, at i * n + j.
+  std::vector<std::size_t> counts(numBodyNodes * numBodyNodes, 0u);
+  std::vector<std::size_t> sampleCounted(counts.size(), numSamples);
+
+  const Eigen::VectorXd savedPositions = metaSkeleton->getPositions();
+  Eigen::VectorXd positions(numDofs);
+  for (std::size_t sample = 0; sample < numSamples; ++sample)
+  {
+    for (std::size_t i = 0; i < numDofs; ++i)
+      positions[i] = distributions[i](*rng);
+    metaSkeleton->setPositions(positions);
+
+    result.clear();
+    group->collide(option, &result);
+
+    for (std::size_t k = 0; k < result.getNumContacts(); ++k)
+    {
+      const auto& contact = result.getContact(k);
+      const auto it1 = indices.find(getBodyNode(contact.collisionObject1));
+      const auto it2 = indices.find(getBodyNode(contact.collisionObject2));
+      if (it1 == indices.end() || it2 == indices.end()
+          || it1->second == it2->second)
+        continue;
+
+      const auto i = std::min(it1->second, it2->second);
+      const auto j = std::max(it1->second, it2->second);
+      const auto pair = i * numBodyNodes + j;
+
+      // Pairs of BodyNodes with several shapes may have several contacts.
+      if (sampleCounted[pair] != sample)
+      {
+        sampleCounted[pair] = sample;
+        ++counts[pair];
+      }
+    }
+  }
+  metaSkeleton->setPositions(savedPositions);
+
+  SelfCollisionMatrix matrix;
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const auto bodyNode1 = metaSkeleton->getBodyNode(i);
+    for (std::size_t j = i + 1; j < numBodyNodes; ++j)
+    {
+      const auto bodyNode2 = metaSkeleton->getBodyNode(j);
+      const auto& name1 = bodyNode1->getName();
+      const auto& name2 = bodyNode2->getName();
+      const auto count = counts[i * numBodyNodes + j];
+
+      if (areAdjacent(bodyNode1, bodyNode2))
+        matrix.disable(name1, name2, Reason::ADJACENT);
+      else if (count == numSamples)
+        matrix.disable(name1, name2, Reason::ALWAYS);
+      else if (count == 0u)
+        matrix.disable(name1, name2, Reason::NEVER);
+    }
+  }
+
+  return matrix;
+}
+
+//==============================================================================
+void SelfCollisionMatrix::disable(
+    const std::string& bodyNode1, const std::string& bodyNode2, Reason reason)
+{
+  mDisabledPairs[makeKey(bodyNode1, bodyNode2)] = reason;
+}
+
+//==============================================================================
+void SelfCollisionMatrix::enable(
+    const std::string& bodyNode1, const std::string& bodyNode2)
+{
+  mDisabledPairs.erase(makeKey(bodyNode1, bodyNode2));
+}
+
+//==============================================================================
+bool SelfCollisionMatrix::isDisabled(
+    const std::string& bodyNode1, const std::string& bodyNode2) const
+{
+  return mDisabledPairs.count(makeKey(bodyNode1, bodyNode2)) > 0;
+}
+
+//==============================================================================
+auto SelfCollisionMatrix::getDisabledPairs() const -> const DisabledPairs&
+{
+  return mDisabledPairs;
+}
+
+//==============================================================================
+std::size_t SelfCollisionMatrix::apply(
+    const ::dart::dynamics::MetaSkeleton& metaSkeleton,
+    ::dart::collision::BodyNodeCollisionFilter& filter) const
+{
+  std::unordered_map<std::string, const ::dart::dynamics::BodyNode*> bodyNodes;
+  for (std::size_t i = 0; i < metaSkeleton.getNumBodyNodes(); ++i)
+  {
+    const auto bodyNode = metaSkeleton.getBodyNode(i);
+    bodyNodes.emplace(bodyNode->getName(), bodyNode);
+  }
+
+  std::size_t numApplied = 0u;
+  for (const auto& disabledPair : mDisabledPairs)
+  {
+    const auto it1 = bodyNodes.find(disabledPair.first.first);
+    const auto it2 = bodyNodes.find(disabledPair.first.second);
+    if (it1 == bodyNodes.end() || it2 == bodyNodes.end())
+      continue;
+
+    filter.addBodyNodePairToBlackList(it1->second, it2->second);
+    ++numApplied;
+  }
+
+  return numApplied;
+}
+
+//==============================================================================
+std::pair<std::string, std::string> SelfCollisionMatrix::makeKey(
+    const std::string& bodyNode1, const std::string& bodyNode2)
+{
+  if (bodyNode2 < bodyNode1)
+    return std::make_pair(bodyNode2, bodyNode1);
+
+  return std::make_pair(bodyNode1, bodyNode2);
+}
+
+} // namespace dart
+} // namespace constraint
+} // namespace aikido
@@ -41,6 +41,11 @@ public:
   /// \return a transform within the bounds of this TSR.
   bool sample(statespace::StateSpace::State* _state) override;
 
+  // Documentation inherited.
+  std::size_t sampleBatch(
+      std::size_t _numSamples,
+      const std::vector<statespace::StateSpace::State*>& _states) override;
+
   // Documentation inherited.
   bool canSample() const override;
 
@@ -56,8 +61,24 @@ private:
       const Eigen::Matrix<double, 6, 2>& _Bw,
       const Eigen::Isometry3d& _Tw_e);
 
+  /// Sets \c _sample to the next `x, y, z, roll, pitch, yaw` from the `Bw`
+  /// bounds, or to the bounds themselves for a point TSR.
+  void drawSample(Eigen::Ref<Eigen::Matrix<double, 6, 1>> _sample);
+
+  /// Sets \c _T0_s to `T0_w * Tw_s * Tw_e` for the sample `Tw_s` with roll,
+  /// pitch and yaw \c _angles, whose translation is given already rotated
+  /// into the origin frame.
+  void composeSample(
+      const Eigen::Vector3d& _rotatedTranslation,
+      const Eigen::Vector3d& _angles,
+      Eigen::Isometry3d& _T0_s) const;
+
   std::unique_ptr<common::RNG> mRng;
 
+  /// Distributions of `x, y, z, roll, pitch, yaw` within `Bw`, which are
+  /// created once rather than for each sample.
+  std::vector<std::uniform_real_distribution<double>> mDistributions;
+
   std::shared_ptr<statespace::SE3> mStateSpace;
 
   /// Transformation from origin frame into "wiggle" frame.
@@ -72,6 +93,24 @@ private:
   // True for point TSR.
   bool mPointTSR;
 
+  /// True if `Bw` does not bound the rotation to a range, so that all samples
+  /// share mRotation and mOffset.
+  bool mFixedRotation;
+
+  /// Rotation of `T0_w * Tw_s * Tw_e`, if mFixedRotation is true.
+  Eigen::Matrix3d mRotation;
+
+  /// Translation of `T0_w * Tw_s * Tw_e` for a zero translation of `Tw_s`, if
+  /// mFixedRotation is true.
+  Eigen::Vector3d mOffset;
+
+  /// Samples of sampleBatch, one per column, reused across batches.
+  Eigen::Matrix<double, 6, Eigen::Dynamic> mBatchSamples;
+
+  /// Translations of the samples of sampleBatch rotated into the origin
+  /// frame, reused across batches.
+  Eigen::Matrix<double, 3, Eigen::Dynamic> mBatchTranslations;
+
   // True if point TSR and has already been sampled.
   bool mPointTSRSampled;
 
@@ -217,8 +256,8 @@ bool TSR::isSatisfied(
   auto defaultOutcomeObject
       = dynamic_cast_or_throw<DefaultTestableOutcome>(outcome);
 
-  Eigen::VectorXd dist;
-  getValue(_s, dist);
+  Eigen::Vector6d dist;
+  computeDistances(_s, dist, nullptr);
 
   bool isSatisfiedResult = dist.norm() < mTestableTolerance;
   if (defaultOutcomeObject)
@@ -263,34 +302,72 @@ std::size_t TSR::getConstraintDimension() const
 void TSR::getValue(
     const statespace::StateSpace::State* _s, Eigen::VectorXd& _out) const
 {
-  using SE3 = statespace::SE3;
-  using SE3State = SE3::State;
+  Eigen::Vector6d distances;
+  computeDistances(_s, distances, nullptr);
+  _out = distances;
+}
 
-  auto se3state = static_cast<const SE3State*>(_s);
-  Eigen::Isometry3d se3 = se3state->getIsometry();
+//==============================================================================
+void TSR::getJacobian(
+    const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
+{
+  Eigen::Vector6d distances;
+  Eigen::Matrix6d jacobian;
+  computeDistances(_s, distances, &jacobian);
+  _out = jacobian;
+}
 
+//==============================================================================
+void TSR::getValueAndJacobian(
+    const statespace::StateSpace::State* _s,
+    Eigen::VectorXd& _val,
+    Eigen::MatrixXd& _jac) const
+{
+  Eigen::Vector6d distances;
+  Eigen::Matrix6d jacobian;
+  computeDistances(_s, distances, &jacobian);
+  _val = distances;
+  _jac = jacobian;
+}
+
+//==============================================================================
+void TSR::computeDistances(
+    const statespace::StateSpace::State* _s,
+    Eigen::Vector6d& _distances,
+    Eigen::Matrix6d* _jacobian) const
+{
+  using SE3State = statespace::SE3::State;
   using TransformTraits = Eigen::TransformTraits;
 
-  Eigen::Isometry3d T0_w_inv = mT0_w.inverse(TransformTraits::Isometry);
-  Eigen::Isometry3d Tw_e_inv = mTw_e.inverse(TransformTraits::Isometry);
-  Eigen::Isometry3d Tw_s = T0_w_inv * se3 * Tw_e_inv;
+  const Eigen::Isometry3d& T0_s
+      = static_cast<const SE3State*>(_s)->getIsometry();
+
+  // The inverses are computed once per call, since mT0_w and mTw_e can be
+  // changed at any time.
+  const Eigen::Isometry3d T0_w_inv = mT0_w.inverse(TransformTraits::Isometry);
+  const Eigen::Isometry3d Tw_e_inv = mTw_e.inverse(TransformTraits::Isometry);
+  const Eigen::Isometry3d Tw_s = T0_w_inv * T0_s * Tw_e_inv;
 
-  Eigen::Vector3d translation = Tw_s.translation();
-  Eigen::Vector3d eulerOrig = ::dart::math::matrixToEulerZYX(Tw_s.linear());
-  Eigen::Vector3d eulerZYX = eulerOrig.reverse();
+  const Eigen::Vector3d translation = Tw_s.translation();
+  const Eigen::Vector3d eulerZYX
+      = ::dart::math::matrixToEulerZYX(Tw_s.linear()).reverse();
 
-  _out.resize(6);
+  // Derivative of each distance with respect to its coordinate: -1, 0 or 1.
+  Eigen::Vector6d slopes(Eigen::Vector6d::Zero());
+  _distances.setZero();
 
   for (int i = 0; i < 3; ++i)
   {
     if (translation(i) < mBw(i, 0))
-      _out(i) = std::abs(translation(i) - mBw(i, 0));
-
+    {
+      _distances(i) = mBw(i, 0) - translation(i);
+      slopes(i) = -1.0;
+    }
     else if (translation(i) > mBw(i, 1))
-      _out(i) = std::abs(translation(i) - mBw(i, 1));
-
-    else
-      _out(i) = 0;
+    {
+      _distances(i) = translation(i) - mBw(i, 1);
+      slopes(i) = 1.0;
+    }
   }
 
   for (int i = 3; i < 6; ++i)
@@ -306,59 +383,53 @@ void TSR::getValue(
         || (angle + M_PI * 2 >= mBw(i, 0) && angle + M_PI * 2 <= mBw(i, 1))
         || (angle - M_PI * 2 >= mBw(i, 0) && angle - M_PI * 2 <= mBw(i, 1)))
     {
-      _out(i) = 0;
       continue;
     }
 
     // Take min-distance between angle and either side of bound
     if (angle < mBw(i, 0))
-      _out(i) = std::min(mBw(i, 0) - angle, angle - (mBw(i, 1) - 2 * M_PI));
-
+    {
+      const double below = mBw(i, 0) - angle;
+      const double above = angle - (mBw(i, 1) - 2 * M_PI);
+      _distances(i) = std::min(below, above);
+      slopes(i) = below <= above ? -1.0 : 1.0;
+    }
     else if (mBw(i, 1) < angle)
-      _out(i) = std::min(angle - mBw(i, 1), mBw(i, 0) + 2 * M_PI - angle);
+    {
+      const double above = angle - mBw(i, 1);
+      const double below = mBw(i, 0) + 2 * M_PI - angle;
+      _distances(i) = std::min(above, below);
+      slopes(i) = above <= below ? 1.0 : -1.0;
+    }
   }
-}
-
-//==============================================================================
-void TSR::getJacobian(
-    const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
-{
-  using SE3 = statespace::SE3;
-  using SE3State = SE3::State;
-
-  _out.resize(6, 6);
-
-  auto se3state = static_cast<const SE3State*>(_s);
-  Eigen::Isometry3d se3 = se3state->getIsometry();
-
-  Eigen::Vector6d twist = ::dart::math::logMap(se3);
-
-  Eigen::Vector6d posit(twist), negat(twist);
-
-  static constexpr double eps = 1e-5;
-
-  auto se3posit = mStateSpace->createState();
-  auto se3negat = mStateSpace->createState();
 
-  // Finite Differencing.
-  for (int i = 0; i < 6; ++i)
-  {
-    posit(i) = twist(i) + eps;
-    negat(i) = twist(i) - eps;
-
-    se3posit.setIsometry(::dart::math::expMap(posit));
-    se3negat.setIsometry(::dart::math::expMap(negat));
-
-    Eigen::VectorXd positValue, negatValue;
-    getValue(se3posit, positValue);
-    getValue(se3negat, negatValue);
-
-    Eigen::Vector6d diff = positValue - negatValue;
-    _out.col(i) = diff / (2 * eps);
-
-    posit(i) = twist(i);
-    negat(i) = twist(i);
-  }
+  if (!_jacobian)
+    return;
+
+  // The state is perturbed by a twist [w; v] in the origin frame, i.e. the
+  // rotation becomes exp(w) * R and the translation becomes p + v. Then Tw_s
+  // changes by the rotation exp(R0_w^T * w) and the translation
+  // R0_w^T * (v - [R * pe_w]x * w), where pe_w is the translation of Tw_e_inv.
+  const Eigen::Matrix3d R_w0 = T0_w_inv.linear();
+  const Eigen::Vector3d offset = T0_s.linear() * Tw_e_inv.translation();
+
+  // Maps an angular velocity in the w frame to the rates of the roll, pitch
+  // and yaw angles, where Tw_s = Rz(yaw) * Ry(pitch) * Rx(roll).
+  const double cosPitch = std::cos(eulerZYX(1));
+  const double tanPitch = std::tan(eulerZYX(1));
+  const double cosYaw = std::cos(eulerZYX(2));
+  const double sinYaw = std::sin(eulerZYX(2));
+  Eigen::Matrix3d eulerRates;
+  eulerRates << cosYaw / cosPitch, sinYaw / cosPitch, 0.0, -sinYaw, cosYaw,
+      0.0, cosYaw * tanPitch, sinYaw * tanPitch, 1.0;
+
+  _jacobian->topLeftCorner<3, 3>().noalias()
+      = -R_w0 * ::dart::math::makeSkewSymmetric(offset);
+  _jacobian->topRightCorner<3, 3>() = R_w0;
+  _jacobian->bottomLeftCorner<3, 3>().noalias() = eulerRates * R_w0;
+  _jacobian->bottomRightCorner<3, 3>().setZero();
+
+  *_jacobian = slopes.asDiagonal() * (*_jacobian);
 }
 
 //==============================================================================
@@ -394,12 +465,28 @@ TSRSampleGenerator::TSRSampleGenerator(
     throw std::invalid_argument("Random generator is empty.");
   }
 
+  mDistributions.reserve(6);
+  for (int i = 0; i < 6; i++)
+    mDistributions.emplace_back(mBw(i, 0), mBw(i, 1));
+
   if (mBw.col(0) == mBw.col(1))
     mPointTSR = true;
   else
     mPointTSR = false;
 
   mPointTSRSampled = false;
+
+  mFixedRotation
+      = mBw.bottomLeftCorner<3, 1>() == mBw.bottomRightCorner<3, 1>();
+  if (mFixedRotation)
+  {
+    const Eigen::Matrix3d R0_s
+        = mT0_w.linear()
+          * ::dart::math::eulerZYXToMatrix(
+              Eigen::Vector3d(mBw.bottomLeftCorner<3, 1>().reverse()));
+    mRotation = R0_s * mTw_e.linear();
+    mOffset = R0_s * mTw_e.translation() + mT0_w.translation();
+  }
 }
 
 //==============================================================================
@@ -408,46 +495,99 @@ statespace::ConstStateSpacePtr TSRSampleGenerator::getStateSpace() const
   return mStateSpace;
 }
 
+//==============================================================================
+void TSRSampleGenerator::drawSample(
+    Eigen::Ref<Eigen::Matrix<double, 6, 1>> _sample)
+{
+  if (mPointTSR)
+  {
+    _sample = mBw.col(0);
+    return;
+  }
+
+  for (int i = 0; i < 6; i++)
+    _sample(i) = mDistributions[i](*mRng);
+}
+
+//==============================================================================
+void TSRSampleGenerator::composeSample(
+    const Eigen::Vector3d& _rotatedTranslation,
+    const Eigen::Vector3d& _angles,
+    Eigen::Isometry3d& _T0_s) const
+{
+  if (mFixedRotation)
+  {
+    _T0_s.linear() = mRotation;
+    _T0_s.translation() = _rotatedTranslation + mOffset;
+    return;
+  }
+
+  const Eigen::Matrix3d R0_s
+      = mT0_w.linear() * ::dart::math::eulerZYXToMatrix(_angles.reverse());
+  _T0_s.linear() = R0_s * mTw_e.linear();
+  _T0_s.translation() = _rotatedTranslation + R0_s * mTw_e.translation()
+                        + mT0_w.translation();
+}
+
 //==============================================================================
 bool TSRSampleGenerator::sample(statespace::StateSpace::State* _state)
 {
   if (mPointTSR && mPointTSRSampled)
     return false;
 
-  using statespace::SE3;
+  Eigen::Matrix<double, 6, 1> Tw_s;
+  drawSample(Tw_s);
+
+  Eigen::Isometry3d T0_s(Eigen::Isometry3d::Identity());
+  composeSample(mT0_w.linear() * Tw_s.head<3>(), Tw_s.tail<3>(), T0_s);
+  mStateSpace->setIsometry(static_cast<SE3::State*>(_state), T0_s);
+
+  mPointTSRSampled = mPointTSR;
+
+  return true;
+}
 
-  Eigen::Vector3d translation;
-  Eigen::Vector3d angles;
+//==============================================================================
+std::size_t TSRSampleGenerator::sampleBatch(
+    std::size_t _numSamples,
+    const std::vector<statespace::StateSpace::State*>& _states)
+{
+  if (_states.size() < _numSamples)
+    throw std::invalid_argument("Not enough states for the requested samples.");
 
   if (mPointTSR)
   {
-    translation = mBw.block(0, 0, 3, 1);
-    angles = mBw.block(3, 0, 3, 1);
+    if (_numSamples == 0u || mPointTSRSampled)
+      return 0u;
 
-    mPointTSRSampled = true;
+    sample(_states[0]);
+    return 1u;
   }
-  else
-  {
-    std::vector<std::uniform_real_distribution<double> > distributions;
-    for (int i = 0; i < 6; i++)
-      distributions.emplace_back(mBw(i, 0), mBw(i, 1));
-
-    for (int i = 0; i < 3; i++)
-      translation(i) = distributions.at(i)(*mRng);
 
-    for (int i = 0; i < 3; i++)
-      angles(i) = distributions.at(i + 3)(*mRng);
+  const auto numSamples = static_cast<Eigen::Index>(_numSamples);
+  if (mBatchSamples.cols() < numSamples)
+  {
+    mBatchSamples.resize(Eigen::NoChange, numSamples);
+    mBatchTranslations.resize(Eigen::NoChange, numSamples);
   }
 
-  Eigen::Isometry3d Tw_s;
-  Tw_s.setIdentity();
-  Tw_s.translation() = translation;
-  Tw_s.linear() = ::dart::math::eulerZYXToMatrix(angles.reverse());
+  // Draw the samples in the same order as sample().
+  for (Eigen::Index i = 0; i < numSamples; ++i)
+    drawSample(mBatchSamples.col(i));
 
-  Eigen::Isometry3d T0_s(mT0_w * Tw_s * mTw_e);
-  mStateSpace->setIsometry(static_cast<SE3::State*>(_state), T0_s);
+  // Rotate the translations of all samples into the origin frame at once.
+  mBatchTranslations.leftCols(numSamples).noalias()
+      = mT0_w.linear() * mBatchSamples.topLeftCorner(3, numSamples);
 
-  return true;
+  Eigen::Isometry3d T0_s(Eigen::Isometry3d::Identity());
+  for (Eigen::Index i = 0; i < numSamples; ++i)
+  {
+    composeSample(
+        mBatchTranslations.col(i), mBatchSamples.col(i).tail<3>(), T0_s);
+    mStateSpace->setIsometry(static_cast<SE3::State*>(_states[i]), T0_s);
+  }
+
+  return _numSamples;
 }
 
 //==============================================================================
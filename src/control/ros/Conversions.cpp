@@ -1,5 +1,6 @@
 #include "aikido/control/ros/Conversions.hpp"
 
+#include <array>
 #include <sstream>
 #include <unordered_set>
 
@@ -95,17 +96,6 @@ void extractJointTrajectoryPoint(
     const std::vector<std::size_t>& unspecifiedJoints,
     const Eigen::VectorXd& startPositions);
 
-/// Extract a state on the trajectory given a timepoint.
-/// \param[in] space MetaSkeletonStateSpace of the trajectory.
-/// \param[in] trajectory Trajectory to extract point from.
-/// \param[in] timeFromStart Timepoint to extract trajectory point at.
-/// \param[out] waypoint The extracted trajectory point.
-void extractTrajectoryPoint(
-    const std::shared_ptr<const MetaSkeletonStateSpace>& space,
-    const aikido::trajectory::ConstTrajectoryPtr& trajectory,
-    double timeFromStart,
-    trajectory_msgs::JointTrajectoryPoint& waypoint);
-
 //==============================================================================
 void reorder(
     const std::vector<std::pair<std::size_t, std::size_t>>& indexMap,
@@ -253,42 +243,6 @@ void extractJointTrajectoryPoint(
   }
 }
 
-//==============================================================================
-void extractTrajectoryPoint(
-    const std::shared_ptr<const MetaSkeletonStateSpace>& space,
-    const aikido::trajectory::ConstTrajectoryPtr& trajectory,
-    double timeFromStart,
-    trajectory_msgs::JointTrajectoryPoint& waypoint)
-{
-  const auto numDerivatives = std::min<int>(trajectory->getNumDerivatives(), 1);
-  const auto timeAbsolute = trajectory->getStartTime() + timeFromStart;
-  const int numDof = space->getDimension();
-  DART_UNUSED(numDof);
-
-  Eigen::VectorXd tangentVector;
-  auto state = space->createState();
-  trajectory->evaluate(timeAbsolute, state);
-  space->logMap(state, tangentVector);
-
-  assert(tangentVector.size() == numDof);
-
-  waypoint.time_from_start = ::ros::Duration(timeFromStart);
-  waypoint.positions.assign(
-      tangentVector.data(), tangentVector.data() + tangentVector.size());
-
-  assert(0 <= numDerivatives && numDerivatives <= 2);
-  const std::array<std::vector<double>*, 2> derivatives{
-      &waypoint.velocities, &waypoint.accelerations};
-  for (int iDerivative = 1; iDerivative <= numDerivatives; ++iDerivative)
-  {
-    trajectory->evaluateDerivative(timeAbsolute, iDerivative, tangentVector);
-    assert(tangentVector.size() == numDof);
-
-    derivatives[iDerivative - 1]->assign(
-        tangentVector.data(), tangentVector.data() + tangentVector.size());
-  }
-}
-
 } // namespace
 
 //==============================================================================
@@ -601,13 +555,35 @@ trajectory_msgs::JointTrajectory toRosJointTrajectory(
     jointTrajectory.joint_names.emplace_back(jointDofName);
   }
 
-  // Evaluate trajectory at each timestep and insert it into jointTrajectory
+  // Evaluate trajectory at all timesteps at once
+  Eigen::VectorXd timesFromStart(numWaypoints);
+  for (std::size_t i = 0; i < numWaypoints; ++i)
+    timesFromStart[i] = timeSequence[i];
+
+  const Eigen::VectorXd times
+      = timesFromStart.array() + trajectory->getStartTime();
+  const auto numDerivatives = std::min<int>(trajectory->getNumDerivatives(), 1);
+
+  std::array<Eigen::MatrixXd, 2> values;
+  for (int iDerivative = 0; iDerivative <= numDerivatives; ++iDerivative)
+    trajectory->evaluateBatch(times, values[iDerivative], iDerivative);
+
+  // Insert the evaluated points into jointTrajectory
   jointTrajectory.points.reserve(numWaypoints);
-  for (const auto& timeFromStart : timeSequence)
+  for (std::size_t i = 0; i < numWaypoints; ++i)
   {
     trajectory_msgs::JointTrajectoryPoint waypoint;
+    waypoint.time_from_start = ::ros::Duration(timesFromStart[i]);
 
-    extractTrajectoryPoint(space, trajectory, timeFromStart, waypoint);
+    const std::array<std::vector<double>*, 2> vectors{&waypoint.positions,
+                                                      &waypoint.velocities};
+    for (int iDerivative = 0; iDerivative <= numDerivatives; ++iDerivative)
+    {
+      auto& vector = *vectors[iDerivative];
+      vector.resize(values[iDerivative].cols());
+      Eigen::Map<Eigen::RowVectorXd>(vector.data(), vector.size())
+          = values[iDerivative].row(i);
+    }
 
     jointTrajectory.points.emplace_back(waypoint);
   }
@@ -84,5 +84,12 @@ void ConfigurationRanker::rankConfigurations(
       });
 }
 
+//==============================================================================
+double ConfigurationRanker::getCost(
+    const MetaSkeletonStateSpace::State* configuration) const
+{
+  return evaluateConfiguration(configuration);
+}
+
 } // namespace distance
 } // namespace aikido
@@ -581,6 +581,15 @@ bool RampFeasibilityChecker::Check(const ParabolicRampND& x)
 
 
 bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
+{
+  DynamicPathShortcut shortcut;
+  if(!PlanShortcut(t1,t2,shortcut)) return false;
+  if(!CheckShortcut(shortcut,check)) return false;
+  ApplyShortcut(shortcut);
+  return true;
+}
+
+bool DynamicPath::PlanShortcut(Real t1,Real t2,DynamicPathShortcut& shortcut) const
 {
   if(t1 > t2) Swap(t1,t2);
   Real u1,u2;
@@ -623,17 +632,40 @@ bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
     intermediate.velMax = velMax;
     PARABOLIC_RAMP_ASSERT(intermediate.IsValid());
   }
-  for(std::size_t i=0;i<intermediate.ramps.size();i++)
-    if(!check.Check(intermediate.ramps[i])) return false;
+
+  shortcut.i1 = i1;
+  shortcut.i2 = i2;
+  shortcut.u1 = u1;
+  shortcut.u2 = u2;
+  shortcut.delete_i1 = delete_i1;
+  shortcut.delete_i2 = delete_i2;
+  shortcut.ramps.swap(intermediate.ramps);
+  return true;
+}
+
+bool DynamicPath::CheckShortcut(const DynamicPathShortcut& shortcut,RampFeasibilityChecker& check) const
+{
+  for(std::size_t i=0;i<shortcut.ramps.size();i++)
+    if(!check.Check(shortcut.ramps[i])) return false;
+  return true;
+}
+
+void DynamicPath::ApplyShortcut(const DynamicPathShortcut& shortcut)
+{
+  const int i1 = shortcut.i1;
+  const int i2 = shortcut.i2;
+  const Real u1 = shortcut.u1;
+  const Real u2 = shortcut.u2;
+  const vector<ParabolicRampND>& intermediate = shortcut.ramps;
 
   //perform shortcut
   //crop i1 and i2
   ramps[i1].TrimBack(ramps[i1].endTime-u1);
-  ramps[i1].x1 = intermediate.ramps.front().x0;
-  ramps[i1].dx1 = intermediate.ramps.front().dx0;
+  ramps[i1].x1 = intermediate.front().x0;
+  ramps[i1].dx1 = intermediate.front().dx0;
   ramps[i2].TrimFront(u2);
-  ramps[i2].x0 = intermediate.ramps.back().x1;
-  ramps[i2].dx0 = intermediate.ramps.back().dx1;
+  ramps[i2].x0 = intermediate.back().x1;
+  ramps[i2].dx0 = intermediate.back().dx1;
 
   // The end of ramp i1 is a new waypoint which is part of the shortcutted
   // trajectory. We don't need to blend this in future iterations.
@@ -641,18 +673,18 @@ bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
 
   // Remove the last waypoint. We do this before we change the length of the
   // trajectory with the shortcut, so i2 is still a valid index.
-  if(delete_i2){
+  if(shortcut.delete_i2){
     ramps.erase(ramps.begin()+i2);
   }
   
   //replace intermediate ramps with test
   for(int i=0;i<i2-i1-1;i++)
     ramps.erase(ramps.begin()+i1+1);
-  ramps.insert(ramps.begin()+i1+1,intermediate.ramps.begin(),intermediate.ramps.end());
+  ramps.insert(ramps.begin()+i1+1,intermediate.begin(),intermediate.end());
 
   // Remove the first waypoint. We do this after we change the length of the
   // trajectory so we don't affect where the shortcut is inserted.
-  if(delete_i1) {
+  if(shortcut.delete_i1) {
     ramps.erase(ramps.begin()+i1);
   }
   
@@ -661,7 +693,6 @@ bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
     PARABOLIC_RAMP_ASSERT(ramps[i].x1 == ramps[i+1].x0);
     PARABOLIC_RAMP_ASSERT(ramps[i].dx1 == ramps[i+1].dx0);
   }
-  return true;
 }
 
 int DynamicPath::Shortcut(int numIters,RampFeasibilityChecker& check)
@@ -101,6 +101,26 @@ class RandomNumberGeneratorBase
 };
 
 
+/** @brief A shortcut between two times of a DynamicPath.
+ *
+ * Computed by DynamicPath::PlanShortcut and applied by
+ * DynamicPath::ApplyShortcut.  Planning does not modify the path, so several
+ * shortcuts can be planned and checked concurrently before any of them is
+ * applied.
+ */
+struct DynamicPathShortcut
+{
+  /// Indices of the ramps containing the start and the end of the shortcut
+  int i1,i2;
+  /// Times of the start and the end of the shortcut in ramps i1 and i2
+  Real u1,u2;
+  /// Whether ramps i1 and i2 are removed when the shortcut is applied
+  bool delete_i1,delete_i2;
+  /// Ramps that replace the path between the start and the end
+  std::vector<ParabolicRampND> ramps;
+};
+
+
 /** @brief A bounded-velocity, bounded-acceleration trajectory consisting
  * of parabolic ramps.
  *
@@ -130,6 +150,15 @@ class DynamicPath
   void Concat(const DynamicPath& suffix);
   void Split(Real t,DynamicPath& before,DynamicPath& after) const;
   bool TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check);
+  /// Computes the shortcut between times t1 and t2 without checking it.
+  /// Returns false if t1 and t2 are in the same ramp or no ramp connects them.
+  bool PlanShortcut(Real t1,Real t2,DynamicPathShortcut& shortcut) const;
+  /// Checks the ramps of a shortcut for feasibility
+  bool CheckShortcut(const DynamicPathShortcut& shortcut,RampFeasibilityChecker& check) const;
+  /// Replaces the path between the ends of a planned shortcut by its ramps.
+  /// The path must not have changed since the shortcut was planned, except
+  /// for shortcuts applied to ramps after shortcut.i2.
+  void ApplyShortcut(const DynamicPathShortcut& shortcut);
   int Shortcut(int numIters,RampFeasibilityChecker& check);
   int Shortcut(int numIters,RampFeasibilityChecker& check,RandomNumberGeneratorBase* rng);
   int ShortCircuit(RampFeasibilityChecker& check);
@@ -175,18 +175,26 @@ private:
 Path::Path(const list<VectorXd> &path, double maxDeviation) :
 	length(0.0)
 {
+	initialize(vector<VectorXd>(path.begin(), path.end()), maxDeviation);
+}
+
+Path::Path(const vector<VectorXd> &path, double maxDeviation) :
+	length(0.0)
+{
+	initialize(path, maxDeviation);
+}
+
+void Path::initialize(const vector<VectorXd> &path, double maxDeviation) {
 	if(path.size() < 2)
 		return;
-	list<VectorXd>::const_iterator config1 = path.begin();
-	list<VectorXd>::const_iterator config2 = config1;
-	config2++;
-	list<VectorXd>::const_iterator config3;
-	VectorXd startConfig = *config1;
-	while(config2 != path.end()) {
-		config3 = config2;
-		config3++;
-		if(maxDeviation > 0.0 && config3 != path.end()) {
-			CircularPathSegment* blendSegment = new CircularPathSegment(0.5 * (*config1 + *config2), *config2, 0.5 * (*config2 + *config3), maxDeviation);
+	pathSegments.reserve(2 * path.size());
+	VectorXd startConfig = path[0];
+	for(size_t i = 1; i < path.size(); i++) {
+		const VectorXd &config1 = path[i - 1];
+		const VectorXd &config2 = path[i];
+		if(maxDeviation > 0.0 && i + 1 < path.size()) {
+			const VectorXd &config3 = path[i + 1];
+			CircularPathSegment* blendSegment = new CircularPathSegment(0.5 * (config1 + config2), config2, 0.5 * (config2 + config3), maxDeviation);
 			VectorXd endConfig = blendSegment->getConfig(0.0);
 			if((endConfig - startConfig).norm() > 0.000001) {
 				pathSegments.push_back(new LinearPathSegment(startConfig, endConfig));
@@ -196,16 +204,16 @@ Path::Path(const list<VectorXd> &path, double maxDeviation) :
 			startConfig = blendSegment->getConfig(blendSegment->getLength());
 		}
 		else {
-			pathSegments.push_back(new LinearPathSegment(startConfig, *config2));
-			startConfig = *config2;
+			pathSegments.push_back(new LinearPathSegment(startConfig, config2));
+			startConfig = config2;
 		}
-		config1 = config2;
-		config2++;
 	}
 
 	// create list of switching point candidates, calculate total path length and absolute positions of path segments
-	for(list<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); segment++) {
+	segmentPositions.reserve(pathSegments.size());
+	for(vector<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); segment++) {
 		(*segment)->position = length;
+		segmentPositions.push_back(length);
 		list<double> localSwitchingPoints = (*segment)->getSwitchingPoints();
 		for(list<double>::const_iterator point = localSwitchingPoints.begin(); point != localSwitchingPoints.end(); point++) {
 			switchingPoints.push_back(make_pair(length + *point, false));
@@ -220,15 +228,17 @@ Path::Path(const list<VectorXd> &path, double maxDeviation) :
 
 Path::Path(const Path &path) :
 	length(path.length),
-	switchingPoints(path.switchingPoints)
+	switchingPoints(path.switchingPoints),
+	segmentPositions(path.segmentPositions)
 {
-	for(list<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); it++) {
+	pathSegments.reserve(path.pathSegments.size());
+	for(vector<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); it++) {
 		pathSegments.push_back((*it)->clone());
 	}
 }
 
 Path::~Path() {
-	for(list<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); it++) {
+	for(vector<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); it++) {
 		delete *it;
 	}
 }
@@ -237,16 +247,12 @@ double Path::getLength() const {
 	return length;
 }
 
-PathSegment* Path::getPathSegment(double &s) const {
-	list<PathSegment*>::const_iterator it = pathSegments.begin();
-	list<PathSegment*>::const_iterator next = it;
-	next++;
-	while(next != pathSegments.end() && s >= (*next)->position) {
-		it = next;
-		next++;
-	}
-	s -= (*it)->position;
-	return *it;
+const PathSegment* Path::getPathSegment(double &s) const {
+	// last segment whose position is at most s, or the first segment
+	vector<double>::const_iterator next = upper_bound(segmentPositions.begin() + 1, segmentPositions.end(), s);
+	const size_t index = (next - segmentPositions.begin()) - 1;
+	s -= segmentPositions[index];
+	return pathSegments[index];
 }
 
 VectorXd Path::getConfig(double s) const {
@@ -264,11 +270,13 @@ VectorXd Path::getCurvature(double s) const {
 	return pathSegment->getCurvature(s);
 }
 
+static bool isBeforeSwitchingPoint(double s, const pair<double, bool> &switchingPoint) {
+	return s < switchingPoint.first;
+}
+
 double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
-	list<pair<double, bool> >::const_iterator it = switchingPoints.begin();
-	while(it != switchingPoints.end() && it->first <= s) {
-		it++;
-	}
+	// first switching point after s
+	vector<pair<double, bool> >::const_iterator it = upper_bound(switchingPoints.begin(), switchingPoints.end(), s, isBeforeSwitchingPoint);
 	if(it == switchingPoints.end()) {
 		discontinuity = true;
 		return length;
@@ -279,6 +287,6 @@ double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
 	}
 }
 
-list<pair<double, bool> > Path::getSwitchingPoints() const {
+const vector<pair<double, bool> > &Path::getSwitchingPoints() const {
 	return switchingPoints;
 }
\ No newline at end of file
@@ -39,6 +39,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 #include <Eigen/Core>
 
 class PathSegment
@@ -71,6 +72,7 @@ class Path
 {
 public:
 	Path(const std::list<Eigen::VectorXd> &path, double maxDeviation = 0.0);
+	Path(const std::vector<Eigen::VectorXd> &path, double maxDeviation = 0.0);
 	Path(const Path &path);
 	~Path();
 	double getLength() const;
@@ -78,10 +80,15 @@ public:
 	Eigen::VectorXd getTangent(double s) const;
 	Eigen::VectorXd getCurvature(double s) const;
 	double getNextSwitchingPoint(double s, bool &discontinuity) const;
-	std::list<std::pair<double, bool> > getSwitchingPoints() const;
+	const std::vector<std::pair<double, bool> > &getSwitchingPoints() const;
 private:
-	PathSegment* getPathSegment(double &s) const;
+	void initialize(const std::vector<Eigen::VectorXd> &path, double maxDeviation);
+	// Finds the segment containing s by binary search and makes s relative to it.
+	const PathSegment* getPathSegment(double &s) const;
 	double length;
-	std::list<std::pair<double, bool> > switchingPoints;
-	std::list<PathSegment*> pathSegments;
+	// Sorted by position.
+	std::vector<std::pair<double, bool> > switchingPoints;
+	std::vector<PathSegment*> pathSegments;
+	// Position of each path segment, in increasing order.
+	std::vector<double> segmentPositions;
 };
\ No newline at end of file
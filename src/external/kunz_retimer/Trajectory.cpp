@@ -37,6 +37,7 @@
  */
 
 #include "Trajectory.h"
+#include <algorithm>
 #include <limits>
 #include <iostream>
 #include <fstream>
@@ -56,8 +57,7 @@ Trajectory::Trajectory(const Path &path, const VectorXd &maxVelocity, const Vect
 	maxAcceleration(maxAcceleration),
 	n(maxVelocity.size()),
 	valid(true),
-	timeStep(timeStep),
-	cachedTime(numeric_limits<double>::max())
+	timeStep(timeStep)
 {
 	trajectory.push_back(TrajectoryStep(0.0, 0.0));
 	double afterAcceleration = getMinMaxPathAcceleration(0.0, 0.0, true);
@@ -77,14 +77,11 @@ Trajectory::Trajectory(const Path &path, const VectorXd &maxVelocity, const Vect
 
 	if(valid) {
 		// calculate timing
-		list<TrajectoryStep>::iterator previous = trajectory.begin();
-		list<TrajectoryStep>::iterator it = previous;
-		it->time = 0.0;
-		it++;
-		while(it != trajectory.end()) {
-			it->time = previous->time + (it->pathPos - previous->pathPos) / ((it->pathVel + previous->pathVel) / 2.0);
-			previous = it;
-			it++;
+		trajectory[0].time = 0.0;
+		for(size_t i = 1; i < trajectory.size(); i++) {
+			const TrajectoryStep &previous = trajectory[i - 1];
+			TrajectoryStep &step = trajectory[i];
+			step.time = previous.time + (step.pathPos - previous.pathPos) / ((step.pathVel + previous.pathVel) / 2.0);
 		}
 	}
 }
@@ -104,10 +101,10 @@ void Trajectory::outputPhasePlaneTrajectory() const {
 	file1.close();
 
 	ofstream file2("trajectory.txt");
-	for(list<TrajectoryStep>::const_iterator it = trajectory.begin(); it != trajectory.end(); it++) {
+	for(vector<TrajectoryStep>::const_iterator it = trajectory.begin(); it != trajectory.end(); it++) {
 		file2 << it->pathPos << "  " << it->pathVel << endl;
 	}
-	for(list<TrajectoryStep>::const_iterator it = endTrajectory.begin(); it != endTrajectory.end(); it++) {
+	for(vector<TrajectoryStep>::const_iterator it = endTrajectory.begin(); it != endTrajectory.end(); it++) {
 		file2 << it->pathPos << "  " << it->pathVel << endl;
 	}
 	file2.close();
@@ -228,14 +225,18 @@ bool Trajectory::getNextVelocitySwitchingPoint(double pathPos, TrajectoryStep &n
 	return false;
 }
 
+static bool isBeforeSwitchingPoint(double pathPos, const pair<double, bool> &switchingPoint) {
+	return pathPos < switchingPoint.first;
+}
+
 // returns true if end of path is reached
-bool Trajectory::integrateForward(list<TrajectoryStep> &trajectory, double acceleration) {
+bool Trajectory::integrateForward(vector<TrajectoryStep> &trajectory, double acceleration) {
 	
 	double pathPos = trajectory.back().pathPos;
 	double pathVel = trajectory.back().pathVel;
 	
-	list<pair<double, bool> > switchingPoints = path.getSwitchingPoints();
-	list<pair<double, bool> >::iterator nextDiscontinuity = switchingPoints.begin();
+	const vector<pair<double, bool> > &switchingPoints = path.getSwitchingPoints();
+	vector<pair<double, bool> >::const_iterator nextDiscontinuity = upper_bound(switchingPoints.begin(), switchingPoints.end(), pathPos, isBeforeSwitchingPoint);
 
 	while(true)
 	{
@@ -303,7 +304,7 @@ bool Trajectory::integrateForward(list<TrajectoryStep> &trajectory, double accel
 			trajectory.push_back(TrajectoryStep(before, beforePathVel));
 		
 			if(getAccelerationMaxPathVelocity(after) < getVelocityMaxPathVelocity(after)) {
-				if(after > nextDiscontinuity->first) {
+				if(nextDiscontinuity != switchingPoints.end() && after > nextDiscontinuity->first) {
 					return false;
 				}
 				else if(getMinMaxPhaseSlope(trajectory.back().pathPos, trajectory.back().pathVel, true) > getAccelerationMaxPathVelocityDeriv(trajectory.back().pathPos)) {
@@ -319,28 +320,27 @@ bool Trajectory::integrateForward(list<TrajectoryStep> &trajectory, double accel
 	}
 }
 
-void Trajectory::integrateBackward(list<TrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration) {
-	list<TrajectoryStep>::iterator start2 = startTrajectory.end();
-	start2--;
-	list<TrajectoryStep>::iterator start1 = start2;
-	start1--;
-	list<TrajectoryStep> trajectory;
+void Trajectory::integrateBackward(vector<TrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration) {
+	size_t start2 = startTrajectory.size() - 1;
+	size_t start1 = start2 - 1;
+	// backward trajectory in reverse order, i.e. trajectory.back() is its first step
+	vector<TrajectoryStep> trajectory;
 	double slope;
-	assert(start1->pathPos <= pathPos);
+	assert(startTrajectory[start1].pathPos <= pathPos);
 
-	while(start1 != startTrajectory.begin() || pathPos >= 0.0)
+	while(start1 != 0 || pathPos >= 0.0)
 	{
-		if(start1->pathPos <= pathPos) {
-			trajectory.push_front(TrajectoryStep(pathPos, pathVel));
+		if(startTrajectory[start1].pathPos <= pathPos) {
+			trajectory.push_back(TrajectoryStep(pathPos, pathVel));
 			pathVel -= timeStep * acceleration;
-			pathPos -= timeStep * 0.5 * (pathVel + trajectory.front().pathVel);
+			pathPos -= timeStep * 0.5 * (pathVel + trajectory.back().pathVel);
 			acceleration = getMinMaxPathAcceleration(pathPos, pathVel, false);
-			slope = (trajectory.front().pathVel - pathVel) / (trajectory.front().pathPos - pathPos);
+			slope = (trajectory.back().pathVel - pathVel) / (trajectory.back().pathPos - pathPos);
 			
 			if(pathVel < 0.0) {
 				valid = false;
 				cout << "Error while integrating backward: Negative path velocity" << endl;
-				endTrajectory = trajectory;
+				endTrajectory.assign(trajectory.rbegin(), trajectory.rend());
 				return;
 			}
 		}
@@ -350,20 +350,23 @@ void Trajectory::integrateBackward(list<TrajectoryStep> &startTrajectory, double
 		}
 
 		// check for intersection between current start trajectory and backward trajectory segments
-		const double startSlope = (start2->pathVel - start1->pathVel) / (start2->pathPos - start1->pathPos);
-		const double intersectionPathPos = (start1->pathVel - pathVel + slope * pathPos - startSlope * start1->pathPos) / (slope - startSlope);
-		if(max(start1->pathPos, pathPos) - eps <= intersectionPathPos && intersectionPathPos <= eps + min(start2->pathPos, trajectory.front().pathPos)) {
-			const double intersectionPathVel = start1->pathVel + startSlope * (intersectionPathPos - start1->pathPos);
-			startTrajectory.erase(start2, startTrajectory.end());
+		const TrajectoryStep &step1 = startTrajectory[start1];
+		const TrajectoryStep &step2 = startTrajectory[start2];
+		const double startSlope = (step2.pathVel - step1.pathVel) / (step2.pathPos - step1.pathPos);
+		const double intersectionPathPos = (step1.pathVel - pathVel + slope * pathPos - startSlope * step1.pathPos) / (slope - startSlope);
+		if(max(step1.pathPos, pathPos) - eps <= intersectionPathPos && intersectionPathPos <= eps + min(step2.pathPos, trajectory.back().pathPos)) {
+			const double intersectionPathVel = step1.pathVel + startSlope * (intersectionPathPos - step1.pathPos);
+			startTrajectory.resize(start2);
+			startTrajectory.reserve(start2 + 1 + trajectory.size());
 			startTrajectory.push_back(TrajectoryStep(intersectionPathPos, intersectionPathVel));
-			startTrajectory.splice(startTrajectory.end(), trajectory);
+			startTrajectory.insert(startTrajectory.end(), trajectory.rbegin(), trajectory.rend());
 			return;
 		}
 	}
 
 	valid = false;
 	cout << "Error while integrating backward: Did not hit start trajectory" << endl;
-	endTrajectory = trajectory;
+	endTrajectory.assign(trajectory.rbegin(), trajectory.rend());
 }
 
 double Trajectory::getMinMaxPathAcceleration(double pathPos, double pathVel, bool max) {
@@ -445,49 +448,73 @@ double Trajectory::getDuration() const {
 	return trajectory.back().time;
 }
 
-list<Trajectory::TrajectoryStep>::const_iterator Trajectory::getTrajectorySegment(double time) const {
+vector<double> Trajectory::getStepTimes() const {
+	const vector<pair<double, bool> > &switchingPoints = path.getSwitchingPoints();
+	vector<double> times;
+	times.reserve(trajectory.size() + switchingPoints.size());
+	times.push_back(trajectory[0].time);
+	vector<pair<double, bool> >::const_iterator switchingPoint = switchingPoints.begin();
+	for(size_t i = 1; i < trajectory.size(); i++) {
+		const TrajectoryStep &previous = trajectory[i - 1];
+		const TrajectoryStep &step = trajectory[i];
+		const double timeStep = step.time - previous.time;
+		const double acceleration = 2.0 * (step.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
+
+		// Solve pathPos(time) = switchingPoint for the time within the step.
+		for(; switchingPoint != switchingPoints.end() && switchingPoint->first < step.pathPos; switchingPoint++) {
+			const double distance = switchingPoint->first - previous.pathPos;
+			if(distance <= 0.0) {
+				continue;
+			}
+			const double root = sqrt(max(squared(previous.pathVel) + 2.0 * acceleration * distance, 0.0));
+			if(previous.pathVel + root > 0.0) {
+				times.push_back(previous.time + min(2.0 * distance / (previous.pathVel + root), timeStep));
+			}
+		}
+		times.push_back(step.time);
+	}
+	return times;
+}
+
+bool Trajectory::isBeforeStep(double time, const TrajectoryStep &step) {
+	return time < step.time;
+}
+
+size_t Trajectory::getTrajectorySegment(double time) const {
 	if(time >= trajectory.back().time) {
-		list<TrajectoryStep>::const_iterator last = trajectory.end();
-		last--;
-		return last;
+		return trajectory.size() - 1;
 	}
 	else {
-		if(time < cachedTime) {
-			cachedTrajectorySegment = trajectory.begin();
-		}
-		while(time >= cachedTrajectorySegment->time) {
-			cachedTrajectorySegment++;
-		}
-		cachedTime = time;
-		return cachedTrajectorySegment;
+		const size_t index = upper_bound(trajectory.begin(), trajectory.end(), time, isBeforeStep) - trajectory.begin();
+		return max<size_t>(index, 1);
 	}
 }
 
 VectorXd Trajectory::getPosition(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-	previous--;
+	const size_t index = getTrajectorySegment(time);
+	const TrajectoryStep &step = trajectory[index];
+	const TrajectoryStep &previous = trajectory[index - 1];
 	
-	double timeStep = it->time - previous->time;
-	const double acceleration = 2.0 * (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+	double timeStep = step.time - previous.time;
+	const double acceleration = 2.0 * (step.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
 
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + 0.5 * timeStep * timeStep * acceleration; 
+	timeStep = time - previous.time;
+	const double pathPos = previous.pathPos + timeStep * previous.pathVel + 0.5 * timeStep * timeStep * acceleration; 
 	
 	return path.getConfig(pathPos);
 }
 
 VectorXd Trajectory::getVelocity(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-	previous--;
+	const size_t index = getTrajectorySegment(time);
+	const TrajectoryStep &step = trajectory[index];
+	const TrajectoryStep &previous = trajectory[index - 1];
 		
-	double timeStep = it->time - previous->time;
-	const double acceleration = 2.0 * (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+	double timeStep = step.time - previous.time;
+	const double acceleration = 2.0 * (step.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
 
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + 0.5 * timeStep * timeStep * acceleration; 
-	const double pathVel = previous->pathVel + timeStep * acceleration;
+	timeStep = time - previous.time;
+	const double pathPos = previous.pathPos + timeStep * previous.pathVel + 0.5 * timeStep * timeStep * acceleration; 
+	const double pathVel = previous.pathVel + timeStep * acceleration;
 	
 	return path.getTangent(pathPos) * pathVel;
 }
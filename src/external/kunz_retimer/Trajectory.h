@@ -38,6 +38,7 @@
 
 #pragma once
 
+#include <vector>
 #include <Eigen/Core>
 #include "Path.h"
 
@@ -56,6 +57,11 @@ public:
 	// Returns the optimal duration of the trajectory
 	double getDuration() const;
 
+	// Returns the times of the integration steps, which include the switching points of the
+	// phase plane trajectory, merged with the times at which the switching points of the path
+	// are reached. In between, the path acceleration is constant and the path is smooth.
+	std::vector<double> getStepTimes() const;
+
 	// Return the position/configuration or velocity vector of the robot for a given point in time within the trajectory.
 	Eigen::VectorXd getPosition(double time) const;
 	Eigen::VectorXd getVelocity(double time) const;
@@ -78,8 +84,8 @@ private:
 	bool getNextSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextAccelerationSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextVelocitySwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
-	bool integrateForward(std::list<TrajectoryStep> &trajectory, double acceleration);
-	void integrateBackward(std::list<TrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration);
+	bool integrateForward(std::vector<TrajectoryStep> &trajectory, double acceleration);
+	void integrateBackward(std::vector<TrajectoryStep> &startTrajectory, double pathPos, double pathVel, double acceleration);
 	double getMinMaxPathAcceleration(double pathPosition, double pathVelocity, bool max);
 	double getMinMaxPhaseSlope(double pathPosition, double pathVelocity, bool max);
 	double getAccelerationMaxPathVelocity(double pathPos) const;
@@ -87,19 +93,18 @@ private:
 	double getAccelerationMaxPathVelocityDeriv(double pathPos);
 	double getVelocityMaxPathVelocityDeriv(double pathPos);
 	
-	std::list<TrajectoryStep>::const_iterator getTrajectorySegment(double time) const;
+	// Returns the index of the first step after the given time, found by binary search.
+	size_t getTrajectorySegment(double time) const;
+	static bool isBeforeStep(double time, const TrajectoryStep &step);
 	
 	Path path;
 	Eigen::VectorXd maxVelocity;
 	Eigen::VectorXd maxAcceleration;
 	unsigned int n;
 	bool valid;
-	std::list<TrajectoryStep> trajectory;
-	std::list<TrajectoryStep> endTrajectory; // non-empty only if the trajectory generation failed.
+	std::vector<TrajectoryStep> trajectory;
+	std::vector<TrajectoryStep> endTrajectory; // non-empty only if the trajectory generation failed.
 
 	static const double eps;
 	const double timeStep;
-
-	mutable double cachedTime;
-	mutable std::list<TrajectoryStep>::const_iterator cachedTrajectorySegment;
 };
\ No newline at end of file
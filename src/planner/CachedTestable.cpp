@@ -0,0 +1,347 @@
+#include "aikido/planner/CachedTestable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <dart/dynamics/DegreeOfFreedom.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+
+namespace aikido {
+namespace planner {
+
+//==============================================================================
+CachedTestable::CachedTestable(
+    constraint::ConstTestablePtr testable,
+    double resolution,
+    std::size_t capacity,
+    ConstWorldPtr world,
+    ::dart::dynamics::ConstMetaSkeletonPtr metaSkeleton)
+  : mTestable(std::move(testable))
+  , mResolution(resolution)
+  , mCapacity(capacity)
+  , mWorld(std::move(world))
+  , mMetaSkeleton(std::move(metaSkeleton))
+  , mNumWorldSkeletons(0u)
+  , mNumHits(0u)
+  , mNumMisses(0u)
+{
+  if (!mTestable)
+    throw std::invalid_argument("Testable is nullptr.");
+
+  if (mResolution <= 0.0)
+    throw std::invalid_argument("Resolution must be positive.");
+
+  if (mCapacity == 0u)
+    throw std::invalid_argument("Capacity must be positive.");
+
+  mStateSpace = mTestable->getStateSpace();
+}
+
+//==============================================================================
+bool CachedTestable::isSatisfied(
+    const statespace::StateSpace::State* state,
+    constraint::TestableOutcome* outcome) const
+{
+  auto key = computeKey(state);
+
+  if (!outcome)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    checkWorld();
+
+    bool satisfied;
+    if (find(key, satisfied))
+    {
+      ++mNumHits;
+      return satisfied;
+    }
+  }
+
+  const bool satisfied = mTestable->isSatisfied(state, outcome);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  ++mNumMisses;
+  insert(std::move(key), satisfied);
+
+  return satisfied;
+}
+
+//==============================================================================
+std::vector<bool> CachedTestable::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::size_t* firstFailure) const
+{
+  std::vector<bool> satisfied(states.size(), true);
+  std::vector<Key> keys;
+  keys.reserve(states.size());
+  for (const auto state : states)
+    keys.emplace_back(computeKey(state));
+
+  // Indices of the states that are not in the cache.
+  std::vector<std::size_t> missIndices;
+  std::vector<const statespace::StateSpace::State*> missStates;
+  std::size_t firstCachedFailure = states.size();
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    checkWorld();
+
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+      bool result;
+      if (find(keys[i], result))
+      {
+        ++mNumHits;
+        satisfied[i] = result;
+
+        if (!result && firstCachedFailure == states.size())
+          firstCachedFailure = i;
+      }
+      else
+      {
+        missIndices.emplace_back(i);
+        missStates.emplace_back(states[i]);
+      }
+    }
+  }
+
+  std::size_t missFirstFailure = missStates.size();
+  std::vector<bool> missSatisfied;
+  if (!missStates.empty())
+  {
+    missSatisfied = mTestable->isSatisfiedBatch(
+        missStates, firstFailure ? &missFirstFailure : nullptr);
+  }
+
+  // Entries past missFirstFailure are unspecified and are not cached.
+  const auto numValid = std::min(missFirstFailure + 1, missStates.size());
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (std::size_t j = 0; j < numValid; ++j)
+    {
+      const auto i = missIndices[j];
+      satisfied[i] = missSatisfied[j];
+
+      ++mNumMisses;
+      insert(std::move(keys[i]), satisfied[i]);
+    }
+  }
+
+  if (firstFailure)
+  {
+    *firstFailure = firstCachedFailure;
+    if (missFirstFailure < missStates.size())
+    {
+      *firstFailure = std::min(*firstFailure, missIndices[missFirstFailure]);
+    }
+  }
+
+  return satisfied;
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr CachedTestable::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::unique_ptr<constraint::TestableOutcome> CachedTestable::createOutcome()
+    const
+{
+  return mTestable->createOutcome();
+}
+
+//==============================================================================
+constraint::ConstTestablePtr CachedTestable::getTestable() const
+{
+  return mTestable;
+}
+
+//==============================================================================
+std::size_t CachedTestable::getNumHits() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumHits;
+}
+
+//==============================================================================
+std::size_t CachedTestable::getNumMisses() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumMisses;
+}
+
+//==============================================================================
+std::size_t CachedTestable::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+//==============================================================================
+void CachedTestable::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+  mIndex.clear();
+}
+
+//==============================================================================
+void CachedTestable::resetCounters()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mNumHits = 0u;
+  mNumMisses = 0u;
+}
+
+//==============================================================================
+auto CachedTestable::computeKey(const statespace::StateSpace::State* state)
+    const -> Key
+{
+  Eigen::VectorXd tangent;
+  mStateSpace->logMap(state, tangent);
+
+  Key key(tangent.size());
+  for (int i = 0; i < tangent.size(); ++i)
+    key[i] = static_cast<std::int64_t>(std::floor(tangent[i] / mResolution));
+
+  return key;
+}
+
+//==============================================================================
+void CachedTestable::checkWorld() const
+{
+  if (!mWorld)
+    return;
+
+  bool changed = mWorld->getNumSkeletons() != mNumWorldSkeletons;
+
+  for (std::size_t k = 0; !changed && k < mVersionedSkeletons.size(); ++k)
+  {
+    const auto version = mWorld->getSkeletonVersion(mVersionedSkeletons[k]);
+    if (version != mSkeletonVersions[k])
+    {
+      mSkeletonVersions[k] = version;
+      changed = true;
+    }
+  }
+
+  for (std::size_t k = 0; !changed && k < mWatchedSkeletons.size(); ++k)
+  {
+    auto& watched = mWatchedSkeletons[k];
+    const auto skeleton = mWorld->getConstSkeleton(watched.mIndex);
+    if (!skeleton || skeleton->getName() != watched.mName)
+    {
+      // Another Skeleton took the index of a removed one.
+      changed = true;
+      break;
+    }
+
+    for (std::size_t i = 0; i < watched.mDofs.size(); ++i)
+    {
+      const auto position = skeleton->getPosition(watched.mDofs[i]);
+      if (position != watched.mPositions[i])
+      {
+        watched.mPositions[i] = position;
+        changed = true;
+      }
+    }
+  }
+
+  if (changed)
+  {
+    watchWorld();
+    mEntries.clear();
+    mIndex.clear();
+  }
+}
+
+//==============================================================================
+void CachedTestable::watchWorld() const
+{
+  std::unordered_set<const ::dart::dynamics::DegreeOfFreedom*> ignoredDofs;
+  if (mMetaSkeleton)
+  {
+    for (std::size_t i = 0; i < mMetaSkeleton->getNumDofs(); ++i)
+      ignoredDofs.insert(mMetaSkeleton->getDof(i));
+  }
+
+  mNumWorldSkeletons = mWorld->getNumSkeletons();
+  mVersionedSkeletons.clear();
+  mSkeletonVersions.clear();
+  mWatchedSkeletons.clear();
+  for (std::size_t i = 0; i < mNumWorldSkeletons; ++i)
+  {
+    const auto skeleton = mWorld->getConstSkeleton(i);
+    if (!skeleton)
+    {
+      // The Skeleton was removed concurrently; watch it again next time.
+      mNumWorldSkeletons = 0u;
+      continue;
+    }
+
+    WatchedSkeleton watched;
+    watched.mIndex = i;
+    watched.mName = skeleton->getName();
+
+    const auto numDofs = skeleton->getNumDofs();
+    for (std::size_t j = 0; j < numDofs; ++j)
+    {
+      if (ignoredDofs.count(skeleton->getDof(j)))
+        continue;
+
+      watched.mDofs.emplace_back(j);
+      watched.mPositions.emplace_back(skeleton->getPosition(j));
+    }
+
+    // Skeletons without planned DOFs are watched through their version.
+    if (watched.mDofs.size() == numDofs)
+    {
+      mVersionedSkeletons.emplace_back(i);
+      mSkeletonVersions.emplace_back(mWorld->getSkeletonVersion(i));
+      continue;
+    }
+
+    mWatchedSkeletons.emplace_back(std::move(watched));
+  }
+}
+
+//==============================================================================
+bool CachedTestable::find(const Key& key, bool& satisfied) const
+{
+  const auto it = mIndex.find(key);
+  if (it == mIndex.end())
+    return false;
+
+  mEntries.splice(mEntries.begin(), mEntries, it->second);
+  satisfied = it->second->second;
+  return true;
+}
+
+//==============================================================================
+void CachedTestable::insert(Key key, bool satisfied) const
+{
+  const auto it = mIndex.find(key);
+  if (it != mIndex.end())
+  {
+    it->second->second = satisfied;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return;
+  }
+
+  if (mEntries.size() >= mCapacity)
+  {
+    mIndex.erase(mEntries.back().first);
+    mEntries.pop_back();
+  }
+
+  mEntries.emplace_front(std::move(key), satisfied);
+  mIndex.emplace(mEntries.front().first, mEntries.begin());
+}
+
+} // namespace planner
+} // namespace aikido
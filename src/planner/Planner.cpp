@@ -27,6 +27,18 @@ common::RNG* Planner::getRng()
   return mRng.get();
 }
 
+//==============================================================================
+bool Planner::stopPlanning()
+{
+  return false;
+}
+
+//==============================================================================
+void Planner::clearStopRequest()
+{
+  // Do nothing
+}
+
 //==============================================================================
 Planner::Result::Result(const std::string& message) : mMessage(message)
 {
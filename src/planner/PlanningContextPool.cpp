@@ -0,0 +1,278 @@
+#include "aikido/planner/PlanningContextPool.hpp"
+
+#include <stdexcept>
+
+#include <dart/collision/fcl/FCLCollisionDetector.hpp>
+
+#include "aikido/common/ThreadPool.hpp"
+
+namespace aikido {
+namespace planner {
+
+namespace {
+
+//==============================================================================
+bool haveSameSkeletons(const World& world1, const World& world2)
+{
+  if (world1.getNumSkeletons() != world2.getNumSkeletons())
+    return false;
+
+  for (std::size_t i = 0; i < world1.getNumSkeletons(); ++i)
+  {
+    const auto skeleton1 = world1.getSkeleton(i);
+    const auto skeleton2 = world2.getSkeleton(i);
+    if (skeleton1->getName() != skeleton2->getName()
+        || skeleton1->getNumDofs() != skeleton2->getNumDofs())
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+PlanningContextPool::Handle::Handle() : mPool(nullptr), mContext(nullptr)
+{
+  // Do nothing
+}
+
+//==============================================================================
+PlanningContextPool::Handle::Handle(
+    PlanningContextPool* pool, Context* context)
+  : mPool(pool), mContext(context)
+{
+  // Do nothing
+}
+
+//==============================================================================
+PlanningContextPool::Handle::~Handle()
+{
+  release();
+}
+
+//==============================================================================
+PlanningContextPool::Handle::Handle(Handle&& other)
+  : mPool(other.mPool), mContext(other.mContext)
+{
+  other.mPool = nullptr;
+  other.mContext = nullptr;
+}
+
+//==============================================================================
+auto PlanningContextPool::Handle::operator=(Handle&& other) -> Handle&
+{
+  if (this != &other)
+  {
+    release();
+
+    mPool = other.mPool;
+    mContext = other.mContext;
+    other.mPool = nullptr;
+    other.mContext = nullptr;
+  }
+
+  return *this;
+}
+
+//==============================================================================
+auto PlanningContextPool::Handle::get() const -> Context*
+{
+  return mContext;
+}
+
+//==============================================================================
+auto PlanningContextPool::Handle::operator->() const -> Context*
+{
+  return mContext;
+}
+
+//==============================================================================
+auto PlanningContextPool::Handle::operator*() const -> Context&
+{
+  return *mContext;
+}
+
+//==============================================================================
+PlanningContextPool::Handle::operator bool() const
+{
+  return mContext != nullptr;
+}
+
+//==============================================================================
+void PlanningContextPool::Handle::release()
+{
+  if (mPool && mContext)
+    mPool->release(mContext);
+
+  mPool = nullptr;
+  mContext = nullptr;
+}
+
+//==============================================================================
+PlanningContextPool::PlanningContextPool(
+    WorldPtr world,
+    statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+    const ::dart::dynamics::ConstSkeletonPtr& skeleton,
+    std::size_t numContexts,
+    ConstraintFactory constraintFactory,
+    ::dart::collision::CollisionDetectorPtr collisionDetector)
+  : mWorld(std::move(world))
+  , mStateSpace(std::move(stateSpace))
+  , mConstraintFactory(std::move(constraintFactory))
+  , mCollisionDetector(std::move(collisionDetector))
+{
+  if (!mWorld)
+    throw std::invalid_argument("World is nullptr.");
+
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is nullptr.");
+
+  if (!skeleton)
+    throw std::invalid_argument("Skeleton is nullptr.");
+
+  if (mWorld->getSkeleton(skeleton->getName()) != skeleton)
+  {
+    throw std::invalid_argument(
+        "Skeleton [" + skeleton->getName() + "] is not in the World.");
+  }
+  mSkeletonName = skeleton->getName();
+
+  if (!mCollisionDetector)
+    mCollisionDetector = ::dart::collision::FCLCollisionDetector::create();
+
+  if (numContexts == 0u)
+    numContexts = common::ThreadPool::getDefaultNumThreads();
+
+  mContexts.reserve(numContexts);
+  mAvailableContexts.reserve(numContexts);
+  for (std::size_t i = 0; i < numContexts; ++i)
+  {
+    mContexts.emplace_back(new Context);
+    synchronize(*mContexts.back());
+    mAvailableContexts.emplace_back(mContexts.back().get());
+  }
+}
+
+//==============================================================================
+std::size_t PlanningContextPool::getNumContexts() const
+{
+  return mContexts.size();
+}
+
+//==============================================================================
+std::size_t PlanningContextPool::getNumAvailableContexts() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mAvailableContexts.size();
+}
+
+//==============================================================================
+auto PlanningContextPool::acquire() -> Handle
+{
+  Context* context = nullptr;
+
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() { return !mAvailableContexts.empty(); });
+
+    context = mAvailableContexts.back();
+    mAvailableContexts.pop_back();
+  }
+
+  // The Handle returns the context to the pool if synchronization throws.
+  Handle handle(this, context);
+  synchronize(*context);
+  return handle;
+}
+
+//==============================================================================
+auto PlanningContextPool::tryAcquire() -> Handle
+{
+  Context* context = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mAvailableContexts.empty())
+      return Handle();
+
+    context = mAvailableContexts.back();
+    mAvailableContexts.pop_back();
+  }
+
+  Handle handle(this, context);
+  synchronize(*context);
+  return handle;
+}
+
+//==============================================================================
+void PlanningContextPool::synchronize(Context& context) const
+{
+  WorldPtr world;
+  std::size_t sourceVersion;
+
+  {
+    std::lock_guard<std::mutex> lock(mWorld->getMutex());
+
+    if (context.mWorld && haveSameSkeletons(*context.mWorld, *mWorld))
+    {
+      std::lock_guard<std::mutex> contextLock(context.mWorld->getMutex());
+
+      // A Skeleton is copied if it changed in the original World or if it was
+      // modified in the context, e.g. by the planner, since the last call.
+      for (std::size_t i = 0; i < mWorld->getNumSkeletons(); ++i)
+      {
+        if (mWorld->getSkeletonVersion(i) <= context.mSourceVersion
+            && context.mWorld->getSkeletonVersion(i) <= context.mWorldVersion)
+          continue;
+
+        const auto skeleton = context.mWorld->getSkeleton(i);
+        std::lock_guard<std::mutex> skeletonLock(skeleton->getMutex());
+        skeleton->setPositions(mWorld->getSkeleton(i)->getPositions());
+      }
+
+      context.mSourceVersion = mWorld->getVersion();
+      context.mWorldVersion = context.mWorld->getVersion();
+      return;
+    }
+
+    // Skeletons were added to or removed from the original World, so the
+    // whole World is cloned again.
+    sourceVersion = mWorld->getVersion();
+    world = mWorld->clone();
+  }
+
+  Context clonedContext;
+  clonedContext.mWorld = std::move(world);
+  clonedContext.mSkeleton = clonedContext.mWorld->getSkeleton(mSkeletonName);
+  if (!clonedContext.mSkeleton)
+  {
+    throw std::runtime_error(
+        "Skeleton [" + mSkeletonName + "] was removed from the World.");
+  }
+
+  clonedContext.mMetaSkeleton
+      = mStateSpace->getControlledMetaSkeleton(clonedContext.mSkeleton);
+  clonedContext.mStateSpace = mStateSpace;
+  clonedContext.mCollisionDetector
+      = mCollisionDetector->cloneWithoutCollisionObjects();
+  if (mConstraintFactory)
+    clonedContext.mConstraint = mConstraintFactory(clonedContext);
+  clonedContext.mSourceVersion = sourceVersion;
+  clonedContext.mWorldVersion = clonedContext.mWorld->getVersion();
+
+  context = std::move(clonedContext);
+}
+
+//==============================================================================
+void PlanningContextPool::release(Context* context)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAvailableContexts.emplace_back(context);
+  }
+  mCondition.notify_one();
+}
+
+} // namespace planner
+} // namespace aikido
@@ -1,5 +1,9 @@
 #include "aikido/planner/World.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 #include "aikido/common/memory.hpp"
 
 namespace aikido {
@@ -7,8 +11,24 @@ namespace planner {
 
 dart::common::NameManager<World*> World::mWorldNameManager{"World", "world"};
 
+namespace {
+
+//==============================================================================
+dart::dynamics::SkeletonPtr cloneSkeleton(
+    const dart::dynamics::Skeleton& skeleton)
+{
+#if DART_VERSION_AT_LEAST(6, 7, 0)
+  return skeleton.cloneSkeleton();
+#else
+  return skeleton.clone();
+#endif
+}
+
+} // namespace
+
 //==============================================================================
 World::World(const std::string& name)
+  : mNumSharedSkeletons(0u), mVersion(0u)
 {
   setName(name);
 
@@ -30,21 +50,67 @@ std::unique_ptr<World> World::create(const std::string& name)
 }
 
 //==============================================================================
-std::unique_ptr<World> World::clone(const std::string& newName) const
+std::unique_ptr<World> World::clone(
+    const std::string& newName, CloneMode mode) const
 {
   std::unique_ptr<World> worldClone(
       new World(newName.empty() ? mName : newName));
 
+  // Copy the Skeletons without holding mVersionMutex, which another thread
+  // may be waiting for while it holds the mutex of one of them.
+  std::vector<dart::dynamics::SkeletonPtr> skeletons;
+  std::vector<SharedSkeleton> sharedSkeletons;
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(mVersionMutex);
+    skeletons = mSkeletons;
+    sharedSkeletons = mSharedSkeletons;
+    names = getSkeletonNames();
+  }
+
+  if (mode == CloneMode::COPY_ON_WRITE)
+  {
+    worldClone->mSkeletons.resize(skeletons.size());
+    worldClone->mSharedSkeletons.reserve(skeletons.size());
+    worldClone->mSkeletonRecords.resize(
+        skeletons.size(), SkeletonRecord{nullptr, Eigen::VectorXd(), 0u});
+    for (std::size_t i = 0; i < skeletons.size(); ++i)
+    {
+      // A Skeleton that is still shared is shared with its source again.
+      auto& shared = sharedSkeletons[i];
+      if (skeletons[i])
+      {
+        shared.mSource = skeletons[i];
+        shared.mPositions = shared.mSource->getPositions();
+      }
+
+      worldClone->mSkeletonNameManager.addName(names[i], shared.mSource);
+      worldClone->mSharedSkeletons.emplace_back(std::move(shared));
+    }
+    worldClone->mNumSharedSkeletons = skeletons.size();
+
+    return worldClone;
+  }
+
   // Clone and add each Skeleton
-  worldClone->mSkeletons.reserve(mSkeletons.size());
-  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  worldClone->mSkeletons.reserve(skeletons.size());
+  for (std::size_t i = 0; i < skeletons.size(); ++i)
   {
-#if DART_VERSION_AT_LEAST(6, 7, 0)
-    const auto clonedSkeleton = mSkeletons[i]->cloneSkeleton();
-#else
-    const auto clonedSkeleton = mSkeletons[i]->clone();
-#endif
-    clonedSkeleton->setConfiguration(mSkeletons[i]->getConfiguration());
+    dart::dynamics::SkeletonPtr clonedSkeleton;
+    if (skeletons[i])
+    {
+      clonedSkeleton = cloneSkeleton(*skeletons[i]);
+      clonedSkeleton->setConfiguration(skeletons[i]->getConfiguration());
+    }
+    else
+    {
+      const auto& shared = sharedSkeletons[i];
+      clonedSkeleton = cloneSkeleton(*shared.mSource);
+      clonedSkeleton->setName(names[i]);
+      if (clonedSkeleton->getNumDofs()
+          == static_cast<std::size_t>(shared.mPositions.size()))
+        clonedSkeleton->setPositions(shared.mPositions);
+    }
     worldClone->addSkeleton(std::move(clonedSkeleton));
   }
 
@@ -70,21 +136,63 @@ const std::string& World::getName() const
 //==============================================================================
 dart::dynamics::SkeletonPtr World::getSkeleton(std::size_t i) const
 {
-  if (i < mSkeletons.size())
-    return mSkeletons[i];
+  std::unique_lock<std::mutex> lock(mVersionMutex);
+  if (i >= mSkeletons.size())
+    return nullptr;
 
-  return nullptr;
+  return unshareSkeleton(i, lock);
 }
 
 //==============================================================================
 dart::dynamics::SkeletonPtr World::getSkeleton(const std::string& name) const
 {
-  return mSkeletonNameManager.getObject(name);
+  std::unique_lock<std::mutex> lock(mVersionMutex);
+
+  auto skeleton = mSkeletonNameManager.getObject(name);
+  if (!skeleton || mNumSharedSkeletons == 0u)
+    return skeleton;
+
+  const auto i = findSkeleton(skeleton);
+  if (i == mSkeletons.size())
+    return nullptr;
+
+  return unshareSkeleton(i, lock);
+}
+
+//==============================================================================
+dart::dynamics::ConstSkeletonPtr World::getConstSkeleton(std::size_t i) const
+{
+  std::unique_lock<std::mutex> lock(mVersionMutex);
+  if (i >= mSkeletons.size())
+    return nullptr;
+
+  return getConstSkeletonImpl(i, lock);
+}
+
+//==============================================================================
+dart::dynamics::ConstSkeletonPtr World::getConstSkeleton(
+    const std::string& name) const
+{
+  std::unique_lock<std::mutex> lock(mVersionMutex);
+
+  auto skeleton = mSkeletonNameManager.getObject(name);
+  if (!skeleton || mNumSharedSkeletons == 0u)
+    return skeleton;
+
+  const auto i = findSkeleton(skeleton);
+  if (i == mSkeletons.size())
+    return nullptr;
+
+  return getConstSkeletonImpl(i, lock);
 }
 
 //==============================================================================
 bool World::hasSkeleton(const dart::dynamics::SkeletonPtr& skel) const
 {
+  if (!skel)
+    return false;
+
+  std::lock_guard<std::mutex> lock(mVersionMutex);
   return std::find(mSkeletons.begin(), mSkeletons.end(), skel)
          != mSkeletons.end();
 }
@@ -95,6 +203,13 @@ std::size_t World::getNumSkeletons() const
   return mSkeletons.size();
 }
 
+//==============================================================================
+bool World::isSkeletonShared(std::size_t i) const
+{
+  std::lock_guard<std::mutex> lock(mVersionMutex);
+  return i < mSkeletons.size() && !mSkeletons[i];
+}
+
 //==============================================================================
 std::string World::addSkeleton(const dart::dynamics::SkeletonPtr& skeleton)
 {
@@ -106,6 +221,7 @@ std::string World::addSkeleton(const dart::dynamics::SkeletonPtr& skeleton)
   }
 
   std::lock_guard<std::mutex> lock(mMutex);
+  std::lock_guard<std::mutex> versionLock(mVersionMutex);
 
   // If mSkeletons already has skeleton, then do nothing.
   if (std::find(mSkeletons.begin(), mSkeletons.end(), skeleton)
@@ -117,6 +233,9 @@ std::string World::addSkeleton(const dart::dynamics::SkeletonPtr& skeleton)
   }
 
   mSkeletons.push_back(skeleton);
+  mSharedSkeletons.emplace_back();
+  mSkeletonRecords.push_back(SkeletonRecord{nullptr, Eigen::VectorXd(), 0u});
+  ++mVersion;
 
   skeleton->setName(
       mSkeletonNameManager.issueNewNameAndAdd(skeleton->getName(), skeleton));
@@ -135,6 +254,7 @@ void World::removeSkeleton(const dart::dynamics::SkeletonPtr& skeleton)
   }
 
   std::lock_guard<std::mutex> lock(mMutex);
+  std::lock_guard<std::mutex> versionLock(mVersionMutex);
 
   // If mSkeletons doesn't have skeleton, then do nothing.
   auto skelIt = std::find(mSkeletons.begin(), mSkeletons.end(), skeleton);
@@ -145,6 +265,12 @@ void World::removeSkeleton(const dart::dynamics::SkeletonPtr& skeleton)
     return;
   }
 
+  const auto index = skelIt - mSkeletons.begin();
+  mSharedSkeletons.erase(mSharedSkeletons.begin() + index);
+  if (static_cast<std::size_t>(index) < mSkeletonRecords.size())
+    mSkeletonRecords.erase(mSkeletonRecords.begin() + index);
+  ++mVersion;
+
   // Remove skeleton from mSkeletons
   mSkeletons.erase(skelIt);
 
@@ -173,10 +299,10 @@ bool World::State::operator!=(const State& other) const
 World::State World::getState() const
 {
   std::vector<std::string> names;
-  names.reserve(getNumSkeletons());
-
-  for (const auto& skeleton : mSkeletons)
-    names.push_back(skeleton->getName());
+  {
+    std::lock_guard<std::mutex> lock(mVersionMutex);
+    names = getSkeletonNames();
+  }
 
   return getState(names);
 }
@@ -190,7 +316,7 @@ World::State World::getState(const std::vector<std::string>& names) const
 
   for (const auto& name : names)
   {
-    auto skeleton = getSkeleton(name);
+    auto skeleton = getConstSkeleton(name);
     if (!skeleton)
     {
       throw std::invalid_argument(
@@ -212,10 +338,10 @@ void World::setState(const World::State& state)
         "skeletons.");
 
   std::vector<std::string> names;
-  names.reserve(getNumSkeletons());
-
-  for (const auto& skeleton : mSkeletons)
-    names.push_back(skeleton->getName());
+  {
+    std::lock_guard<std::mutex> lock(mVersionMutex);
+    names = getSkeletonNames();
+  }
 
   setState(state, names);
 }
@@ -237,5 +363,248 @@ void World::setState(
   }
 }
 
+//==============================================================================
+std::size_t World::getVersion() const
+{
+  std::lock_guard<std::mutex> lock(mVersionMutex);
+
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+    updateSkeletonVersion(i);
+
+  return mVersion;
+}
+
+//==============================================================================
+std::size_t World::getSkeletonVersion(std::size_t i) const
+{
+  if (i >= mSkeletons.size())
+    throw std::out_of_range("Skeleton index is out of range.");
+
+  std::lock_guard<std::mutex> lock(mVersionMutex);
+  return updateSkeletonVersion(i);
+}
+
+//==============================================================================
+World::Snapshot World::createSnapshot() const
+{
+  std::lock_guard<std::mutex> lock(mVersionMutex);
+
+  Snapshot snapshot;
+  snapshot.mSkeletons.reserve(mSkeletons.size());
+  snapshot.mPositions.reserve(mSkeletons.size());
+  snapshot.mVersions.reserve(mSkeletons.size());
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    // The record holds the current positions once it is updated. Shared
+    // Skeletons are saved as their source, which restoreSnapshot recognizes.
+    snapshot.mVersions.emplace_back(updateSkeletonVersion(i));
+    snapshot.mSkeletons.emplace_back(
+        mSkeletons[i] ? mSkeletons[i] : mSharedSkeletons[i].mSource);
+    snapshot.mPositions.emplace_back(mSkeletonRecords[i].mPositions);
+  }
+
+  return snapshot;
+}
+
+//==============================================================================
+std::size_t World::restoreSnapshot(const Snapshot& snapshot)
+{
+  // Skeletons to restore and their positions. They are set once mVersionMutex
+  // is released, so that it is not held while waiting for their mutexes.
+  std::vector<std::pair<dart::dynamics::SkeletonPtr, const Eigen::VectorXd*>>
+      restores;
+
+  {
+    std::unique_lock<std::mutex> lock(mVersionMutex);
+
+    for (std::size_t k = 0; k < snapshot.mSkeletons.size(); ++k)
+    {
+      const auto& skeleton = snapshot.mSkeletons[k];
+
+      // Skeletons are usually still at the index they were saved at.
+      // Skeletons that were shared are saved as their source.
+      auto i = k;
+      if (i >= mSkeletons.size()
+          || (mSkeletons[i] != skeleton
+              && mSharedSkeletons[i].mSource != skeleton))
+      {
+        i = findSkeleton(skeleton);
+        if (i == mSkeletons.size())
+          continue;
+      }
+
+      if (updateSkeletonVersion(i) == snapshot.mVersions[k])
+        continue;
+
+      auto target = unshareSkeleton(i, lock);
+
+      // DOFs were added to or removed from the Skeleton since.
+      if (!target
+          || static_cast<std::size_t>(snapshot.mPositions[k].size())
+                 != target->getNumDofs())
+        continue;
+
+      restores.emplace_back(std::move(target), &snapshot.mPositions[k]);
+    }
+  }
+
+  for (const auto& restore : restores)
+  {
+    std::lock_guard<std::mutex> skeletonLock(restore.first->getMutex());
+    restore.first->setPositions(*restore.second);
+  }
+
+  return restores.size();
+}
+
+//==============================================================================
+std::size_t World::updateSkeletonVersion(std::size_t i) const
+{
+  if (mSkeletonRecords.size() != mSkeletons.size())
+  {
+    // mSkeletons was modified without addSkeleton or removeSkeleton, so the
+    // records of moved Skeletons are renewed below.
+    mSkeletonRecords.resize(
+        mSkeletons.size(), SkeletonRecord{nullptr, Eigen::VectorXd(), 0u});
+    mSharedSkeletons.resize(mSkeletons.size());
+    ++mVersion;
+  }
+
+  const auto& skeleton = mSkeletons[i];
+  auto& record = mSkeletonRecords[i];
+
+  if (!skeleton)
+  {
+    // Shared Skeletons keep the positions they were cloned with.
+    const auto& shared = mSharedSkeletons[i];
+    if (record.mSkeleton != shared.mSource.get())
+    {
+      record.mSkeleton = shared.mSource.get();
+      record.mPositions = shared.mPositions;
+      record.mVersion = ++mVersion;
+    }
+    return record.mVersion;
+  }
+
+  const auto numDofs = skeleton->getNumDofs();
+
+  bool changed = false;
+  if (record.mSkeleton != skeleton.get()
+      || static_cast<std::size_t>(record.mPositions.size()) != numDofs)
+  {
+    record.mSkeleton = skeleton.get();
+    record.mPositions.resize(numDofs);
+    changed = true;
+  }
+
+  for (std::size_t j = 0; j < numDofs; ++j)
+  {
+    const double position = skeleton->getPosition(j);
+    if (position != record.mPositions[j])
+    {
+      record.mPositions[j] = position;
+      changed = true;
+    }
+  }
+
+  if (changed)
+    record.mVersion = ++mVersion;
+
+  return record.mVersion;
+}
+
+//==============================================================================
+std::size_t World::findSkeleton(
+    const dart::dynamics::SkeletonPtr& skeleton) const
+{
+  if (!skeleton)
+    return mSkeletons.size();
+
+  // Shared Skeletons are registered with their source.
+  const auto it = std::find_if(
+      mSkeletons.begin(),
+      mSkeletons.end(),
+      [&](const dart::dynamics::SkeletonPtr& candidate) {
+        return candidate == skeleton
+               || mSharedSkeletons[&candidate - mSkeletons.data()].mSource
+                      == skeleton;
+      });
+  return it - mSkeletons.begin();
+}
+
+//==============================================================================
+std::vector<std::string> World::getSkeletonNames() const
+{
+  std::vector<std::string> names;
+  names.reserve(mSkeletons.size());
+
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    names.emplace_back(
+        mSkeletons[i]
+            ? mSkeletons[i]->getName()
+            : mSkeletonNameManager.getName(mSharedSkeletons[i].mSource));
+  }
+
+  return names;
+}
+
+//==============================================================================
+dart::dynamics::ConstSkeletonPtr World::getConstSkeletonImpl(
+    std::size_t i, std::unique_lock<std::mutex>& versionLock) const
+{
+  if (mSkeletons[i])
+    return mSkeletons[i];
+
+  // The source stands in for its clone while it is at the recorded positions.
+  const auto& shared = mSharedSkeletons[i];
+  if (shared.mSource->getNumDofs()
+          == static_cast<std::size_t>(shared.mPositions.size())
+      && shared.mSource->getPositions() == shared.mPositions)
+    return shared.mSource;
+
+  return unshareSkeleton(i, versionLock);
+}
+
+//==============================================================================
+dart::dynamics::SkeletonPtr World::unshareSkeleton(
+    std::size_t i, std::unique_lock<std::mutex>& versionLock) const
+{
+  if (mSkeletons[i])
+    return mSkeletons[i];
+
+  const auto shared = mSharedSkeletons[i];
+  const auto name = mSkeletonNameManager.getName(shared.mSource);
+
+  // Clone without holding mVersionMutex, which another thread may be waiting
+  // for while it holds the mutex of the source.
+  versionLock.unlock();
+  auto skeleton = cloneSkeleton(*shared.mSource);
+  skeleton->setName(name);
+  if (skeleton->getNumDofs()
+      == static_cast<std::size_t>(shared.mPositions.size()))
+    skeleton->setPositions(shared.mPositions);
+  versionLock.lock();
+
+  // Skeletons may have been added, removed or cloned in the meantime.
+  i = findSkeleton(shared.mSource);
+  if (i == mSkeletons.size())
+    return nullptr;
+  if (mSkeletons[i])
+    return mSkeletons[i];
+
+  mSkeletons[i] = skeleton;
+  mSkeletonNameManager.removeName(name);
+  mSkeletonNameManager.addName(name, skeleton);
+  --mNumSharedSkeletons;
+
+  // The clone has the recorded positions, so its version is unchanged.
+  if (i < mSkeletonRecords.size()
+      && mSkeletonRecords[i].mSkeleton == shared.mSource.get())
+    mSkeletonRecords[i].mSkeleton = skeleton.get();
+
+  return skeleton;
+}
+
 } // namespace planner
 } // namespace aikido
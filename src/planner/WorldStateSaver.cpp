@@ -10,13 +10,13 @@ WorldStateSaver::WorldStateSaver(World* world, int options)
     throw std::invalid_argument("World must not be nullptr.");
 
   if (mOptions & Options::CONFIGURATIONS)
-    mWorldState = mWorld->getState();
+    mSnapshot = mWorld->createSnapshot();
 }
 
 WorldStateSaver::~WorldStateSaver()
 {
   if (mOptions & Options::CONFIGURATIONS)
-    mWorld->setState(mWorldState);
+    mWorld->restoreSnapshot(mSnapshot);
 }
 
 } // namespace planner
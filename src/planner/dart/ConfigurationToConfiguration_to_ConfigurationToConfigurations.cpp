@@ -7,6 +7,8 @@
 #include "aikido/statespace/dart/MetaSkeletonStateSaver.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
 
+#include "PortfolioPlanning.hpp"
+
 using aikido::distance::ConstConfigurationRankerPtr;
 using aikido::distance::NominalConfigurationRanker;
 using aikido::statespace::dart::MetaSkeletonStateSaver;
@@ -64,6 +66,20 @@ ConfigurationToConfiguration_to_ConfigurationToConfigurations::plan(
     return nullptr;
   configurationRanker->rankConfigurations(configurations);
 
+  if (mPortfolioContextPool)
+  {
+    detail::RankedGoalQueue goals(mMetaSkeletonStateSpace, configurations);
+    return detail::planToConfigurationsConcurrently(
+        *mPortfolioThreadPool,
+        *mPortfolioContextPool,
+        mPortfolioDelegates,
+        mMetaSkeletonStateSpace,
+        startState,
+        goals,
+        problem.getConstraint(),
+        result);
+  }
+
   for (std::size_t i = 0; i < configurations.size(); ++i)
   {
     // Create ConfigurationToConfiguration Problem.
@@ -83,6 +99,31 @@ ConfigurationToConfiguration_to_ConfigurationToConfigurations::plan(
   return nullptr;
 }
 
+//==============================================================================
+void ConfigurationToConfiguration_to_ConfigurationToConfigurations::
+    setPortfolio(
+        PlanningContextPoolPtr contextPool,
+        DelegateFactory delegateFactory,
+        std::size_t numConcurrentGoals)
+{
+  detail::setPortfolio(
+      std::move(contextPool),
+      delegateFactory,
+      numConcurrentGoals,
+      mMetaSkeletonStateSpace,
+      mPortfolioContextPool,
+      mPortfolioDelegates,
+      mPortfolioThreadPool);
+}
+
+//==============================================================================
+PlanningContextPoolPtr
+ConfigurationToConfiguration_to_ConfigurationToConfigurations::getPortfolioContextPool()
+    const
+{
+  return mPortfolioContextPool;
+}
+
 } // namespace dart
 } // namespace planner
 } // namespace aikido
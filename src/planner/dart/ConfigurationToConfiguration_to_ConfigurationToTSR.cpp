@@ -1,5 +1,9 @@
 #include "aikido/planner/dart/ConfigurationToConfiguration_to_ConfigurationToTSR.hpp"
 
+#include <exception>
+#include <thread>
+
+#include <dart/config.hpp>
 #include <dart/dynamics/dynamics.hpp>
 
 #include "aikido/common/RNG.hpp"
@@ -9,6 +13,8 @@
 #include "aikido/statespace/dart/MetaSkeletonStateSaver.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
 
+#include "PortfolioPlanning.hpp"
+
 using aikido::common::cloneRNGFrom;
 using aikido::constraint::dart::createSampleableBounds;
 using aikido::constraint::dart::InverseKinematicsSampleable;
@@ -35,6 +41,8 @@ ConfigurationToConfiguration_to_ConfigurationToTSR::
   : PlannerAdapter<
         planner::ConfigurationToConfigurationPlanner,
         ConfigurationToTSRPlanner>(std::move(planner), std::move(metaSkeleton))
+  , mMaxNumGoalSamples(100u)
+  , mGoalQueueCapacity(0u)
 {
   mConfigurationRanker = std::move(configurationRanker);
 }
@@ -65,38 +73,10 @@ ConfigurationToConfiguration_to_ConfigurationToTSR::plan(
       throw std::invalid_argument("MetaSkeleton has more than 1 skeleton.");
   }
 
-  // Create an IK solver with MetaSkeleton DOFs
-  auto matchingNodes
-      = skeleton->getBodyNodes(problem.getEndEffectorBodyNode()->getName());
-  if (matchingNodes.empty())
-    throw std::invalid_argument(
-        "End-effector BodyNode not found in Planner's MetaSkeleton.");
-  ::dart::dynamics::BodyNodePtr endEffectorBodyNode = matchingNodes.front();
-
-  auto ik = InverseKinematics::create(endEffectorBodyNode);
-  ik->setDofs(mMetaSkeleton->getDofs());
-
   // Get the start state from the MetaSkeleton, since this is a DART planner.
   auto startState = mMetaSkeletonStateSpace->createState();
   mMetaSkeletonStateSpace->getState(mMetaSkeleton.get(), startState);
 
-  auto rng = std::move(cloneRNGFrom(*mDelegate->getRng())[0]);
-  // Convert TSR constraint into IK constraint.
-  // NOTE: Const-casting should be removed once InverseKinematicsSampleable is
-  // changed to take const constraints!
-  InverseKinematicsSampleable ikSampleable(
-      mMetaSkeletonStateSpace,
-      mMetaSkeleton,
-      std::const_pointer_cast<TSR>(problem.getGoalTSR()),
-      createSampleableBounds(mMetaSkeletonStateSpace, std::move(rng)),
-      ik,
-      problem.getMaxSamples());
-  auto generator = ikSampleable.createSampleGenerator();
-
-  auto robot = mMetaSkeleton->getBodyNode(0)->getSkeleton();
-
-  std::vector<MetaSkeletonStateSpace::ScopedState> configurations;
-
   // Use a ranker
   ConstConfigurationRankerPtr configurationRanker(mConfigurationRanker);
   if (!configurationRanker)
@@ -107,49 +87,220 @@ ConfigurationToConfiguration_to_ConfigurationToTSR::plan(
         mMetaSkeletonStateSpace, mMetaSkeleton, nominalState);
   }
 
-  // Goal state
-  auto goalState = mMetaSkeletonStateSpace->createState();
+  // Plans to the goals in turn with the delegate planner, or concurrently in
+  // portfolio mode.
+  auto planToGoals
+      = [&](detail::GoalQueue& goals) -> trajectory::TrajectoryPtr {
+    if (mPortfolioContextPool)
+    {
+      return detail::planToConfigurationsConcurrently(
+          *mPortfolioThreadPool,
+          *mPortfolioContextPool,
+          mPortfolioDelegates,
+          mMetaSkeletonStateSpace,
+          startState,
+          goals,
+          problem.getConstraint(),
+          result);
+    }
+
+    auto goalState = mMetaSkeletonStateSpace->createState();
+    while (goals.pop(goalState))
+    {
+      // Create ConfigurationToConfiguration Problem.
+      // NOTE: This is done here because the ConfigurationToConfiguration
+      // problem stores a *cloned* scoped state of the passed state.
+      auto delegateProblem = ConfigurationToConfiguration(
+          mMetaSkeletonStateSpace,
+          startState,
+          goalState,
+          problem.getConstraint());
+
+      auto traj = mDelegate->plan(delegateProblem, result);
+      if (traj)
+        return traj;
+    }
+
+    return nullptr;
+  };
 
-  // Sample valid configurations first.
-  static const std::size_t maxSamples{100};
-  std::size_t samples = 0;
-  while (samples < maxSamples && generator->canSample())
+  if (mGoalQueueCapacity == 0u)
   {
-    // Sample from TSR
-    bool sampled = generator->sample(goalState);
+    auto generator
+        = createGoalSampleGenerator(problem, skeleton, mMetaSkeleton);
 
-    // Increment even if it's not a valid sample since this loop
-    // has to terminate even if none are valid.
-    ++samples;
+    // Goal state
+    auto goalState = mMetaSkeletonStateSpace->createState();
 
-    if (!sampled)
-      continue;
+    // Sample valid configurations first.
+    std::vector<MetaSkeletonStateSpace::ScopedState> configurations;
+    std::size_t samples = 0;
+    while (samples < mMaxNumGoalSamples && generator->canSample())
+    {
+      // Sample from TSR
+      bool sampled = generator->sample(goalState);
 
-    configurations.emplace_back(goalState.clone());
+      // Increment even if it's not a valid sample since this loop
+      // has to terminate even if none are valid.
+      ++samples;
+
+      if (!sampled)
+        continue;
+
+      configurations.emplace_back(goalState.clone());
+    }
+
+    if (configurations.empty())
+      return nullptr;
+
+    configurationRanker->rankConfigurations(configurations);
+
+    detail::RankedGoalQueue goals(mMetaSkeletonStateSpace, configurations);
+    return planToGoals(goals);
   }
 
-  if (configurations.empty())
-    return nullptr;
+  // Sample on a clone of the Skeleton, since the delegate planner sets the
+  // positions of mMetaSkeleton while the goals are sampled.
+#if DART_VERSION_AT_LEAST(6, 7, 0)
+  const auto ikSkeleton = skeleton->cloneSkeleton();
+#else
+  const auto ikSkeleton = skeleton->clone();
+#endif
+  auto generator = createGoalSampleGenerator(
+      problem,
+      ikSkeleton,
+      mMetaSkeletonStateSpace->getControlledMetaSkeleton(ikSkeleton));
 
-  configurationRanker->rankConfigurations(configurations);
+  detail::StreamingGoalQueue goals(mMetaSkeletonStateSpace, mGoalQueueCapacity);
+  std::exception_ptr samplingException;
 
-  for (std::size_t i = 0; i < configurations.size(); ++i)
+  std::thread sampler([&]() {
+    try
+    {
+      auto goalState = mMetaSkeletonStateSpace->createState();
+      for (std::size_t samples = 0;
+           samples < mMaxNumGoalSamples && generator->canSample();
+           ++samples)
+      {
+        if (!generator->sample(goalState))
+          continue;
+
+        // Stop sampling once a trajectory is found.
+        if (!goals.push(goalState, configurationRanker->getCost(goalState)))
+          break;
+      }
+    }
+    catch (...)
+    {
+      samplingException = std::current_exception();
+    }
+
+    goals.finish();
+  });
+
+  trajectory::TrajectoryPtr trajectory;
+  try
   {
-    // Create ConfigurationToConfiguration Problem.
-    // NOTE: This is done here because the ConfigurationToConfiguration
-    // problem stores a *cloned* scoped state of the passed state.
-    auto delegateProblem = ConfigurationToConfiguration(
-        mMetaSkeletonStateSpace,
-        startState,
-        configurations[i],
-        problem.getConstraint());
-
-    auto traj = mDelegate->plan(delegateProblem, result);
-    if (traj)
-      return traj;
+    trajectory = planToGoals(goals);
   }
+  catch (...)
+  {
+    goals.close();
+    sampler.join();
+    throw;
+  }
+
+  goals.close();
+  sampler.join();
 
-  return nullptr;
+  if (samplingException)
+    std::rethrow_exception(samplingException);
+
+  return trajectory;
+}
+
+//==============================================================================
+std::unique_ptr<constraint::SampleGenerator>
+ConfigurationToConfiguration_to_ConfigurationToTSR::createGoalSampleGenerator(
+    const ConfigurationToTSR& problem,
+    const ::dart::dynamics::SkeletonPtr& skeleton,
+    ::dart::dynamics::MetaSkeletonPtr metaSkeleton)
+{
+  // Create an IK solver with MetaSkeleton DOFs
+  auto matchingNodes
+      = skeleton->getBodyNodes(problem.getEndEffectorBodyNode()->getName());
+  if (matchingNodes.empty())
+    throw std::invalid_argument(
+        "End-effector BodyNode not found in Planner's MetaSkeleton.");
+  ::dart::dynamics::BodyNodePtr endEffectorBodyNode = matchingNodes.front();
+
+  auto ik = InverseKinematics::create(endEffectorBodyNode);
+  ik->setDofs(metaSkeleton->getDofs());
+
+  auto rng = std::move(cloneRNGFrom(*mDelegate->getRng())[0]);
+  // Convert TSR constraint into IK constraint.
+  // NOTE: Const-casting should be removed once InverseKinematicsSampleable is
+  // changed to take const constraints!
+  InverseKinematicsSampleable ikSampleable(
+      mMetaSkeletonStateSpace,
+      std::move(metaSkeleton),
+      std::const_pointer_cast<TSR>(problem.getGoalTSR()),
+      createSampleableBounds(mMetaSkeletonStateSpace, std::move(rng)),
+      ik,
+      problem.getMaxSamples());
+  return ikSampleable.createSampleGenerator();
+}
+
+//==============================================================================
+void ConfigurationToConfiguration_to_ConfigurationToTSR::setGoalQueueCapacity(
+    std::size_t capacity)
+{
+  mGoalQueueCapacity = capacity;
+}
+
+//==============================================================================
+std::size_t
+ConfigurationToConfiguration_to_ConfigurationToTSR::getGoalQueueCapacity() const
+{
+  return mGoalQueueCapacity;
+}
+
+//==============================================================================
+void ConfigurationToConfiguration_to_ConfigurationToTSR::setMaxNumGoalSamples(
+    std::size_t maxNumGoalSamples)
+{
+  mMaxNumGoalSamples = maxNumGoalSamples;
+}
+
+//==============================================================================
+std::size_t
+ConfigurationToConfiguration_to_ConfigurationToTSR::getMaxNumGoalSamples() const
+{
+  return mMaxNumGoalSamples;
+}
+
+//==============================================================================
+void ConfigurationToConfiguration_to_ConfigurationToTSR::setPortfolio(
+    PlanningContextPoolPtr contextPool,
+    DelegateFactory delegateFactory,
+    std::size_t numConcurrentGoals)
+{
+  detail::setPortfolio(
+      std::move(contextPool),
+      delegateFactory,
+      numConcurrentGoals,
+      mMetaSkeletonStateSpace,
+      mPortfolioContextPool,
+      mPortfolioDelegates,
+      mPortfolioThreadPool);
+}
+
+//==============================================================================
+PlanningContextPoolPtr
+ConfigurationToConfiguration_to_ConfigurationToTSR::getPortfolioContextPool()
+    const
+{
+  return mPortfolioContextPool;
 }
 
 } // namespace dart
@@ -0,0 +1,297 @@
+#include "PortfolioPlanning.hpp"
+
+#include <future>
+#include <iterator>
+#include <stdexcept>
+
+#include "aikido/planner/ConfigurationToConfiguration.hpp"
+
+namespace aikido {
+namespace planner {
+namespace dart {
+namespace detail {
+
+//==============================================================================
+RankedGoalQueue::RankedGoalQueue(
+    statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+    const std::vector<statespace::dart::MetaSkeletonStateSpace::ScopedState>&
+        goals)
+  : mStateSpace(std::move(stateSpace)), mGoals(goals), mNextGoal(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool RankedGoalQueue::pop(statespace::StateSpace::State* goal)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mNextGoal >= mGoals.size())
+    return false;
+
+  mStateSpace->copyState(mGoals[mNextGoal++], goal);
+  return true;
+}
+
+//==============================================================================
+void RankedGoalQueue::close()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mNextGoal = mGoals.size();
+}
+
+//==============================================================================
+StreamingGoalQueue::StreamingGoalQueue(
+    statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+    std::size_t capacity)
+  : mStateSpace(std::move(stateSpace))
+  , mCapacity(capacity)
+  , mIsFinished(false)
+  , mIsClosed(false)
+{
+  if (mCapacity == 0u)
+    throw std::invalid_argument("Goal queue capacity must be positive.");
+}
+
+//==============================================================================
+bool StreamingGoalQueue::push(
+    const statespace::StateSpace::State* goal, double cost)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mIsClosed)
+      return false;
+
+    if (mGoals.size() == mCapacity)
+    {
+      const auto worst = std::prev(mGoals.end());
+      if (cost >= worst->first)
+        return true;
+
+      mGoals.erase(worst);
+    }
+
+    auto state = mStateSpace->createState();
+    mStateSpace->copyState(goal, state);
+    mGoals.emplace(cost, std::move(state));
+  }
+
+  mCondition.notify_one();
+  return true;
+}
+
+//==============================================================================
+void StreamingGoalQueue::finish()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsFinished = true;
+  }
+  mCondition.notify_all();
+}
+
+//==============================================================================
+bool StreamingGoalQueue::pop(statespace::StateSpace::State* goal)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondition.wait(
+      lock, [this]() { return mIsClosed || mIsFinished || !mGoals.empty(); });
+
+  if (mIsClosed || mGoals.empty())
+    return false;
+
+  mStateSpace->copyState(mGoals.begin()->second, goal);
+  mGoals.erase(mGoals.begin());
+  return true;
+}
+
+//==============================================================================
+void StreamingGoalQueue::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsClosed = true;
+    mGoals.clear();
+  }
+  mCondition.notify_all();
+}
+
+//==============================================================================
+std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>
+createPortfolioDelegates(
+    const std::function<
+        std::shared_ptr<ConfigurationToConfigurationPlanner>()>&
+        delegateFactory,
+    std::size_t numDelegates,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace)
+{
+  if (!delegateFactory)
+    throw std::invalid_argument("Delegate factory is empty.");
+
+  if (numDelegates == 0u)
+    throw std::invalid_argument("Number of concurrent goals must be positive.");
+
+  std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>> delegates;
+  delegates.reserve(numDelegates);
+  for (std::size_t i = 0; i < numDelegates; ++i)
+  {
+    auto delegate = delegateFactory();
+    if (!delegate)
+      throw std::invalid_argument("Delegate factory returned nullptr.");
+
+    if (delegate->getStateSpace() != stateSpace)
+    {
+      throw std::invalid_argument(
+          "Delegate planner does not plan in the MetaSkeletonStateSpace of "
+          "the adapter.");
+    }
+
+    delegates.emplace_back(std::move(delegate));
+  }
+
+  return delegates;
+}
+
+//==============================================================================
+void setPortfolio(
+    PlanningContextPoolPtr contextPool,
+    const std::function<
+        std::shared_ptr<ConfigurationToConfigurationPlanner>()>&
+        delegateFactory,
+    std::size_t numConcurrentGoals,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace,
+    PlanningContextPoolPtr& portfolioContextPool,
+    std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>&
+        portfolioDelegates,
+    std::unique_ptr<common::ThreadPool>& portfolioThreadPool)
+{
+  if (!contextPool)
+  {
+    portfolioContextPool.reset();
+    portfolioDelegates.clear();
+    portfolioThreadPool.reset();
+    return;
+  }
+
+  if (numConcurrentGoals == 0u)
+    numConcurrentGoals = contextPool->getNumContexts();
+
+  portfolioDelegates = createPortfolioDelegates(
+      delegateFactory, numConcurrentGoals, stateSpace);
+  portfolioContextPool = std::move(contextPool);
+  portfolioThreadPool.reset(new common::ThreadPool(numConcurrentGoals));
+}
+
+//==============================================================================
+trajectory::TrajectoryPtr planToConfigurationsConcurrently(
+    common::ThreadPool& threadPool,
+    PlanningContextPool& contextPool,
+    const std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>&
+        delegates,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace,
+    const statespace::StateSpace::State* startState,
+    GoalQueue& goals,
+    const constraint::ConstTestablePtr& problemConstraint,
+    Planner::Result* result)
+{
+  std::mutex mutex;
+  bool isDone = false;
+  trajectory::TrajectoryPtr trajectory;
+
+  // Whether each delegate is between taking a goal and returning from plan.
+  // Only those delegates are stopped. A stop request that arrives after plan
+  // returned is cleared together with this flag, so that it never outlives
+  // the attempt it was meant for.
+  std::vector<bool> isPlanning(delegates.size(), false);
+
+  // Clears isPlanning of a worker. The caller must lock mutex.
+  auto finishAttempt = [&](std::size_t worker) {
+    isPlanning[worker] = false;
+    delegates[worker]->clearStopRequest();
+  };
+
+  // Stops the other delegates. The caller must lock mutex.
+  auto finish = [&](std::size_t worker) {
+    isDone = true;
+    goals.close();
+    for (std::size_t i = 0; i < delegates.size(); ++i)
+    {
+      if (i != worker && isPlanning[i])
+        delegates[i]->stopPlanning();
+    }
+  };
+
+  auto work = [&](std::size_t worker) {
+    const auto& delegate = delegates[worker];
+    auto goal = stateSpace->createState();
+
+    while (goals.pop(goal))
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isDone)
+          return;
+
+        isPlanning[worker] = true;
+      }
+
+      trajectory::TrajectoryPtr goalTrajectory;
+      try
+      {
+        auto context = contextPool.acquire();
+        if (!context->mConstraint)
+          throw std::invalid_argument("Planning context has no constraint.");
+
+        if (problemConstraint
+            && problemConstraint->getStateSpace()
+                   != context->mConstraint->getStateSpace())
+        {
+          throw std::invalid_argument(
+              "Constraint of the problem is not in the state space of the "
+              "constraint of the planning context.");
+        }
+
+        // NOTE: The problem clones the states, so it is created on the worker
+        // thread.
+        const ConfigurationToConfiguration problem(
+            stateSpace, startState, goal, context->mConstraint);
+        goalTrajectory = delegate->plan(problem, nullptr);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishAttempt(worker);
+        finish(worker);
+        throw;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      finishAttempt(worker);
+      if (goalTrajectory && !isDone)
+      {
+        trajectory = std::move(goalTrajectory);
+        finish(worker);
+      }
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(delegates.size());
+  for (std::size_t i = 0; i < delegates.size(); ++i)
+    futures.emplace_back(threadPool.submit([&work, i]() { work(i); }));
+
+  // Wait for all workers before rethrowing, since they refer to this frame.
+  for (auto& future : futures)
+    future.wait();
+  for (auto& future : futures)
+    future.get();
+
+  if (!trajectory && result)
+    result->setMessage("No goal configuration could be reached.");
+
+  return trajectory;
+}
+
+} // namespace detail
+} // namespace dart
+} // namespace planner
+} // namespace aikido
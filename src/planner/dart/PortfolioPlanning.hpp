@@ -0,0 +1,199 @@
+#ifndef AIKIDO_PLANNER_DART_PORTFOLIOPLANNING_HPP_
+#define AIKIDO_PLANNER_DART_PORTFOLIOPLANNING_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aikido/common/ThreadPool.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/ConfigurationToConfigurationPlanner.hpp"
+#include "aikido/planner/PlanningContextPool.hpp"
+#include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace aikido {
+namespace planner {
+namespace dart {
+namespace detail {
+
+/// Goal configurations handed out from best to worst, e.g. to the workers of
+/// planToConfigurationsConcurrently.
+class GoalQueue
+{
+public:
+  virtual ~GoalQueue() = default;
+
+  /// Removes the best goal, blocking until one is available.
+  /// \param[out] goal Removed goal.
+  /// \return False if no goal is left or \c close was called.
+  virtual bool pop(statespace::StateSpace::State* goal) = 0;
+
+  /// Makes all pending and later calls to \c pop return false.
+  virtual void close() = 0;
+};
+
+/// GoalQueue of goals that were ranked in advance.
+class RankedGoalQueue : public GoalQueue
+{
+public:
+  /// Constructor.
+  /// \param[in] stateSpace State space of \c goals.
+  /// \param[in] goals Goals from best to worst, which must outlive this queue.
+  RankedGoalQueue(
+      statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+      const std::vector<statespace::dart::MetaSkeletonStateSpace::ScopedState>&
+          goals);
+
+  // Documentation inherited.
+  bool pop(statespace::StateSpace::State* goal) override;
+
+  // Documentation inherited.
+  void close() override;
+
+private:
+  statespace::dart::ConstMetaSkeletonStateSpacePtr mStateSpace;
+  const std::vector<statespace::dart::MetaSkeletonStateSpace::ScopedState>&
+      mGoals;
+
+  /// Protects mNextGoal.
+  std::mutex mMutex;
+
+  /// Index of the next goal in mGoals.
+  std::size_t mNextGoal;
+};
+
+/// Bounded GoalQueue of goals that are pushed while others are popped, e.g. by
+/// a thread that samples goals. Goals are popped in increasing order of cost.
+class StreamingGoalQueue : public GoalQueue
+{
+public:
+  /// Constructor.
+  /// \param[in] stateSpace State space of the goals.
+  /// \param[in] capacity Maximum number of queued goals. When the queue is
+  /// full, the goal with the highest cost is discarded.
+  /// \throws invalid_argument if \c capacity is zero.
+  StreamingGoalQueue(
+      statespace::dart::ConstMetaSkeletonStateSpacePtr stateSpace,
+      std::size_t capacity);
+
+  /// Adds a goal.
+  /// \param[in] goal Goal to copy into the queue.
+  /// \param[in] cost Cost of \c goal, e.g. from ConfigurationRanker::getCost.
+  /// \return False if \c close was called, in which case no more goals are
+  /// needed.
+  bool push(const statespace::StateSpace::State* goal, double cost);
+
+  /// Indicates that no more goals will be pushed. Calls to \c pop return false
+  /// once the queued goals are popped.
+  void finish();
+
+  // Documentation inherited.
+  bool pop(statespace::StateSpace::State* goal) override;
+
+  // Documentation inherited.
+  void close() override;
+
+private:
+  statespace::dart::ConstMetaSkeletonStateSpacePtr mStateSpace;
+  std::size_t mCapacity;
+
+  /// Protects the members below.
+  std::mutex mMutex;
+
+  /// Notifies \c pop of new goals, of \c finish and of \c close.
+  std::condition_variable mCondition;
+
+  /// Queued goals by cost.
+  std::multimap<double, statespace::dart::MetaSkeletonStateSpace::ScopedState>
+      mGoals;
+
+  bool mIsFinished;
+  bool mIsClosed;
+};
+
+/// Calls \c delegateFactory \c numDelegates times.
+///
+/// \param[in] delegateFactory Function that creates a delegate planner.
+/// \param[in] numDelegates Number of delegate planners.
+/// \param[in] stateSpace State space the delegates must plan in.
+/// \return Delegate planners.
+/// \throws invalid_argument if \c delegateFactory is empty, \c numDelegates is
+/// zero, or a delegate is nullptr or plans in another state space.
+std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>
+createPortfolioDelegates(
+    const std::function<
+        std::shared_ptr<ConfigurationToConfigurationPlanner>()>&
+        delegateFactory,
+    std::size_t numDelegates,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace);
+
+/// Implements the setPortfolio functions of the planner adapters. Creates
+/// the delegates and thread pool of portfolio mode, or clears them if
+/// \c contextPool is nullptr.
+///
+/// \param[in] contextPool Pool of planning contexts, or nullptr to disable
+/// portfolio mode.
+/// \param[in] delegateFactory Function that creates a delegate planner.
+/// \param[in] numConcurrentGoals Number of delegate planners. If zero, the
+/// number of contexts of \c contextPool is used.
+/// \param[in] stateSpace State space the delegates must plan in.
+/// \param[out] portfolioContextPool Set to \c contextPool.
+/// \param[out] portfolioDelegates Set to the delegate planners.
+/// \param[out] portfolioThreadPool Set to a thread pool with one thread per
+/// delegate planner.
+/// \throws invalid_argument under the conditions of createPortfolioDelegates.
+void setPortfolio(
+    PlanningContextPoolPtr contextPool,
+    const std::function<
+        std::shared_ptr<ConfigurationToConfigurationPlanner>()>&
+        delegateFactory,
+    std::size_t numConcurrentGoals,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace,
+    PlanningContextPoolPtr& portfolioContextPool,
+    std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>&
+        portfolioDelegates,
+    std::unique_ptr<common::ThreadPool>& portfolioThreadPool);
+
+/// Plans from \c startState to the goals of \c goals, with one worker per
+/// delegate planner on \c threadPool.
+///
+/// Each worker pops the best goal that has not been attempted yet and plans
+/// to it with its delegate in a context checked out from \c contextPool,
+/// using the constraint of that context in place of \c problemConstraint.
+/// The first trajectory found is returned, \c goals is closed and the
+/// delegates still planning are stopped.
+///
+/// \param[in] threadPool Thread pool with at least one thread per delegate.
+/// \param[in] contextPool Pool of planning contexts, each with a constraint.
+/// \param[in] delegates Delegate planners, one per concurrent goal.
+/// \param[in] stateSpace State space of the delegates and of the contexts.
+/// \param[in] startState Start state.
+/// \param[in] goals Goals to plan to.
+/// \param[in] problemConstraint Constraint of the planned problem, which the
+/// constraints of the contexts replace. May be nullptr.
+/// \param[out] result Set to a failure message if no goal is reached.
+/// \return Trajectory to one of \c goals, or nullptr if none is reached.
+/// \throws invalid_argument if a context has no constraint, or if
+/// \c problemConstraint is not in the state space of the constraint of a
+/// context.
+trajectory::TrajectoryPtr planToConfigurationsConcurrently(
+    common::ThreadPool& threadPool,
+    PlanningContextPool& contextPool,
+    const std::vector<std::shared_ptr<ConfigurationToConfigurationPlanner>>&
+        delegates,
+    const statespace::dart::ConstMetaSkeletonStateSpacePtr& stateSpace,
+    const statespace::StateSpace::State* startState,
+    GoalQueue& goals,
+    const constraint::ConstTestablePtr& problemConstraint,
+    Planner::Result* result);
+
+} // namespace detail
+} // namespace dart
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_DART_PORTFOLIOPLANNING_HPP_
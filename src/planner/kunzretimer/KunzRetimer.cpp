@@ -1,6 +1,9 @@
 #include "aikido/planner/kunzretimer/KunzRetimer.hpp"
 
-#include "aikido/common/Spline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "aikido/common/StepSequence.hpp"
 #include "aikido/common/memory.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
@@ -21,6 +24,120 @@ namespace aikido {
 namespace planner {
 namespace kunzretimer {
 
+namespace {
+
+//==============================================================================
+/// Returns the coefficients of the cubic polynomial that starts at zero with
+/// velocity \c startVelocity and reaches \c displacement with velocity
+/// \c endVelocity after \c duration.
+Eigen::MatrixXd computeCubicCoefficients(
+    const Eigen::VectorXd& startVelocity,
+    const Eigen::VectorXd& displacement,
+    const Eigen::VectorXd& endVelocity,
+    double duration)
+{
+  Eigen::MatrixXd coefficients(startVelocity.size(), 4);
+  coefficients.col(0).setZero();
+  coefficients.col(1) = startVelocity;
+  coefficients.col(2)
+      = (3. * displacement - (2. * startVelocity + endVelocity) * duration)
+        / (duration * duration);
+  coefficients.col(3)
+      = ((startVelocity + endVelocity) * duration - 2. * displacement)
+        / (duration * duration * duration);
+  return coefficients;
+}
+
+//==============================================================================
+/// Returns true if the cubic polynomial between the samples \c first and
+/// \c last deviates from the samples in between by at most \c tolerance.
+bool isWithinTolerance(
+    const Eigen::MatrixXd& coefficients,
+    const std::vector<double>& times,
+    const Eigen::MatrixXd& positions,
+    std::size_t first,
+    std::size_t last,
+    double tolerance)
+{
+  for (std::size_t i = first + 1; i < last; ++i)
+  {
+    const double t = times[i] - times[first];
+    const Eigen::Vector4d powers(1., t, t * t, t * t * t);
+    const Eigen::VectorXd error
+        = coefficients * powers - (positions.col(i) - positions.col(first));
+    if (error.lpNorm<Eigen::Infinity>() > tolerance)
+      return false;
+  }
+  return true;
+}
+
+//==============================================================================
+/// Returns true if the velocity and acceleration of the cubic polynomial stay
+/// within \c maxVelocity and \c maxAcceleration over \c duration.
+bool isWithinLimits(
+    const Eigen::MatrixXd& coefficients,
+    double duration,
+    const Eigen::VectorXd& maxVelocity,
+    const Eigen::VectorXd& maxAcceleration)
+{
+  // Relative slack for the rounding errors of the fit and of the timing.
+  constexpr double kLimitTolerance = 1e-6;
+
+  for (int i = 0; i < coefficients.rows(); ++i)
+  {
+    const double c1 = coefficients(i, 1);
+    const double c2 = coefficients(i, 2);
+    const double c3 = coefficients(i, 3);
+    const double velocityLimit = maxVelocity[i] * (1. + kLimitTolerance);
+    const double accelerationLimit
+        = maxAcceleration[i] * (1. + kLimitTolerance);
+
+    // The acceleration is linear, so it peaks at an end of the segment.
+    if (std::abs(2. * c2) > accelerationLimit
+        || std::abs(2. * c2 + 6. * c3 * duration) > accelerationLimit)
+      return false;
+
+    // The velocity is quadratic, so it peaks at an end of the segment or
+    // where the acceleration is zero.
+    auto velocity = [&](double t) { return c1 + (2. * c2 + 3. * c3 * t) * t; };
+    if (std::abs(velocity(0.)) > velocityLimit
+        || std::abs(velocity(duration)) > velocityLimit)
+      return false;
+
+    if (c3 != 0.)
+    {
+      const double t = -c2 / (3. * c3);
+      if (t > 0. && t < duration && std::abs(velocity(t)) > velocityLimit)
+        return false;
+    }
+  }
+  return true;
+}
+
+//==============================================================================
+/// Returns the times of the steps of \c traj, offset by \c startTime, without
+/// steps closer than \c minStep to the previous one.
+std::vector<double> computeStepTimes(
+    const Trajectory& traj, double startTime, double minStep)
+{
+  const auto stepTimes = traj.getStepTimes();
+
+  std::vector<double> times;
+  times.reserve(stepTimes.size());
+  times.emplace_back(startTime);
+  for (std::size_t i = 1; i < stepTimes.size(); ++i)
+  {
+    const double time = startTime + stepTimes[i];
+    if (time - times.back() >= minStep)
+      times.emplace_back(time);
+    else if (i + 1 == stepTimes.size() && times.size() > 1)
+      times.back() = time;
+  }
+  return times;
+}
+
+} // namespace
+
 namespace detail {
 //==============================================================================
 std::unique_ptr<Path> convertToKunzPath(
@@ -44,7 +161,8 @@ std::unique_ptr<Path> convertToKunzPath(
   // auto trajectory = toR1JointTrajectory(traj);
   // auto stateSpace = trajectory->getStateSpace();
 
-  std::list<Eigen::VectorXd> waypoints;
+  std::vector<Eigen::VectorXd> waypoints;
+  waypoints.reserve(trajectory->getNumWaypoints());
   Eigen::VectorXd tmpVec(stateSpace->getDimension());
   for (std::size_t i = 0; i < trajectory->getNumWaypoints(); i++)
   {
@@ -61,11 +179,11 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
     const Trajectory& traj,
     aikido::statespace::ConstStateSpacePtr stateSpace,
     double timeStep,
-    double startTime)
+    double startTime,
+    double splineTolerance,
+    const Eigen::VectorXd& maxVelocity,
+    const Eigen::VectorXd& maxAcceleration)
 {
-  using CubicSplineProblem = aikido::common::
-      SplineProblem<double, int, 4, Eigen::Dynamic, Eigen::Dynamic>;
-
   std::size_t dimension = stateSpace->getDimension();
   double endTime = startTime + traj.getDuration();
 
@@ -74,35 +192,93 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
       = ::aikido::common::make_unique<aikido::trajectory::Spline>(
           stateSpace, startTime);
 
-  // create a sequence of time steps from start time to end time by time step
-  aikido::common::StepSequence sequence(
-      timeStep, true, true, startTime, endTime);
+  std::vector<double> times;
+  if (splineTolerance > 0.)
+  {
+    // Segments end at steps of the timed path, whose path acceleration is
+    // constant in between, so no segment straddles a switching point.
+    times = computeStepTimes(traj, startTime, 1e-3 * timeStep);
+  }
+  else
+  {
+    // create a sequence of time steps from start time to end time
+    aikido::common::StepSequence sequence(
+        timeStep, true, true, startTime, endTime);
+    times.reserve(sequence.getLength());
+    for (std::size_t i = 0; i < sequence.getLength(); ++i)
+      times.emplace_back(sequence[i]);
+  }
+  const std::size_t numSteps = times.size();
+
+  // Sample each time step once, since segments may span several steps.
+  Eigen::MatrixXd positions(dimension, numSteps);
+  Eigen::MatrixXd velocities(dimension, numSteps);
+  for (std::size_t i = 0; i < numSteps; ++i)
+  {
+    positions.col(i) = traj.getPosition(times[i] - startTime);
+    velocities.col(i) = traj.getVelocity(times[i] - startTime);
+  }
+
+  auto fitSegment = [&](std::size_t first, std::size_t last) {
+    return computeCubicCoefficients(
+        velocities.col(first),
+        positions.col(last) - positions.col(first),
+        velocities.col(last),
+        times[last] - times[first]);
+  };
+
+  // A segment spanning several steps must fit the samples in between, and
+  // must not exceed the limits that the timed path respects.
+  auto fits = [&](std::size_t first, std::size_t last) {
+    const auto coefficients = fitSegment(first, last);
+    return isWithinTolerance(
+               coefficients, times, positions, first, last, splineTolerance)
+           && isWithinLimits(
+                  coefficients,
+                  times[last] - times[first],
+                  maxVelocity,
+                  maxAcceleration);
+  };
 
-  const Eigen::VectorXd zeroPosition = Eigen::VectorXd::Zero(dimension);
   auto currState = stateSpace->createState();
-  for (std::size_t i = 0; i < sequence.getLength() - 1; i++)
+  std::size_t first = 0;
+  while (first + 1 < numSteps)
   {
-    double currT = sequence[i];
-    double nextT = sequence[i + 1];
-    double segmentDuration = nextT - currT;
-    double currTShift = currT - startTime;
-    double nextTShift = nextT - startTime;
-    Eigen::VectorXd currentPosition = traj.getPosition(currTShift);
-    Eigen::VectorXd nextPosition = traj.getPosition(nextTShift);
-    Eigen::VectorXd currentVelocity = traj.getVelocity(currTShift);
-    Eigen::VectorXd nextVelocity = traj.getVelocity(nextTShift);
-
-    CubicSplineProblem problem(
-        Eigen::Vector2d{0., segmentDuration}, 4, dimension);
-    problem.addConstantConstraint(0, 0, zeroPosition);
-    problem.addConstantConstraint(0, 1, currentVelocity);
-    problem.addConstantConstraint(1, 0, nextPosition - currentPosition);
-    problem.addConstantConstraint(1, 1, nextVelocity);
-    const auto solution = problem.fit();
-    const auto coefficients = solution.getCoefficients().front();
-
-    stateSpace->expMap(currentPosition, currState);
-    outputTrajectory->addSegment(coefficients, segmentDuration, currState);
+    std::size_t last = first + 1;
+    if (splineTolerance > 0.)
+    {
+      // Double the number of steps in the segment until it no longer fits,
+      // then bisect between the longest segment that fits and the shortest
+      // one that does not.
+      std::size_t longestFit = last;
+      std::size_t shortestMisfit = numSteps;
+      for (std::size_t numSegmentSteps = 2; longestFit + 1 < numSteps;
+           numSegmentSteps *= 2)
+      {
+        const auto candidate = std::min(first + numSegmentSteps, numSteps - 1);
+        if (!fits(first, candidate))
+        {
+          shortestMisfit = candidate;
+          break;
+        }
+        longestFit = candidate;
+      }
+
+      while (shortestMisfit - longestFit > 1)
+      {
+        const auto candidate = longestFit + (shortestMisfit - longestFit) / 2;
+        if (fits(first, candidate))
+          longestFit = candidate;
+        else
+          shortestMisfit = candidate;
+      }
+      last = longestFit;
+    }
+
+    stateSpace->expMap(positions.col(first), currState);
+    outputTrajectory->addSegment(
+        fitSegment(first, last), times[last] - times[first], currState);
+    first = last;
   }
 
   return outputTrajectory;
@@ -116,7 +292,8 @@ std::unique_ptr<aikido::trajectory::Spline> computeKunzTiming(
     const Eigen::VectorXd& maxVelocity,
     const Eigen::VectorXd& maxAcceleration,
     double maxDeviation,
-    double timeStep)
+    double timeStep,
+    double splineTolerance)
 {
   const auto stateSpace = inputTrajectory.getStateSpace();
   const auto dimension = stateSpace->getDimension();
@@ -140,10 +317,20 @@ std::unique_ptr<aikido::trajectory::Spline> computeKunzTiming(
       throw std::invalid_argument("Acceleration limits must be finite.");
   }
 
+  if (splineTolerance < 0.)
+    throw std::invalid_argument("Spline tolerance must be non-negative.");
+
   double startTime = inputTrajectory.getStartTime();
   auto path = detail::convertToKunzPath(inputTrajectory, maxDeviation);
   Trajectory trajectory(*path, maxVelocity, maxAcceleration, timeStep);
-  return detail::convertToSpline(trajectory, stateSpace, timeStep, startTime);
+  return detail::convertToSpline(
+      trajectory,
+      stateSpace,
+      timeStep,
+      startTime,
+      splineTolerance,
+      maxVelocity,
+      maxAcceleration);
 }
 
 //==============================================================================
@@ -151,11 +338,13 @@ KunzRetimer::KunzRetimer(
     const Eigen::VectorXd& velocityLimits,
     const Eigen::VectorXd& accelerationLimits,
     double maxDeviation,
-    double timeStep)
+    double timeStep,
+    double splineTolerance)
   : mVelocityLimits{velocityLimits}
   , mAccelerationLimits{accelerationLimits}
   , mMaxDeviation(maxDeviation)
   , mTimeStep(timeStep)
+  , mSplineTolerance(splineTolerance)
 {
   // Do nothing
 }
@@ -169,6 +358,7 @@ KunzRetimer::KunzRetimer(
   , mAccelerationLimits{accelerationLimits}
   , mMaxDeviation(params.mMaxDeviation)
   , mTimeStep(params.mTimeStep)
+  , mSplineTolerance(params.mSplineTolerance)
 {
   // Do nothing
 }
@@ -184,7 +374,8 @@ std::unique_ptr<aikido::trajectory::Spline> KunzRetimer::postprocess(
       mVelocityLimits,
       mAccelerationLimits,
       mMaxDeviation,
-      mTimeStep);
+      mTimeStep,
+      mSplineTolerance);
 }
 
 //==============================================================================
@@ -246,6 +437,18 @@ void KunzRetimer::setMaxDeviation(double maxDeviation)
   mMaxDeviation = maxDeviation;
 }
 
+//==============================================================================
+double KunzRetimer::getSplineTolerance() const
+{
+  return mSplineTolerance;
+}
+
+//==============================================================================
+void KunzRetimer::setSplineTolerance(double splineTolerance)
+{
+  mSplineTolerance = splineTolerance;
+}
+
 } // namespace kunzretimer
 } // namespace planner
 } // namespace aikido
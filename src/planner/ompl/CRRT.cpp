@@ -1,11 +1,13 @@
 #include "aikido/planner/ompl/CRRT.hpp"
 
 #include <limits>
+#include <new>
 
 #include <ompl/base/goals/GoalSampleableRegion.h>
 #include <ompl/tools/config/SelfConfig.h>
 
 #include "aikido/planner/ompl/GeometricStateSpace.hpp"
+#include "aikido/planner/ompl/MotionValidator.hpp"
 
 namespace aikido {
 namespace planner {
@@ -26,6 +28,7 @@ CRRT::CRRT(
   , mMaxStepsize(0.1)
   , mMaxProjectedStepsizeSlackFactor(2.0)
   , mMinStepsize(1e-4)
+  , mLazyValidation(false)
 {
 
   auto ss
@@ -61,6 +64,12 @@ CRRT::CRRT(
       &CRRT::setMinStateDifference,
       &CRRT::getMinStateDifference,
       "0.:1.:10000.");
+  Planner::declareParam<bool>(
+      "lazy_validation",
+      this,
+      &CRRT::setLazyValidation,
+      &CRRT::getLazyValidation,
+      "0,1");
 }
 
 //==============================================================================
@@ -183,6 +192,18 @@ double CRRT::getMinStateDifference() const
   return mMinStepsize;
 }
 
+//==============================================================================
+void CRRT::setLazyValidation(bool _lazy)
+{
+  mLazyValidation = _lazy;
+}
+
+//==============================================================================
+bool CRRT::getLazyValidation() const
+{
+  return mLazyValidation;
+}
+
 //==============================================================================
 void CRRT::setup()
 {
@@ -203,19 +224,25 @@ void CRRT::setup()
 //==============================================================================
 void CRRT::freeMemory()
 {
-  if (mStartTree)
-  {
-    std::vector<Motion*> motions;
-    mStartTree->list(motions);
-    for (std::size_t i = 0; i < motions.size(); ++i)
-    {
-      if (motions[i]->state)
-      {
-        si_->freeState(motions[i]->state);
-      }
-      delete motions[i];
-    }
-  }
+  // The motions of all trees and their states live in mMotionArena, so they
+  // are released at once instead of one by one.
+  mMotionArena.release();
+}
+
+//==============================================================================
+CRRT::Motion* CRRT::allocMotion()
+{
+  auto ss = static_cast<GeometricStateSpace*>(si_->getStateSpace().get());
+  auto stateSpace = ss->getAikidoStateSpace();
+
+  auto state = stateSpace->allocateStateInBuffer(
+      mMotionArena.allocate(stateSpace->getStateSizeInBytes()));
+
+  auto motion = new (mMotionArena.allocate(sizeof(Motion))) Motion();
+  motion->state
+      = new (mMotionArena.allocate(sizeof(GeometricStateSpace::StateType)))
+          GeometricStateSpace::StateType(state);
+  return motion;
 }
 
 //==============================================================================
@@ -229,7 +256,7 @@ void CRRT::freeMemory()
 
   while (const ::ompl::base::State* st = pis_.nextStart())
   {
-    Motion* motion = new Motion(si_);
+    Motion* motion = allocMotion();
     si_->copyState(motion->state, st);
     mStartTree->add(motion);
   }
@@ -280,12 +307,30 @@ void CRRT::freeMemory()
         false,
         bestdist,
         foundgoal);
-    if (foundgoal)
+    if (foundgoal && mLazyValidation)
+    {
+      std::vector<Motion*> mpath;
+      for (Motion* m = bestmotion; m != nullptr; m = m->parent)
+        mpath.push_back(m);
+
+      Motion* invalidMotion = nullptr;
+      if (validatePath(_ptc, mpath, invalidMotion))
+      {
+        solution = bestmotion;
+        break;
+      }
+
+      // Drop the invalid part of the tree and keep planning
+      if (invalidMotion)
+        removeSubtree(mStartTree, invalidMotion);
+      foundgoal = false;
+    }
+    else if (foundgoal)
     {
       solution = bestmotion;
       break;
     }
-    else if (bestdist < approxdif)
+    else if (!mLazyValidation && bestdist < approxdif)
     {
       approxdif = bestdist;
       approxsol = bestmotion;
@@ -389,12 +434,23 @@ CRRT::Motion* CRRT::constrainedExtend(
       break;
     }
 
-    if (si_->checkMotion(cmotion->state, xstate))
+    // In lazy mode, only the endpoint of the step is checked here. The rest
+    // of the step is checked by validatePath.
+    bool valid = mLazyValidation ? si_->isValid(xstate)
+                                 : si_->checkMotion(cmotion->state, xstate);
+    if (valid)
     {
       // Add the motion to the tree
-      Motion* motion = new Motion(si_);
+      Motion* motion = allocMotion();
       si_->copyState(motion->state, xstate);
       motion->parent = cmotion;
+      if (mLazyValidation)
+      {
+        // The first two points checked on an edge are its endpoints, which
+        // are both known to be valid.
+        motion->numCheckedPoints = 2;
+        motion->validated = false;
+      }
       tree->add(motion);
 
       cmotion = motion;
@@ -430,6 +486,109 @@ CRRT::Motion* CRRT::constrainedExtend(
   return bestmotion;
 }
 
+//==============================================================================
+bool CRRT::validatePath(
+    const ::ompl::base::PlannerTerminationCondition& ptc,
+    const std::vector<Motion*>& path,
+    Motion*& invalidMotion)
+{
+  invalidMotion = nullptr;
+
+  std::vector<Motion*> edges;
+  for (Motion* motion : path)
+  {
+    if (motion->parent && !motion->validated)
+      edges.push_back(motion);
+  }
+
+  const auto validator = dynamic_cast<const MotionValidator*>(
+      si_->getMotionValidator().get());
+  if (!validator)
+  {
+    // Partially validated edges can't be resumed, so check each edge fully.
+    for (Motion* motion : edges)
+    {
+      if (ptc)
+        return false;
+
+      if (!si_->checkMotion(motion->parent->state, motion->state))
+      {
+        invalidMotion = motion;
+        return false;
+      }
+      motion->validated = true;
+    }
+    return true;
+  }
+
+  std::vector<std::size_t> numPoints;
+  numPoints.reserve(edges.size());
+  for (Motion* motion : edges)
+  {
+    numPoints.push_back(
+        validator->getNumCheckPoints(motion->parent->state, motion->state));
+  }
+
+  bool unfinished = true;
+  while (unfinished)
+  {
+    unfinished = false;
+    for (std::size_t i = 0; i < edges.size(); ++i)
+    {
+      Motion* motion = edges[i];
+      if (motion->validated)
+        continue;
+
+      if (ptc)
+        return false;
+
+      if (!validator->checkMotionIncrementally(
+              motion->parent->state,
+              motion->state,
+              motion->numCheckedPoints,
+              1))
+      {
+        invalidMotion = motion;
+        return false;
+      }
+
+      if (motion->numCheckedPoints >= numPoints[i])
+        motion->validated = true;
+      else
+        unfinished = true;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+void CRRT::removeSubtree(TreeData& tree, Motion* motion)
+{
+  std::vector<Motion*> motions;
+  tree->list(motions);
+
+  std::vector<Motion*> subtree;
+  for (Motion* m : motions)
+  {
+    for (Motion* ancestor = m; ancestor != nullptr; ancestor = ancestor->parent)
+    {
+      if (ancestor == motion)
+      {
+        subtree.push_back(m);
+        break;
+      }
+    }
+  }
+
+  for (Motion* m : subtree)
+  {
+    tree->remove(m);
+    if (m == mLastGoalMotion)
+      mLastGoalMotion = nullptr;
+  }
+}
+
 //==============================================================================
 ::ompl::base::PlannerStatus CRRT::solve(double solveTime)
 {
@@ -1,5 +1,7 @@
 #include "aikido/planner/ompl/CRRTConnect.hpp"
 
+#include <algorithm>
+
 #include <ompl/base/goals/GoalSampleableRegion.h>
 #include <ompl/tools/config/SelfConfig.h>
 
@@ -56,24 +58,6 @@ void CRRTConnect::setup()
       OMPL_PLACEHOLDER(_2)));
 }
 
-//==============================================================================
-void CRRTConnect::freeMemory()
-{
-  CRRT::freeMemory();
-
-  if (mGoalTree)
-  {
-    std::vector<Motion*> motions;
-    mGoalTree->list(motions);
-    for (std::size_t i = 0; i < motions.size(); ++i)
-    {
-      if (motions[i]->state)
-        si_->freeState(motions[i]->state);
-      delete motions[i];
-    }
-  }
-}
-
 //==============================================================================
 void CRRTConnect::clear()
 {
@@ -125,7 +109,7 @@ double CRRTConnect::getConnectionRadius() const
 
   while (const ::ompl::base::State* st = pis_.nextStart())
   {
-    Motion* motion = new Motion(si_);
+    Motion* motion = allocMotion();
     si_->copyState(motion->state, st);
     mStartTree->add(motion);
   }
@@ -167,7 +151,7 @@ double CRRTConnect::getConnectionRadius() const
         const ::ompl::base::State* st = pis_.nextGoal(_ptc);
         if (si_->isValid(st))
         {
-          Motion* motion = new Motion(si_);
+          Motion* motion = allocMotion();
           si_->copyState(motion->state, st);
           mGoalTree->add(motion);
         }
@@ -232,8 +216,6 @@ double CRRTConnect::getConnectionRadius() const
           goalMotion = goalMotion->parent;
       }
 
-      mConnectionPoint = std::make_pair(startMotion->state, goalMotion->state);
-
       /* construct the solution path */
       Motion* solution = startMotion;
       std::vector<Motion*> mpath1;
@@ -259,6 +241,33 @@ double CRRTConnect::getConnectionRadius() const
           continue;
       }
 
+      if (mLazyValidation)
+      {
+        // The motions at the connection are validated even if one of them was
+        // skipped above, since the path still follows the edge leading to it.
+        std::vector<Motion*> startPath(mpath1);
+        startPath.push_back(startTree ? newmotion : lastmotion);
+        std::vector<Motion*> mpath(startPath);
+        mpath.insert(mpath.end(), mpath2.begin(), mpath2.end());
+        mpath.push_back(startTree ? lastmotion : newmotion);
+
+        Motion* invalidMotion = nullptr;
+        if (!validatePath(_ptc, mpath, invalidMotion))
+        {
+          // Drop the invalid part of the tree and keep planning
+          if (invalidMotion)
+          {
+            const bool inStartTree
+                = std::find(startPath.begin(), startPath.end(), invalidMotion)
+                  != startPath.end();
+            removeSubtree(inStartTree ? mStartTree : mGoalTree, invalidMotion);
+          }
+          continue;
+        }
+      }
+
+      mConnectionPoint = std::make_pair(startMotion->state, goalMotion->state);
+
       auto path = ompl_make_shared<::ompl::geometric::PathGeometric>(si_);
       path->getStates().reserve(mpath1.size() + mpath2.size());
       for (int i = mpath1.size() - 1; i >= 0; --i)
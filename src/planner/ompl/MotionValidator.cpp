@@ -90,6 +90,54 @@ bool MotionValidator::checkMotion(
 
   return valid;
 }
+
+bool MotionValidator::checkMotionIncrementally(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    std::size_t& _numCheckedPoints,
+    std::size_t _maxNumChecks) const
+{
+  const double minResolution = mSequenceResolution / si_->distance(_s1, _s2);
+  aikido::common::VanDerCorput vdc{1,
+                                   true,
+                                   true, // include endpoints
+                                   minResolution};
+
+  auto stateSpace = si_->getStateSpace();
+  auto iState = stateSpace->allocState();
+
+  bool valid = true;
+  for (std::size_t i = 0; i < _maxNumChecks; ++i)
+  {
+    // The sequence ends with the first point that reaches the resolution.
+    if (_numCheckedPoints > 0
+        && vdc[_numCheckedPoints - 1].second <= minResolution)
+    {
+      break;
+    }
+
+    stateSpace->interpolate(_s1, _s2, vdc[_numCheckedPoints].first, iState);
+    if (!si_->isValid(iState))
+    {
+      valid = false;
+      break;
+    }
+    ++_numCheckedPoints;
+  }
+  stateSpace->freeState(iState);
+  return valid;
+}
+
+std::size_t MotionValidator::getNumCheckPoints(
+    const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const
+{
+  double dist = si_->distance(_s1, _s2);
+  aikido::common::VanDerCorput vdc{1,
+                                   true,
+                                   true, // include endpoints
+                                   mSequenceResolution / dist};
+  return vdc.getLength();
+}
 } // namespace ompl
 } // namespace planner
 } // namespace aikido
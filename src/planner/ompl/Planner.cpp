@@ -219,7 +219,8 @@ trajectory::InterpolatedPtr planCRRT(
     double _maxPlanTime,
     double _maxExtensionDistance,
     double _maxDistanceBtwProjections,
-    double _minStepsize)
+    double _minStepsize,
+    bool _lazyValidation)
 {
   if (_trajConstraint == nullptr)
   {
@@ -279,6 +280,7 @@ trajectory::InterpolatedPtr planCRRT(
   planner->setRange(_maxExtensionDistance);
   planner->setProjectionResolution(_maxDistanceBtwProjections);
   planner->setMinStateDifference(_minStepsize);
+  planner->setLazyValidation(_lazyValidation);
   return planOMPL(
       planner,
       pdef,
@@ -304,7 +306,8 @@ trajectory::InterpolatedPtr planCRRTConnect(
     double _maxExtensionDistance,
     double _maxDistanceBtwProjections,
     double _minStepsize,
-    double _minTreeConnectionDistance)
+    double _minTreeConnectionDistance,
+    bool _lazyValidation)
 {
   if (_trajConstraint == nullptr)
   {
@@ -370,6 +373,7 @@ trajectory::InterpolatedPtr planCRRTConnect(
   planner->setProjectionResolution(_maxDistanceBtwProjections);
   planner->setConnectionRadius(_minTreeConnectionDistance);
   planner->setMinStateDifference(_minStepsize);
+  planner->setLazyValidation(_lazyValidation);
   return planOMPL(
       planner,
       pdef,
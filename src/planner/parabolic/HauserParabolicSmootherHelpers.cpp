@@ -1,9 +1,14 @@
 #include "HauserParabolicSmootherHelpers.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <future>
+#include <memory>
+#include <stdexcept>
 
 #include "aikido/common/VanDerCorput.hpp"
+#include "aikido/common/memory.hpp"
 
 #include "Config.h"
 #include "HauserMath.h"
@@ -16,61 +21,133 @@ namespace planner {
 namespace parabolic {
 namespace detail {
 
+namespace {
+
+/// Number of states of a segment that SegmentFeasible() interpolates and
+/// tests at once. Smaller chunks stop earlier at a failure, larger chunks
+/// leave more states for a batch Testable to test concurrently.
+constexpr std::size_t kSegmentCheckChunkSize = 8;
+
+} // namespace
+
+/// Feasibility checker that tests configurations and segments of a
+/// DynamicPath with a Testable. All states are allocated on construction, so
+/// checks do not allocate states. Each instance must only be used by one
+/// thread at a time.
 class SmootherFeasibilityCheckerBase
   : public ParabolicRamp::FeasibilityCheckerBase
 {
 public:
+  /// \param testable Testable that configurations must satisfy.
+  /// \param checkResolution Resolution of the segment checks.
+  /// \param useBatch Whether segments are tested with
+  /// Testable::isSatisfiedBatch(). Set this to false if the checker already
+  /// runs on a worker thread, so that the Testable does not start more.
   SmootherFeasibilityCheckerBase(
-      aikido::constraint::TestablePtr testable, double checkResolution)
+      aikido::constraint::TestablePtr testable,
+      double checkResolution,
+      bool useBatch = true)
     : mTestable(std::move(testable))
-    , mCheckResolution(checkResolution)
     , mStateSpace(mTestable->getStateSpace())
     , mInterpolator(mStateSpace)
+    , mUseBatch(useBatch)
+    , mPosition(mStateSpace->getDimension())
+    , mState(mStateSpace->createState())
+    , mStartState(mStateSpace->createState())
+    , mGoalState(mStateSpace->createState())
   {
-    // Do nothing
+    // both ends of the segment have already been checked by calling
+    // ConfigFeasible(),
+    // thus it is no longer needed to check in SegmentFeasible()
+    const aikido::common::VanDerCorput vdc{1, false, false, checkResolution};
+    for (const auto alpha : vdc)
+      mAlphas.push_back(alpha);
+
+    if (!mUseBatch)
+      return;
+
+    const auto chunkSize = std::min(kSegmentCheckChunkSize, mAlphas.size());
+    mSegmentStates.reserve(chunkSize);
+    mSegmentStatePointers.reserve(chunkSize);
+    for (std::size_t i = 0; i < chunkSize; ++i)
+      mSegmentStates.emplace_back(mStateSpace->createState());
   }
 
   bool ConfigFeasible(const ParabolicRamp::Vector& x) override
   {
-    Eigen::VectorXd eigX = toEigen(x);
-    auto state = mStateSpace->createState();
-    mStateSpace->expMap(eigX, state);
-    return mTestable->isSatisfied(state);
+    setState(x, mState);
+    return mTestable->isSatisfied(mState);
   }
 
   bool SegmentFeasible(
       const ParabolicRamp::Vector& a, const ParabolicRamp::Vector& b) override
   {
-    Eigen::VectorXd eigA = toEigen(a);
-    Eigen::VectorXd eigB = toEigen(b);
-
-    auto testState = mStateSpace->createState();
-    auto startState = mStateSpace->createState();
-    auto goalState = mStateSpace->createState();
-    mStateSpace->expMap(eigA, startState);
-    mStateSpace->expMap(eigB, goalState);
+    setState(a, mStartState);
+    setState(b, mGoalState);
 
-    // both ends of the segment have already been checked by calling
-    // ConfigFeasible(),
-    // thus it is no longer needed to check in SegmentFeasible()
-    aikido::common::VanDerCorput vdc{1, false, false, mCheckResolution};
+    // The states are tested in Van der Corput order, so collisions in the
+    // middle of the segment are found early.
+    if (!mUseBatch)
+    {
+      for (const auto alpha : mAlphas)
+      {
+        mInterpolator.interpolate(mStartState, mGoalState, alpha, mState);
+        if (!mTestable->isSatisfied(mState))
+          return false;
+      }
+      return true;
+    }
 
-    for (const auto alpha : vdc)
+    // Interpolate and test one chunk at a time, so that no more states are
+    // interpolated after a chunk fails.
+    for (std::size_t begin = 0; begin < mAlphas.size();
+         begin += mSegmentStates.size())
     {
-      mInterpolator.interpolate(startState, goalState, alpha, testState);
-      if (!mTestable->isSatisfied(testState))
+      const auto end = std::min(begin + mSegmentStates.size(), mAlphas.size());
+
+      mSegmentStatePointers.clear();
+      for (std::size_t i = begin; i < end; ++i)
       {
-        return false;
+        auto& state = mSegmentStates[i - begin];
+        mInterpolator.interpolate(mStartState, mGoalState, mAlphas[i], state);
+        mSegmentStatePointers.emplace_back(state);
       }
+
+      std::size_t firstFailure;
+      mTestable->isSatisfiedBatch(mSegmentStatePointers, &firstFailure);
+      if (firstFailure != mSegmentStatePointers.size())
+        return false;
     }
     return true;
   }
 
 private:
+  /// Sets \c state to the configuration \c x without allocating.
+  void setState(
+      const ParabolicRamp::Vector& x,
+      aikido::statespace::StateSpace::State* state)
+  {
+    mPosition = Eigen::Map<const Eigen::VectorXd>(x.data(), x.size());
+    mStateSpace->expMap(mPosition, state);
+  }
+
   aikido::constraint::TestablePtr mTestable;
-  double mCheckResolution;
   aikido::statespace::ConstStateSpacePtr mStateSpace;
   aikido::statespace::GeodesicInterpolator mInterpolator;
+  bool mUseBatch;
+
+  /// Interpolation parameters of the states tested by SegmentFeasible().
+  std::vector<double> mAlphas;
+
+  Eigen::VectorXd mPosition;
+  aikido::statespace::StateSpace::ScopedState mState;
+  aikido::statespace::StateSpace::ScopedState mStartState;
+  aikido::statespace::StateSpace::ScopedState mGoalState;
+
+  /// States of one chunk tested by SegmentFeasible() if mUseBatch is true.
+  std::vector<aikido::statespace::StateSpace::ScopedState> mSegmentStates;
+  std::vector<const aikido::statespace::StateSpace::State*>
+      mSegmentStatePointers;
 };
 
 bool needsBlend(const ParabolicRamp::ParabolicRampND& rampNd)
@@ -165,6 +242,131 @@ bool doShortcut(
   return success;
 }
 
+bool doShortcut(
+    ParabolicRamp::DynamicPath& dynamicPath,
+    aikido::common::ThreadPool& threadPool,
+    const std::vector<aikido::constraint::TestablePtr>& testables,
+    std::size_t numCandidates,
+    double timelimit,
+    double checkResolution,
+    double tolerance,
+    aikido::common::RNG& rng)
+{
+  if (testables.empty())
+    throw std::invalid_argument("Testables should not be empty");
+  if (numCandidates == 0u)
+    throw std::invalid_argument("Number of candidates should be positive");
+  for (const auto& testable : testables)
+  {
+    if (!testable)
+      throw std::invalid_argument("Testable should not be nullptr");
+  }
+  if (timelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (checkResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (tolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  // One task per testable, each of which checks every numTasks-th candidate,
+  // so that no testable is shared between threads.
+  const std::size_t numTasks = std::min(testables.size(), numCandidates);
+
+  // One checker per task. The checkers already run on the workers of
+  // threadPool, so they test each state on their own thread rather than in
+  // batches.
+  std::vector<std::unique_ptr<SmootherFeasibilityCheckerBase>> bases;
+  std::vector<ParabolicRamp::RampFeasibilityChecker> feasibilityCheckers;
+  bases.reserve(numTasks);
+  feasibilityCheckers.reserve(numTasks);
+  for (std::size_t k = 0; k < numTasks; ++k)
+  {
+    bases.emplace_back(
+        ::aikido::common::make_unique<SmootherFeasibilityCheckerBase>(
+            testables[k], checkResolution, false));
+    feasibilityCheckers.emplace_back(bases.back().get(), tolerance);
+  }
+
+  std::vector<ParabolicRamp::DynamicPathShortcut> shortcuts(numCandidates);
+  std::vector<double> times1(numCandidates);
+  std::vector<double> times2(numCandidates);
+  std::vector<std::future<void>> futures;
+  futures.reserve(numTasks);
+  std::vector<char> isFeasible(numCandidates);
+  std::vector<std::size_t> committed;
+  committed.reserve(numCandidates);
+
+  std::chrono::time_point<std::chrono::system_clock> startTime
+      = std::chrono::system_clock::now();
+  double elapsedTime = 0;
+
+  bool success = false;
+  while (elapsedTime < timelimit && dynamicPath.ramps.size() > 3)
+  {
+    std::uniform_real_distribution<> dist(0.0, dynamicPath.GetTotalTime());
+    for (std::size_t i = 0; i < numCandidates; ++i)
+    {
+      times1[i] = dist(rng);
+      times2[i] = dist(rng);
+    }
+
+    // The path is only read until all candidates are checked.
+    futures.clear();
+    for (std::size_t k = 0; k < numTasks; ++k)
+    {
+      futures.emplace_back(threadPool.submit([&, k]() {
+        for (std::size_t i = k; i < numCandidates; i += numTasks)
+        {
+          isFeasible[i]
+              = dynamicPath.PlanShortcut(times1[i], times2[i], shortcuts[i])
+                && dynamicPath.CheckShortcut(
+                       shortcuts[i], feasibilityCheckers[k]);
+        }
+      }));
+    }
+
+    // Wait for all candidates before rethrowing, since they refer to this
+    // frame.
+    for (auto& future : futures)
+      future.wait();
+    for (auto& future : futures)
+      future.get();
+
+    committed.clear();
+    for (std::size_t i = 0; i < numCandidates; ++i)
+    {
+      if (!isFeasible[i])
+        continue;
+
+      const auto& shortcut = shortcuts[i];
+      const bool overlaps = std::any_of(
+          committed.begin(), committed.end(), [&](std::size_t j) {
+            return shortcut.i1 <= shortcuts[j].i2
+                   && shortcuts[j].i1 <= shortcut.i2;
+          });
+      if (!overlaps)
+        committed.push_back(i);
+    }
+
+    // Applying the shortcuts from the end of the path keeps the ramp indices
+    // of the remaining ones valid.
+    std::sort(
+        committed.begin(), committed.end(), [&](std::size_t i, std::size_t j) {
+          return shortcuts[i].i1 > shortcuts[j].i1;
+        });
+    for (const auto i : committed)
+      dynamicPath.ApplyShortcut(shortcuts[i]);
+
+    if (!committed.empty())
+      success = true;
+
+    elapsedTime = std::chrono::duration_cast<std::chrono::duration<double>>(
+                      std::chrono::system_clock::now() - startTime)
+                      .count();
+  }
+  return success;
+}
+
 bool doBlend(
     ParabolicRamp::DynamicPath& dynamicPath,
     aikido::constraint::TestablePtr testable,
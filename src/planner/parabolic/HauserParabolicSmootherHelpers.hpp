@@ -1,7 +1,9 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 
+#include <vector>
 #include <Eigen/Dense>
+#include "aikido/common/ThreadPool.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
 #include "aikido/constraint/Testable.hpp"
@@ -18,6 +20,38 @@ namespace detail {
                   double checkResolution, double tolerance,
                   aikido::common::RNG& rng);
 
+  /// Shortcuts \c dynamicPath like the other overload of doShortcut, but
+  /// checks several candidate shortcuts concurrently on \c threadPool.
+  ///
+  /// In each round, \c numCandidates pairs of times are drawn from \c rng,
+  /// and the shortcuts between them are planned against the current path and
+  /// checked in parallel, one task per testable, which checks every
+  /// \c testables.size()-th candidate. The feasible shortcuts are then
+  /// committed in the order they were drawn, skipping those that share a ramp
+  /// with a shortcut committed earlier in the round. The result thus depends
+  /// only on \c rng, on \c numCandidates and on the number of rounds, and not
+  /// on the number of testables.
+  ///
+  /// \param dynamicPath path to shortcut
+  /// \param threadPool thread pool to check the shortcuts on
+  /// \param testables equivalent testables to check the shortcuts with, each
+  /// of which is used by at most one thread at a time
+  /// \param numCandidates number of candidate shortcuts per round
+  /// \param timelimit time limit in seconds
+  /// \param checkResolution resolution of the segment checks
+  /// \param tolerance tolerance of the piecewise linear ramp approximation
+  /// \param rng random number generator
+  /// \return True if at least one shortcut was committed.
+  /// \throws invalid_argument if \c testables is empty or contains nullptr,
+  /// or if \c numCandidates is zero.
+  bool doShortcut(ParabolicRamp::DynamicPath& dynamicPath,
+                  aikido::common::ThreadPool& threadPool,
+                  const std::vector<aikido::constraint::TestablePtr>& testables,
+                  std::size_t numCandidates,
+                  double timelimit,
+                  double checkResolution, double tolerance,
+                  aikido::common::RNG& rng);
+
   bool doBlend(ParabolicRamp::DynamicPath& dynamicPath,
                aikido::constraint::TestablePtr testable,
                double blendRadius, int blendIterations,
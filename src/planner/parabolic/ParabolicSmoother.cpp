@@ -1,7 +1,9 @@
 #include "aikido/planner/parabolic/ParabolicSmoother.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <set>
+#include <stdexcept>
 
 #include "aikido/common/Spline.hpp"
 #include "aikido/common/memory.hpp"
@@ -45,6 +47,40 @@ std::unique_ptr<aikido::trajectory::Spline> doShortcut(
   return outputTrajectory;
 }
 
+std::unique_ptr<aikido::trajectory::Spline> doShortcut(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    common::ThreadPool& _threadPool,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    std::size_t _numCandidates,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _checkResolution,
+    double _tolerance)
+{
+  auto stateSpace = _inputTrajectory.getStateSpace();
+
+  double startTime = _inputTrajectory.getStartTime();
+  auto dynamicPath = detail::convertToDynamicPath(
+      _inputTrajectory, _maxVelocity, _maxAcceleration);
+
+  detail::doShortcut(
+      *dynamicPath,
+      _threadPool,
+      _feasibilityChecks,
+      _numCandidates,
+      _timelimit,
+      _checkResolution,
+      _tolerance,
+      _rng);
+
+  auto outputTrajectory
+      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+
+  return outputTrajectory;
+}
+
 std::unique_ptr<trajectory::Spline> doBlend(
     const trajectory::Spline& _inputTrajectory,
     aikido::constraint::TestablePtr _feasibilityCheck,
@@ -115,6 +151,50 @@ std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
   return outputTrajectory;
 }
 
+std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
+    const trajectory::Spline& _inputTrajectory,
+    common::ThreadPool& _threadPool,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    std::size_t _numCandidates,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _blendRadius,
+    int _blendIterations,
+    double _checkResolution,
+    double _tolerance)
+{
+  auto stateSpace = _inputTrajectory.getStateSpace();
+
+  double startTime = _inputTrajectory.getStartTime();
+  auto dynamicPath = detail::convertToDynamicPath(
+      _inputTrajectory, _maxVelocity, _maxAcceleration);
+
+  detail::doShortcut(
+      *dynamicPath,
+      _threadPool,
+      _feasibilityChecks,
+      _numCandidates,
+      _timelimit,
+      _checkResolution,
+      _tolerance,
+      _rng);
+
+  detail::doBlend(
+      *dynamicPath,
+      _feasibilityChecks.front(),
+      _blendRadius,
+      _blendIterations,
+      _checkResolution,
+      _tolerance);
+
+  auto outputTrajectory
+      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+
+  return outputTrajectory;
+}
+
 //==============================================================================
 ParabolicSmoother::ParabolicSmoother(
     const Eigen::VectorXd& _velocityLimits,
@@ -135,6 +215,7 @@ ParabolicSmoother::ParabolicSmoother(
   , mShortcutTimelimit{_shortcutTimelimit}
   , mBlendRadius{_blendRadius}
   , mBlendIterations{_blendIterations}
+  , mNumCandidates{0u}
 {
   // Do nothing
 }
@@ -153,6 +234,7 @@ ParabolicSmoother::ParabolicSmoother(
   , mShortcutTimelimit{_params.mShortcutTimelimit}
   , mBlendRadius{_params.mBlendRadius}
   , mBlendIterations{_params.mBlendIterations}
+  , mNumCandidates{0u}
 {
   // Do nothing
 }
@@ -193,6 +275,30 @@ std::unique_ptr<aikido::trajectory::Spline> ParabolicSmoother::postprocess(
   return timedTrajectory;
 }
 
+//==============================================================================
+void ParabolicSmoother::setParallelShortcut(
+    PlanningContextPoolPtr _contextPool,
+    std::shared_ptr<common::ThreadPool> _threadPool,
+    std::size_t _numCandidates)
+{
+  if (!_contextPool && _threadPool)
+    throw std::invalid_argument(
+        "Parallel shortcutting needs a PlanningContextPool.");
+
+  if (_contextPool && !_threadPool)
+  {
+    _threadPool = std::make_shared<common::ThreadPool>(
+        _contextPool->getNumContexts() + 1u);
+  }
+
+  if (_threadPool && _numCandidates == 0u)
+    _numCandidates = _threadPool->getNumThreads();
+
+  mContextPool = std::move(_contextPool);
+  mThreadPool = std::move(_threadPool);
+  mNumCandidates = mContextPool ? _numCandidates : 0u;
+}
+
 //==============================================================================
 std::unique_ptr<aikido::trajectory::Spline>
 ParabolicSmoother::handleShortcutOrBlend(
@@ -204,6 +310,68 @@ ParabolicSmoother::handleShortcutOrBlend(
     throw std::invalid_argument(
         "_collisionTestable passed to ParabolicSmoother is nullptr.");
 
+  // _collisionTestable and the contexts that are free check the candidates.
+  // Waiting for a context could deadlock if the caller holds one, so the
+  // candidates are spread over however many are free. Each round still checks
+  // mNumCandidates of them.
+  std::vector<PlanningContextPool::Handle> contexts;
+  std::vector<aikido::constraint::TestablePtr> feasibilityChecks{
+      _collisionTestable};
+  if (mEnableShortcut && mContextPool)
+  {
+    const auto stateSpace = _collisionTestable->getStateSpace();
+    const auto numChecks
+        = std::min(mThreadPool->getNumThreads(), mNumCandidates);
+    while (feasibilityChecks.size() < numChecks)
+    {
+      auto context = mContextPool->tryAcquire();
+      if (!context)
+        break;
+
+      if (!context->mConstraint)
+        throw std::invalid_argument("Planning context has no constraint.");
+      if (context->mConstraint->getStateSpace() != stateSpace)
+        throw std::invalid_argument(
+            "Constraint of planning context does not match the StateSpace of "
+            "_collisionTestable.");
+
+      feasibilityChecks.emplace_back(context->mConstraint);
+      contexts.emplace_back(std::move(context));
+    }
+  }
+
+  if (mEnableShortcut && mContextPool)
+  {
+    if (mEnableBlend)
+    {
+      return doShortcutAndBlend(
+          _inputTraj,
+          *mThreadPool,
+          feasibilityChecks,
+          mNumCandidates,
+          mVelocityLimits,
+          mAccelerationLimits,
+          *_rng.clone(),
+          mShortcutTimelimit,
+          mBlendRadius,
+          mBlendIterations,
+          mFeasibilityCheckResolution,
+          mFeasibilityApproxTolerance);
+    }
+
+    return doShortcut(
+        _inputTraj,
+        *mThreadPool,
+        feasibilityChecks,
+        mNumCandidates,
+        mVelocityLimits,
+        mAccelerationLimits,
+        *_rng.clone(),
+        mShortcutTimelimit,
+        mFeasibilityCheckResolution,
+        mFeasibilityApproxTolerance);
+  }
+
   if (mEnableShortcut && mEnableBlend)
   {
     return doShortcutAndBlend(
@@ -0,0 +1,210 @@
+#include "aikido/planner/parabolic/StreamingParabolicTimer.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "DynamicPath.h"
+#include "ParabolicUtil.hpp"
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+
+//==============================================================================
+StreamingParabolicTimer::StreamingParabolicTimer(
+    statespace::ConstStateSpacePtr _stateSpace,
+    const Eigen::VectorXd& _velocityLimits,
+    const Eigen::VectorXd& _accelerationLimits,
+    double _startTime,
+    std::size_t _maxLookahead,
+    double _collinearTolerance)
+  : mStateSpace{std::move(_stateSpace)}
+  , mInterpolator{mStateSpace}
+  , mVelocityLimits{_velocityLimits}
+  , mAccelerationLimits{_accelerationLimits}
+  , mMaxLookahead{_maxLookahead}
+  , mCollinearTolerance{_collinearTolerance}
+  , mEndTime{_startTime}
+  , mLastState{mStateSpace->createState()}
+  , mHasLastState{false}
+  , mNumPendingSegments{0}
+{
+  const auto dimension = mStateSpace->getDimension();
+
+  if (static_cast<std::size_t>(mVelocityLimits.size()) != dimension)
+    throw std::invalid_argument("Velocity limits have wrong dimension.");
+
+  if (static_cast<std::size_t>(mAccelerationLimits.size()) != dimension)
+    throw std::invalid_argument("Acceleration limits have wrong dimension.");
+
+  for (std::size_t i = 0; i < dimension; ++i)
+  {
+    if (mVelocityLimits[i] <= 0.)
+      throw std::invalid_argument("Velocity limits must be positive.");
+    if (!std::isfinite(mVelocityLimits[i]))
+      throw std::invalid_argument("Velocity limits must be finite.");
+
+    if (mAccelerationLimits[i] <= 0.)
+      throw std::invalid_argument("Acceleration limits must be positive.");
+    if (!std::isfinite(mAccelerationLimits[i]))
+      throw std::invalid_argument("Acceleration limits must be finite.");
+  }
+
+  if (mMaxLookahead == 0)
+    throw std::invalid_argument("Lookahead must be positive.");
+
+  if (mCollinearTolerance < 0.)
+    throw std::invalid_argument("Collinear tolerance must be non-negative.");
+}
+
+//==============================================================================
+std::unique_ptr<trajectory::Spline> StreamingParabolicTimer::addWaypoint(
+    const statespace::StateSpace::State* _state)
+{
+  if (!mHasLastState)
+  {
+    mStateSpace->copyState(_state, mLastState);
+    mStateSpace->logMap(_state, mRunStart);
+    mRunEnd = mRunStart;
+    mHasLastState = true;
+    return nullptr;
+  }
+
+  // Unwrap the waypoint relative to the previous one, like
+  // toR1JointTrajectory does for a whole trajectory.
+  const Eigen::VectorXd step
+      = mInterpolator.getTangentVector(mLastState, _state);
+  mStateSpace->copyState(_state, mLastState);
+
+  // The timing of a zero length step has zero duration.
+  if (step.isZero(0.))
+    return nullptr;
+
+  std::unique_ptr<trajectory::Spline> output;
+
+  if (mNumPendingSegments > 0)
+  {
+    // Extend the held back segments if the step continues in their direction.
+    const Eigen::VectorXd end = mRunEnd + step;
+
+    if (continuesRun(end))
+    {
+      mRunWaypoints.emplace_back(mRunEnd);
+      mRunEnd = end;
+      ++mNumPendingSegments;
+    }
+    else
+    {
+      output = emitRun();
+      mRunEnd = end;
+      mNumPendingSegments = 1;
+    }
+  }
+  else
+  {
+    mRunEnd += step;
+    mNumPendingSegments = 1;
+  }
+
+  if (mNumPendingSegments >= mMaxLookahead)
+  {
+    auto run = emitRun();
+    if (!output)
+      return run;
+
+    for (std::size_t i = 0; i < run->getNumSegments(); ++i)
+    {
+      output->addSegment(
+          run->getSegmentCoefficients(i),
+          run->getSegmentDuration(i),
+          run->getSegmentStartState(i));
+    }
+  }
+
+  return output;
+}
+
+//==============================================================================
+std::unique_ptr<trajectory::Spline> StreamingParabolicTimer::finish()
+{
+  if (mNumPendingSegments == 0)
+    return nullptr;
+
+  return emitRun();
+}
+
+//==============================================================================
+void StreamingParabolicTimer::reset(double _startTime)
+{
+  mEndTime = _startTime;
+  mHasLastState = false;
+  mRunWaypoints.clear();
+  mNumPendingSegments = 0;
+}
+
+//==============================================================================
+double StreamingParabolicTimer::getEndTime() const
+{
+  return mEndTime;
+}
+
+//==============================================================================
+std::size_t StreamingParabolicTimer::getNumPendingSegments() const
+{
+  return mNumPendingSegments;
+}
+
+//==============================================================================
+bool StreamingParabolicTimer::continuesRun(const Eigen::VectorXd& _end) const
+{
+  const Eigen::VectorXd chord = _end - mRunStart;
+  const double squaredLength = chord.squaredNorm();
+  if (squaredLength == 0.)
+    return false;
+
+  // Check the waypoints against the whole new segment rather than only the
+  // last step, so that a slowly turning path does not drift away from it.
+  double previousProjection = 0.;
+  const auto isOnChord = [&](const Eigen::VectorXd& waypoint) {
+    const Eigen::VectorXd offset = waypoint - mRunStart;
+    const double projection = offset.dot(chord) / squaredLength;
+    if (projection <= previousProjection || projection >= 1.)
+      return false;
+
+    previousProjection = projection;
+    return (offset - projection * chord).norm() <= mCollinearTolerance;
+  };
+
+  for (const auto& waypoint : mRunWaypoints)
+  {
+    if (!isOnChord(waypoint))
+      return false;
+  }
+  return isOnChord(mRunEnd);
+}
+
+//==============================================================================
+std::unique_ptr<trajectory::Spline> StreamingParabolicTimer::emitRun()
+{
+  // Both ends of the run have zero velocity, so its timing does not depend on
+  // the waypoints before or after it.
+  ParabolicRamp::DynamicPath dynamicPath;
+  dynamicPath.Init(
+      detail::toVector(mVelocityLimits), detail::toVector(mAccelerationLimits));
+  dynamicPath.SetMilestones(
+      {detail::toVector(mRunStart), detail::toVector(mRunEnd)});
+  if (!dynamicPath.IsValid())
+    throw std::runtime_error("Converted DynamicPath is not valid");
+
+  auto output = detail::convertToSpline(dynamicPath, mEndTime, mStateSpace);
+  mEndTime = output->getEndTime();
+
+  mRunStart = mRunEnd;
+  mRunWaypoints.clear();
+  mNumPendingSegments = 0;
+  return output;
+}
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
@@ -213,6 +213,67 @@ CollisionFreePtr ConcreteRobot::getSelfCollisionConstraint(
   return collisionFreeConstraint;
 }
 
+//==============================================================================
+void ConcreteRobot::setSelfCollisionMatrix(
+    constraint::dart::ConstSelfCollisionMatrixPtr matrix)
+{
+  if (!matrix)
+    throw std::invalid_argument("SelfCollisionMatrix is nullptr.");
+
+  // The self collision constraint of a sub-robot is the root robot's.
+  if (mRootRobot != this)
+  {
+    getConcreteRootRobot()->setSelfCollisionMatrix(std::move(matrix));
+    return;
+  }
+
+  if (!mSelfCollisionFilter)
+  {
+    mSelfCollisionFilter
+        = std::make_shared<dart::collision::BodyNodeCollisionFilter>();
+  }
+
+  matrix->apply(*mMetaSkeleton, *mSelfCollisionFilter);
+  mSelfCollisionMatrix = std::move(matrix);
+}
+
+//==============================================================================
+constraint::dart::ConstSelfCollisionMatrixPtr
+ConcreteRobot::getSelfCollisionMatrix() const
+{
+  if (mRootRobot != this)
+    return getConcreteRootRobot()->getSelfCollisionMatrix();
+
+  return mSelfCollisionMatrix;
+}
+
+//==============================================================================
+constraint::dart::ConstSelfCollisionMatrixPtr
+ConcreteRobot::computeSelfCollisionMatrix(std::size_t numSamples)
+{
+  using constraint::dart::SelfCollisionMatrix;
+
+  auto matrix = std::make_shared<SelfCollisionMatrix>(
+      SelfCollisionMatrix::compute(
+          mMetaSkeleton, mCollisionDetector, mRng.get(), numSamples));
+  setSelfCollisionMatrix(matrix);
+  return matrix;
+}
+
+//==============================================================================
+ConcreteRobot* ConcreteRobot::getConcreteRootRobot() const
+{
+  auto rootRobot = dynamic_cast<ConcreteRobot*>(mRootRobot);
+  if (!rootRobot)
+  {
+    throw std::runtime_error(
+        "The self collision matrix of a sub-robot is kept by its root robot, "
+        "which is not a ConcreteRobot.");
+  }
+
+  return rootRobot;
+}
+
 //=============================================================================
 TestablePtr ConcreteRobot::getFullCollisionConstraint(
     const ConstMetaSkeletonStateSpacePtr& space,
@@ -223,24 +223,32 @@ void TrajectoryMarker::updatePoints()
       mSkeleton, MetaSkeletonStateSaver::Options::POSITIONS);
   DART_UNUSED(saver);
 
-  auto state = metaSkeletonSs->createState();
-  double t = mTrajectory->getStartTime();
   const double dt = mTrajectory->getDuration() / mNumLineSegments;
+  Eigen::VectorXd times(mNumLineSegments);
+  double t = mTrajectory->getStartTime();
+  for (std::size_t i = 0u; i < mNumLineSegments - 1u; ++i)
+  {
+    times[i] = t;
+    t += dt;
+  }
+  times[mNumLineSegments - 1u] = mTrajectory->getEndTime();
+
+  Eigen::MatrixXd positions;
+  mTrajectory->evaluateBatch(times, positions);
+
+  auto state = metaSkeletonSs->createState();
+  Eigen::VectorXd position;
 
   points.reserve(mNumLineSegments + 1u);
   Eigen::Vector3d pose;
-  for (std::size_t i = 0u; i < mNumLineSegments - 1u; ++i)
+  for (std::size_t i = 0u; i < mNumLineSegments; ++i)
   {
-    mTrajectory->evaluate(t, state);
+    position = positions.row(i).transpose();
+    metaSkeletonSs->expMap(position, state);
     metaSkeletonSs->setState(mSkeleton.get(), state);
     pose = mFrame.getTransform().translation();
     points.emplace_back(convertEigenToROSPoint(pose));
-    t += dt;
   }
-  mTrajectory->evaluate(mTrajectory->getEndTime(), state);
-  metaSkeletonSs->setState(mSkeleton.get(), state);
-  pose = mFrame.getTransform().translation();
-  points.emplace_back(convertEigenToROSPoint(pose));
 
   mNeedPointsUpdate = false;
 
@@ -0,0 +1,61 @@
+#include "aikido/statespace/ArenaStateAllocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+ArenaStateAllocator::ArenaStateAllocator(std::size_t chunkSize)
+  : mChunkSize(chunkSize), mUsed(0u), mCapacity(0u)
+{
+  if (mChunkSize == 0u)
+    throw std::invalid_argument("Chunk size must be positive.");
+}
+
+//==============================================================================
+void* ArenaStateAllocator::allocate(std::size_t size)
+{
+  constexpr std::size_t alignment = alignof(std::max_align_t);
+  size = std::max(alignment, (size + alignment - 1) / alignment * alignment);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mChunks.empty() || mUsed + size > mCapacity)
+  {
+    // Oversized requests get a chunk of their own.
+    mCapacity = std::max(mChunkSize, size);
+    mChunks.emplace_back(new char[mCapacity]);
+    mUsed = 0u;
+  }
+
+  void* buffer = mChunks.back().get() + mUsed;
+  mUsed += size;
+  return buffer;
+}
+
+//==============================================================================
+void ArenaStateAllocator::deallocate(void* /*buffer*/, std::size_t /*size*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ArenaStateAllocator::release()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mChunks.clear();
+  mUsed = 0u;
+  mCapacity = 0u;
+}
+
+//==============================================================================
+std::size_t ArenaStateAllocator::getNumChunks() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mChunks.size();
+}
+
+} // namespace statespace
+} // namespace aikido
@@ -48,6 +48,12 @@ std::size_t CartesianProduct::getNumSubspaces() const
   return mSubspaces.size();
 }
 
+//==============================================================================
+std::size_t CartesianProduct::getSubStateOffset(std::size_t _index) const
+{
+  return mOffsets[_index];
+}
+
 //==============================================================================
 std::size_t CartesianProduct::getStateSizeInBytes() const
 {
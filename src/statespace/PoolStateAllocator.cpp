@@ -0,0 +1,116 @@
+#include "aikido/statespace/PoolStateAllocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace aikido {
+namespace statespace {
+namespace {
+
+//==============================================================================
+std::size_t roundUpToAlignment(std::size_t size)
+{
+  constexpr std::size_t alignment = alignof(std::max_align_t);
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+//==============================================================================
+PoolStateAllocator::PoolStateAllocator(
+    std::size_t blockSize, std::size_t numBlocksPerChunk)
+  : mBlockSize(roundUpToAlignment(std::max(blockSize, sizeof(FreeBlock))))
+  , mNumBlocksPerChunk(numBlocksPerChunk)
+  , mFreeList(nullptr)
+  , mNumAllocatedBlocks(0u)
+{
+  if (blockSize == 0u)
+    throw std::invalid_argument("Block size must be positive.");
+
+  if (mNumBlocksPerChunk == 0u)
+    throw std::invalid_argument("Number of blocks per chunk must be positive.");
+}
+
+//==============================================================================
+PoolStateAllocator::PoolStateAllocator(
+    const StateSpace& stateSpace, std::size_t numBlocksPerChunk)
+  : PoolStateAllocator(stateSpace.getStateSizeInBytes(), numBlocksPerChunk)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void* PoolStateAllocator::allocate(std::size_t size)
+{
+  if (size > mBlockSize)
+  {
+    throw std::invalid_argument(
+        "Requested size is larger than the block size of the pool.");
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!mFreeList)
+    addChunk();
+
+  FreeBlock* block = mFreeList;
+  mFreeList = block->mNext;
+  ++mNumAllocatedBlocks;
+
+  return block;
+}
+
+//==============================================================================
+void PoolStateAllocator::deallocate(void* buffer, std::size_t /*size*/)
+{
+  if (!buffer)
+    return;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto block = static_cast<FreeBlock*>(buffer);
+  block->mNext = mFreeList;
+  mFreeList = block;
+  --mNumAllocatedBlocks;
+}
+
+//==============================================================================
+std::size_t PoolStateAllocator::getBlockSize() const
+{
+  return mBlockSize;
+}
+
+//==============================================================================
+std::size_t PoolStateAllocator::getNumAllocatedBlocks() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumAllocatedBlocks;
+}
+
+//==============================================================================
+std::size_t PoolStateAllocator::getNumChunks() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mChunks.size();
+}
+
+//==============================================================================
+void PoolStateAllocator::addChunk()
+{
+  // Memory returned by new[] is aligned for any fundamental type, and
+  // mBlockSize is a multiple of that alignment, so every block is aligned.
+  std::unique_ptr<char[]> chunk(new char[mBlockSize * mNumBlocksPerChunk]);
+
+  // Thread the blocks in order, so that consecutive allocations are adjacent.
+  for (std::size_t i = mNumBlocksPerChunk; i > 0u; --i)
+  {
+    auto block
+        = reinterpret_cast<FreeBlock*>(chunk.get() + (i - 1) * mBlockSize);
+    block->mNext = mFreeList;
+    mFreeList = block;
+  }
+
+  mChunks.emplace_back(std::move(chunk));
+}
+
+} // namespace statespace
+} // namespace aikido
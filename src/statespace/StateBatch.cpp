@@ -0,0 +1,471 @@
+#include "aikido/statespace/StateBatch.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "aikido/statespace/CartesianProduct.hpp"
+#include "aikido/statespace/Rn.hpp"
+#include "aikido/statespace/SO2.hpp"
+
+namespace aikido {
+namespace statespace {
+
+namespace {
+
+//==============================================================================
+bool isRealVector(const StateSpace* space)
+{
+  return dynamic_cast<const R0*>(space) || dynamic_cast<const R1*>(space)
+         || dynamic_cast<const R2*>(space) || dynamic_cast<const R3*>(space)
+         || dynamic_cast<const R6*>(space) || dynamic_cast<const Rn*>(space);
+}
+
+//==============================================================================
+double wrapAngle(double angle)
+{
+  // Same as SO2::State::fromAngle.
+  double boundedAngle = std::fmod(angle, 2.0 * M_PI);
+  if (boundedAngle > M_PI)
+    boundedAngle -= 2.0 * M_PI;
+  if (boundedAngle <= -M_PI)
+    boundedAngle += 2.0 * M_PI;
+  return boundedAngle;
+}
+
+//==============================================================================
+/// Scratch states used to operate on a subspace that is not vectorized.
+struct GenericWorkspace
+{
+  explicit GenericWorkspace(const StateSpace* space)
+    : mSpace(space)
+    , mFrom(space)
+    , mTo(space)
+    , mInverse(space)
+    , mRelative(space)
+    , mOut(space)
+  {
+    // Do nothing
+  }
+
+  /// Computes the tangent vector from \c from to \c to, which are log map
+  /// coordinates, as GeodesicInterpolator does. Leaves the state \c from in
+  /// mFrom.
+  void getTangent(
+      const Eigen::VectorXd& from,
+      const Eigen::VectorXd& to,
+      Eigen::VectorXd& tangent)
+  {
+    mSpace->expMap(from, mFrom);
+    mSpace->expMap(to, mTo);
+    mSpace->getInverse(mFrom, mInverse);
+    mSpace->compose(mInverse, mTo, mRelative);
+    mSpace->logMap(mRelative, tangent);
+  }
+
+  /// Computes the coordinates of the state at \c tangent from mFrom.
+  void step(const Eigen::VectorXd& tangent, Eigen::VectorXd& out)
+  {
+    mSpace->expMap(tangent, mRelative);
+    mSpace->compose(mFrom, mRelative, mOut);
+    mSpace->logMap(mOut, out);
+  }
+
+  const StateSpace* mSpace;
+  StateSpace::ScopedState mFrom;
+  StateSpace::ScopedState mTo;
+  StateSpace::ScopedState mInverse;
+  StateSpace::ScopedState mRelative;
+  StateSpace::ScopedState mOut;
+};
+
+} // namespace
+
+//==============================================================================
+StateBatch::StateBatch(ConstStateSpacePtr stateSpace, std::size_t numStates)
+  : mStateSpace(std::move(stateSpace)), mIsVectorized(true)
+{
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is nullptr.");
+
+  std::vector<ConstStateSpacePtr> subspaces;
+  const auto cartesianProduct
+      = std::dynamic_pointer_cast<const CartesianProduct>(mStateSpace);
+  if (cartesianProduct)
+  {
+    for (std::size_t i = 0; i < cartesianProduct->getNumSubspaces(); ++i)
+      subspaces.emplace_back(cartesianProduct->getSubspace<>(i));
+  }
+  else
+  {
+    subspaces.emplace_back(mStateSpace);
+  }
+
+  // CartesianProduct::logMap concatenates the tangent vectors of the
+  // subspaces in order.
+  std::size_t offset = 0;
+  for (auto& subspace : subspaces)
+  {
+    Block block;
+    if (isRealVector(subspace.get()))
+      block.mType = Block::Type::RealVector;
+    else if (dynamic_cast<const SO2*>(subspace.get()))
+      block.mType = Block::Type::Angle;
+    else
+      block.mType = Block::Type::Generic;
+
+    block.mSpace = std::move(subspace);
+    block.mOffset = offset;
+    block.mDimension = block.mSpace->getDimension();
+    offset += block.mDimension;
+
+    mIsVectorized = mIsVectorized && block.mType != Block::Type::Generic;
+    mBlocks.emplace_back(std::move(block));
+  }
+
+  auto identity = mStateSpace->createState();
+  mStateSpace->getIdentity(identity);
+  Eigen::VectorXd identityTangent;
+  mStateSpace->logMap(identity, identityTangent);
+  mIdentity = identityTangent.transpose();
+
+  mCoordinates.resize(0, mStateSpace->getDimension());
+  resize(numStates);
+}
+
+//==============================================================================
+const ConstStateSpacePtr& StateBatch::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::size_t StateBatch::getNumStates() const
+{
+  return static_cast<std::size_t>(mCoordinates.rows());
+}
+
+//==============================================================================
+void StateBatch::resize(std::size_t numStates)
+{
+  const auto oldNumStates = getNumStates();
+  mCoordinates.conservativeResize(numStates, mCoordinates.cols());
+
+  for (std::size_t i = oldNumStates; i < numStates; ++i)
+    mCoordinates.row(i) = mIdentity;
+}
+
+//==============================================================================
+bool StateBatch::isVectorized() const
+{
+  return mIsVectorized;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& StateBatch::getCoordinates() const
+{
+  return mCoordinates;
+}
+
+//==============================================================================
+void StateBatch::setState(std::size_t index, const StateSpace::State* state)
+{
+  if (index >= getNumStates())
+    throw std::out_of_range("State index is out of range.");
+
+  Eigen::VectorXd tangent;
+  mStateSpace->logMap(state, tangent);
+  mCoordinates.row(index) = tangent.transpose();
+}
+
+//==============================================================================
+void StateBatch::getState(std::size_t index, StateSpace::State* state) const
+{
+  if (index >= getNumStates())
+    throw std::out_of_range("State index is out of range.");
+
+  mStateSpace->expMap(mCoordinates.row(index).transpose(), state);
+}
+
+//==============================================================================
+void StateBatch::expMap(const Eigen::MatrixXd& tangents)
+{
+  if (static_cast<std::size_t>(tangents.cols())
+      != mStateSpace->getDimension())
+  {
+    throw std::invalid_argument(
+        "Tangents do not match the dimension of the StateSpace.");
+  }
+
+  mCoordinates = tangents;
+  normalize(mCoordinates);
+}
+
+//==============================================================================
+void StateBatch::logMap(Eigen::MatrixXd& tangents) const
+{
+  tangents = mCoordinates;
+}
+
+//==============================================================================
+void StateBatch::interpolate(
+    const StateBatch& from, const StateBatch& to, double alpha)
+{
+  checkCompatible(from);
+  checkCompatible(to);
+  if (from.getNumStates() != to.getNumStates())
+    throw std::invalid_argument("Batches have different numbers of states.");
+
+  const auto& a = from.mCoordinates;
+  const auto& b = to.mCoordinates;
+
+  // this may be the same batch as from or to.
+  Eigen::MatrixXd out(a.rows(), a.cols());
+  for (const auto& block : mBlocks)
+  {
+    const auto offset = block.mOffset;
+    const auto dimension = block.mDimension;
+
+    switch (block.mType)
+    {
+      case Block::Type::RealVector:
+        out.middleCols(offset, dimension)
+            = a.middleCols(offset, dimension)
+              + alpha
+                    * (b.middleCols(offset, dimension)
+                       - a.middleCols(offset, dimension));
+        break;
+
+      case Block::Type::Angle:
+        out.col(offset)
+            = (a.col(offset)
+               + alpha * (b.col(offset) - a.col(offset)).unaryExpr(&wrapAngle))
+                  .unaryExpr(&wrapAngle);
+        break;
+
+      case Block::Type::Generic:
+      {
+        GenericWorkspace workspace(block.mSpace.get());
+        Eigen::VectorXd tangent;
+        Eigen::VectorXd outState;
+        for (int i = 0; i < a.rows(); ++i)
+        {
+          workspace.getTangent(
+              a.row(i).segment(offset, dimension).transpose(),
+              b.row(i).segment(offset, dimension).transpose(),
+              tangent);
+          workspace.step(alpha * tangent, outState);
+          out.row(i).segment(offset, dimension) = outState.transpose();
+        }
+        break;
+      }
+    }
+  }
+
+  mCoordinates.swap(out);
+}
+
+//==============================================================================
+void StateBatch::interpolate(
+    const StateSpace::State* from,
+    const StateSpace::State* to,
+    const Eigen::VectorXd& alphas)
+{
+  Eigen::VectorXd a;
+  Eigen::VectorXd b;
+  mStateSpace->logMap(from, a);
+  mStateSpace->logMap(to, b);
+
+  mCoordinates.resize(alphas.size(), mStateSpace->getDimension());
+  for (const auto& block : mBlocks)
+  {
+    const auto offset = block.mOffset;
+    const auto dimension = block.mDimension;
+
+    switch (block.mType)
+    {
+      case Block::Type::RealVector:
+      {
+        const Eigen::RowVectorXd start
+            = a.segment(offset, dimension).transpose();
+        const Eigen::RowVectorXd difference
+            = (b - a).segment(offset, dimension).transpose();
+        mCoordinates.middleCols(offset, dimension)
+            = (alphas * difference).rowwise() + start;
+        break;
+      }
+
+      case Block::Type::Angle:
+      {
+        const double difference = wrapAngle(b[offset] - a[offset]);
+        mCoordinates.col(offset)
+            = (alphas.array() * difference + a[offset])
+                  .matrix()
+                  .unaryExpr(&wrapAngle);
+        break;
+      }
+
+      case Block::Type::Generic:
+      {
+        GenericWorkspace workspace(block.mSpace.get());
+        Eigen::VectorXd tangent;
+        Eigen::VectorXd outState;
+        workspace.getTangent(
+            a.segment(offset, dimension),
+            b.segment(offset, dimension),
+            tangent);
+        for (int i = 0; i < alphas.size(); ++i)
+        {
+          workspace.step(alphas[i] * tangent, outState);
+          mCoordinates.row(i).segment(offset, dimension)
+              = outState.transpose();
+        }
+        break;
+      }
+    }
+  }
+}
+
+//==============================================================================
+void StateBatch::distance(
+    const StateBatch& other, Eigen::VectorXd& distances) const
+{
+  checkCompatible(other);
+  if (other.getNumStates() != getNumStates())
+    throw std::invalid_argument("Batches have different numbers of states.");
+
+  const auto& a = mCoordinates;
+  const auto& b = other.mCoordinates;
+
+  distances.setZero(a.rows());
+  for (const auto& block : mBlocks)
+  {
+    const auto offset = block.mOffset;
+    const auto dimension = block.mDimension;
+
+    switch (block.mType)
+    {
+      case Block::Type::RealVector:
+        distances += (b.middleCols(offset, dimension)
+                      - a.middleCols(offset, dimension))
+                         .rowwise()
+                         .norm();
+        break;
+
+      case Block::Type::Angle:
+        distances += (b.col(offset) - a.col(offset))
+                         .unaryExpr(&wrapAngle)
+                         .cwiseAbs();
+        break;
+
+      case Block::Type::Generic:
+      {
+        GenericWorkspace workspace(block.mSpace.get());
+        Eigen::VectorXd tangent;
+        for (int i = 0; i < a.rows(); ++i)
+        {
+          workspace.getTangent(
+              a.row(i).segment(offset, dimension).transpose(),
+              b.row(i).segment(offset, dimension).transpose(),
+              tangent);
+          distances[i] += tangent.norm();
+        }
+        break;
+      }
+    }
+  }
+}
+
+//==============================================================================
+void StateBatch::distance(
+    const StateSpace::State* state, Eigen::VectorXd& distances) const
+{
+  Eigen::VectorXd b;
+  mStateSpace->logMap(state, b);
+
+  const auto& a = mCoordinates;
+
+  distances.setZero(a.rows());
+  for (const auto& block : mBlocks)
+  {
+    const auto offset = block.mOffset;
+    const auto dimension = block.mDimension;
+
+    switch (block.mType)
+    {
+      case Block::Type::RealVector:
+      {
+        const Eigen::RowVectorXd end = b.segment(offset, dimension).transpose();
+        distances += (a.middleCols(offset, dimension).rowwise() - end)
+                         .rowwise()
+                         .norm();
+        break;
+      }
+
+      case Block::Type::Angle:
+        distances += (b[offset] - a.col(offset).array())
+                         .matrix()
+                         .unaryExpr(&wrapAngle)
+                         .cwiseAbs();
+        break;
+
+      case Block::Type::Generic:
+      {
+        GenericWorkspace workspace(block.mSpace.get());
+        Eigen::VectorXd tangent;
+        for (int i = 0; i < a.rows(); ++i)
+        {
+          workspace.getTangent(
+              a.row(i).segment(offset, dimension).transpose(),
+              b.segment(offset, dimension),
+              tangent);
+          distances[i] += tangent.norm();
+        }
+        break;
+      }
+    }
+  }
+}
+
+//==============================================================================
+void StateBatch::checkCompatible(const StateBatch& other) const
+{
+  if (other.mStateSpace != mStateSpace)
+    throw std::invalid_argument("Batches have different StateSpaces.");
+}
+
+//==============================================================================
+void StateBatch::normalize(Eigen::MatrixXd& coordinates) const
+{
+  for (const auto& block : mBlocks)
+  {
+    const auto offset = block.mOffset;
+    const auto dimension = block.mDimension;
+
+    switch (block.mType)
+    {
+      case Block::Type::RealVector:
+        break;
+
+      case Block::Type::Angle:
+        coordinates.col(offset) = coordinates.col(offset).unaryExpr(&wrapAngle);
+        break;
+
+      case Block::Type::Generic:
+      {
+        auto state = block.mSpace->createState();
+        Eigen::VectorXd tangent;
+        for (int i = 0; i < coordinates.rows(); ++i)
+        {
+          block.mSpace->expMap(
+              coordinates.row(i).segment(offset, dimension).transpose(), state);
+          block.mSpace->logMap(state, tangent);
+          coordinates.row(i).segment(offset, dimension) = tangent.transpose();
+        }
+        break;
+      }
+    }
+  }
+}
+
+} // namespace statespace
+} // namespace aikido
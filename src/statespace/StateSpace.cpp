@@ -38,13 +38,34 @@ void StateSpace::getInverse(State* _state) const
 //==============================================================================
 auto StateSpace::allocateState() const -> State*
 {
+  if (mStateAllocator)
+  {
+    return allocateStateInBuffer(
+        mStateAllocator->allocate(getStateSizeInBytes()));
+  }
+
   return allocateStateInBuffer(new char[getStateSizeInBytes()]);
 }
 
 //==============================================================================
 void StateSpace::freeState(StateSpace::State* _state) const
 {
-  delete[] reinterpret_cast<char*>(_state);
+  if (mStateAllocator)
+    mStateAllocator->deallocate(_state, getStateSizeInBytes());
+  else
+    delete[] reinterpret_cast<char*>(_state);
+}
+
+//==============================================================================
+void StateSpace::setStateAllocator(StateAllocatorPtr _allocator)
+{
+  mStateAllocator = std::move(_allocator);
+}
+
+//==============================================================================
+auto StateSpace::getStateAllocator() const -> const StateAllocatorPtr&
+{
+  return mStateAllocator;
 }
 
 } // namespace statespace
@@ -253,8 +253,116 @@ MetaSkeletonStateSpace::MetaSkeletonStateSpace(const MetaSkeleton* metaskeleton)
         convertVectorType<ConstJointStateSpacePtr, ConstStateSpacePtr>(
             createStateSpace(*metaskeleton)))
   , mProperties(MetaSkeletonStateSpace::Properties(metaskeleton))
+  , mIsIdentityLayout(true)
 {
-  // Do nothing.
+  mJointLayouts.reserve(getNumSubspaces());
+  mDofIndices.reserve(mProperties.getNumDofs());
+
+  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
+  {
+    const auto subspace = getSubspace<JointStateSpace>(isubspace);
+
+    JointLayout layout;
+    layout.mSpace = subspace.get();
+    layout.mSO2Joint = dynamic_cast<const SO2Joint*>(subspace.get());
+    layout.mR1Joint = dynamic_cast<const R1Joint*>(subspace.get());
+    layout.mFirstDof = mDofIndices.size();
+    layout.mNumDofs = subspace->getProperties().getNumDofs();
+
+    for (std::size_t idof = 0; idof < layout.mNumDofs; ++idof)
+    {
+      const auto dofIndex = mProperties.getDofIndex(isubspace, idof);
+      if (dofIndex != mDofIndices.size())
+        mIsIdentityLayout = false;
+
+      mDofIndices.emplace_back(dofIndex);
+    }
+
+    mJointLayouts.emplace_back(layout);
+  }
+}
+
+//==============================================================================
+template <class SetPosition>
+void MetaSkeletonStateSpace::forEachPosition(
+    const State* _state, SetPosition&& setPosition) const
+{
+  Eigen::VectorXd jointPositions;
+
+  for (std::size_t isubspace = 0; isubspace < mJointLayouts.size(); ++isubspace)
+  {
+    const auto& layout = mJointLayouts[isubspace];
+    const auto substate = reinterpret_cast<const StateSpace::State*>(
+        reinterpret_cast<const char*>(_state) + getSubStateOffset(isubspace));
+    const auto dofIndex = mIsIdentityLayout ? layout.mFirstDof
+                                            : mDofIndices[layout.mFirstDof];
+
+    if (layout.mSO2Joint)
+    {
+      setPosition(
+          dofIndex,
+          layout.mSO2Joint->toAngle(
+              static_cast<const SO2::State*>(substate)));
+    }
+    else if (layout.mR1Joint)
+    {
+      setPosition(
+          dofIndex,
+          layout.mR1Joint->getValue(
+              static_cast<const R1Joint::State*>(substate))[0]);
+    }
+    else
+    {
+      layout.mSpace->convertStateToPositions(substate, jointPositions);
+      for (std::size_t idof = 0; idof < layout.mNumDofs; ++idof)
+      {
+        const auto index = layout.mFirstDof + idof;
+        setPosition(
+            mIsIdentityLayout ? index : mDofIndices[index],
+            jointPositions[idof]);
+      }
+    }
+  }
+}
+
+//==============================================================================
+template <class GetPosition>
+void MetaSkeletonStateSpace::setFromPositions(
+    GetPosition&& getPosition, State* _state) const
+{
+  Eigen::VectorXd jointPositions;
+
+  for (std::size_t isubspace = 0; isubspace < mJointLayouts.size(); ++isubspace)
+  {
+    const auto& layout = mJointLayouts[isubspace];
+    const auto substate = reinterpret_cast<StateSpace::State*>(
+        reinterpret_cast<char*>(_state) + getSubStateOffset(isubspace));
+    const auto dofIndex = mIsIdentityLayout ? layout.mFirstDof
+                                            : mDofIndices[layout.mFirstDof];
+
+    if (layout.mSO2Joint)
+    {
+      layout.mSO2Joint->fromAngle(
+          static_cast<SO2::State*>(substate), getPosition(dofIndex));
+    }
+    else if (layout.mR1Joint)
+    {
+      layout.mR1Joint->setValue(
+          static_cast<R1Joint::State*>(substate),
+          R1Joint::VectorNd::Constant(getPosition(dofIndex)));
+    }
+    else
+    {
+      jointPositions.resize(layout.mNumDofs);
+      for (std::size_t idof = 0; idof < layout.mNumDofs; ++idof)
+      {
+        const auto index = layout.mFirstDof + idof;
+        jointPositions[idof]
+            = getPosition(mIsIdentityLayout ? index : mDofIndices[index]);
+      }
+      layout.mSpace->convertPositionsToState(jointPositions, substate);
+    }
+  }
 }
 
 //==============================================================================
@@ -311,19 +419,8 @@ void MetaSkeletonStateSpace::convertPositionsToState(
   if (static_cast<std::size_t>(_positions.size()) != mProperties.getNumDofs())
     throw std::invalid_argument("Incorrect number of positions.");
 
-  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
-  {
-    const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto numJointDofs = subspace->getProperties().getNumDofs();
-
-    Eigen::VectorXd jointPositions(numJointDofs);
-    for (std::size_t idof = 0; idof < numJointDofs; ++idof)
-      jointPositions[idof]
-          = _positions[mProperties.getDofIndex(isubspace, idof)];
-
-    const auto substate = getSubState<>(_state, isubspace);
-    subspace->convertPositionsToState(jointPositions, substate);
-  }
+  setFromPositions(
+      [&](std::size_t dofIndex) { return _positions[dofIndex]; }, _state);
 }
 
 //==============================================================================
@@ -332,26 +429,25 @@ void MetaSkeletonStateSpace::convertStateToPositions(
 {
   _positions.resize(mProperties.getNumDofs());
 
-  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
-  {
-    const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto numJointDofs = subspace->getProperties().getNumDofs();
-    const auto substate = getSubState<>(_state, isubspace);
-
-    Eigen::VectorXd jointPositions(numJointDofs);
-    subspace->convertStateToPositions(substate, jointPositions);
-
-    for (std::size_t idof = 0; idof < numJointDofs; ++idof)
-      _positions[mProperties.getDofIndex(isubspace, idof)]
-          = jointPositions[idof];
-  }
+  forEachPosition(_state, [&](std::size_t dofIndex, double position) {
+    _positions[dofIndex] = position;
+  });
 }
 
 //==============================================================================
 void MetaSkeletonStateSpace::getState(
     const ::dart::dynamics::MetaSkeleton* _metaskeleton, State* _state) const
 {
-  convertPositionsToState(_metaskeleton->getPositions(), _state);
+  if (_metaskeleton->getNumDofs() != mProperties.getNumDofs())
+    throw std::invalid_argument("Incorrect number of positions.");
+
+  // Read the positions directly rather than through getPositions, which
+  // allocates a vector.
+  setFromPositions(
+      [&](std::size_t dofIndex) {
+        return _metaskeleton->getPosition(dofIndex);
+      },
+      _state);
 }
 
 //==============================================================================
@@ -368,9 +464,14 @@ auto MetaSkeletonStateSpace::getScopedStateFromMetaSkeleton(
 void MetaSkeletonStateSpace::setState(
     ::dart::dynamics::MetaSkeleton* _metaskeleton, const State* _state) const
 {
-  Eigen::VectorXd positions;
-  convertStateToPositions(_state, positions);
-  _metaskeleton->setPositions(positions);
+  if (_metaskeleton->getNumDofs() != mProperties.getNumDofs())
+    throw std::invalid_argument("Incorrect number of positions.");
+
+  // Write the positions directly rather than through setPositions, which sets
+  // them one DOF at a time anyway.
+  forEachPosition(_state, [&](std::size_t dofIndex, double position) {
+    _metaskeleton->setPosition(dofIndex, position);
+  });
 }
 
 //==============================================================================
@@ -6,6 +6,9 @@
 
 #include "aikido/common/StepSequence.hpp"
 #include "aikido/common/memory.hpp"
+#include "aikido/statespace/CartesianProduct.hpp"
+#include "aikido/statespace/Rn.hpp"
+#include "aikido/statespace/SO2.hpp"
 
 namespace aikido {
 namespace trajectory {
@@ -25,6 +28,48 @@ void throwIfInvalidIndex(
   }
 }
 
+//==============================================================================
+/// Returns true if the derivatives of the coordinates of \c stateSpace are
+/// its tangent vectors in the local frame, i.e. if it is a real vector space,
+/// SO2 or a Cartesian product of them.
+bool hasLinearCoordinates(const statespace::StateSpace* stateSpace)
+{
+  using namespace statespace;
+
+  if (dynamic_cast<const R0*>(stateSpace) || dynamic_cast<const R1*>(stateSpace)
+      || dynamic_cast<const R2*>(stateSpace)
+      || dynamic_cast<const R3*>(stateSpace)
+      || dynamic_cast<const R6*>(stateSpace)
+      || dynamic_cast<const Rn*>(stateSpace)
+      || dynamic_cast<const SO2*>(stateSpace))
+  {
+    return true;
+  }
+
+  if (auto space = dynamic_cast<const CartesianProduct*>(stateSpace))
+  {
+    for (auto i = 0u; i < space->getNumSubspaces(); ++i)
+    {
+      if (!hasLinearCoordinates(space->getSubspace<>(i).get()))
+        return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+void throwIfDerivativeUnsupported(const statespace::StateSpace* stateSpace)
+{
+  if (!hasLinearCoordinates(stateSpace))
+  {
+    throw std::invalid_argument(
+        "Derivatives are only supported in real vector spaces, SO2 and "
+        "Cartesian products of them.");
+  }
+}
+
 } // namespace
 
 //==============================================================================
@@ -468,24 +513,98 @@ void BSpline::evaluate(double t, statespace::StateSpace::State* state) const
 {
   throwIfInvalidTime(*this, t);
 
-  Eigen::VectorXd values(mStateSpace->getDimension());
-
-  for (auto i = 0u; i < mStateSpace->getDimension(); ++i)
-    values[i] = mSplines[i](t)[0];
+  Eigen::VectorXd values;
+  evaluateCoordinates(t, 0, values);
 
   mStateSpace->expMap(values, state);
 }
 
 //==============================================================================
 void BSpline::evaluateDerivative(
-    double t, int derivative, Eigen::VectorXd& /*tangentVector*/) const
+    double t, int derivative, Eigen::VectorXd& tangentVector) const
 {
   throwIfInvalidTime(*this, t);
 
   if (derivative < 1)
     throw std::invalid_argument("Derivative must be positive.");
 
-  // TODO(JS): Not implemented
+  throwIfDerivativeUnsupported(mStateSpace.get());
+
+  evaluateCoordinates(t, derivative, tangentVector);
+}
+
+//==============================================================================
+void BSpline::evaluateBatch(
+    const Eigen::VectorXd& times,
+    Eigen::MatrixXd& values,
+    int derivative,
+    common::ThreadPool* threadPool) const
+{
+  for (int i = 0; i < times.size(); ++i)
+    throwIfInvalidTime(*this, times[i]);
+
+  if (derivative < 0)
+    throw std::invalid_argument("Derivative must be non-negative.");
+
+  if (derivative > 0)
+    throwIfDerivativeUnsupported(mStateSpace.get());
+
+  const auto dimension = mStateSpace->getDimension();
+  values.resize(times.size(), dimension);
+
+  forEachTimeRange(
+      times.size(), threadPool, [&](std::size_t begin, std::size_t end) {
+        auto state = mStateSpace->createState();
+        Eigen::VectorXd coordinates(dimension);
+        Eigen::VectorXd tangentVector(dimension);
+
+        for (auto i = begin; i < end; ++i)
+        {
+          evaluateCoordinates(times[i], derivative, coordinates);
+
+          if (derivative == 0)
+          {
+            mStateSpace->expMap(coordinates, state);
+            mStateSpace->logMap(state, tangentVector);
+            values.row(i) = tangentVector.transpose();
+          }
+          else
+          {
+            values.row(i) = coordinates.transpose();
+          }
+        }
+      });
+}
+
+//==============================================================================
+void BSpline::evaluateCoordinates(
+    double t, int derivative, Eigen::VectorXd& values) const
+{
+  values.resize(mStateSpace->getDimension());
+
+  if (mSplines.empty())
+    return;
+
+  // All dimensions share the same knots, hence the same basis functions.
+  const auto& firstSpline = mSplines.front();
+  const auto degree = firstSpline.degree();
+
+  if (derivative > degree)
+  {
+    values.setZero();
+    return;
+  }
+
+  const auto span = firstSpline.span(t);
+  const auto basisDerivatives
+      = firstSpline.basisFunctionDerivatives(t, derivative);
+
+  for (auto i = 0u; i < mSplines.size(); ++i)
+  {
+    values[i] = (mSplines[i].ctrls().segment(span - degree, degree + 1)
+                 * basisDerivatives.row(derivative))
+                    .sum();
+  }
 }
 
 //==============================================================================
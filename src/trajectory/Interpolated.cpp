@@ -1,5 +1,7 @@
 #include "aikido/trajectory/Interpolated.hpp"
 
+#include <algorithm>
+
 using aikido::statespace::GeodesicInterpolator;
 
 namespace aikido {
@@ -11,7 +13,9 @@ using State = aikido::statespace::StateSpace::State;
 Interpolated::Interpolated(
     statespace::ConstStateSpacePtr _stateSpace,
     statespace::ConstInterpolatorPtr _interpolator)
-  : mStateSpace(std::move(_stateSpace)), mInterpolator(std::move(_interpolator))
+  : mStateSpace(std::move(_stateSpace))
+  , mInterpolator(std::move(_interpolator))
+  , mLastWaypointIndex(0u)
 {
   // Do nothing
 }
@@ -75,78 +79,122 @@ void Interpolated::evaluate(double _t, State* _state) const
     throw std::invalid_argument(
         "Requested trajectory point from an empty trajectory");
 
-  try
+  evaluateSegment(getWaypointIndexAfterTime(_t), _t, _state);
+}
+
+//==============================================================================
+void Interpolated::evaluateSegment(
+    std::size_t _index, double _t, State* _state) const
+{
+  if (_index == 0)
   {
-    int idx = getWaypointIndexAfterTime(_t);
-    if (idx == 0)
-    {
-      // Time before beginning of trajectory - return first waypoint
-      mStateSpace->copyState(mWaypoints[0].state, _state);
-    }
-    else
-    {
-      Waypoint currentWpt = mWaypoints[idx];
-      Waypoint prevWpt = mWaypoints[idx - 1];
-      mInterpolator->interpolate(
-          prevWpt.state,
-          currentWpt.state,
-          (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
-          _state);
-    }
+    // Time before beginning of trajectory - return first waypoint
+    mStateSpace->copyState(mWaypoints.front().state, _state);
   }
-  catch (const std::domain_error& e)
+  else if (_index == mWaypoints.size())
   {
     // Time past end of trajectory - return last waypoint
     mStateSpace->copyState(mWaypoints.back().state, _state);
   }
+  else
+  {
+    const auto& currentWpt = mWaypoints[_index];
+    const auto& prevWpt = mWaypoints[_index - 1];
+    mInterpolator->interpolate(
+        prevWpt.state,
+        currentWpt.state,
+        (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
+        _state);
+  }
 }
 
 //==============================================================================
 void Interpolated::evaluateDerivative(
     double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
 {
+  if (mWaypoints.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
+
   if (_derivative == 0)
     throw std::invalid_argument(
         "0th derivative not available. Use evaluate(t, state).");
 
-  if (static_cast<std::size_t>(_derivative)
-      > mInterpolator->getNumDerivatives())
+  evaluateSegmentDerivative(
+      getWaypointIndexAfterTime(_t), _t, _derivative, _tangentVector);
+}
+
+//==============================================================================
+void Interpolated::evaluateSegmentDerivative(
+    std::size_t _index,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _tangentVector) const
+{
+  // Time before beginning or past end of trajectory - return zero
+  if (_index == 0 || _index == mWaypoints.size()
+      || static_cast<std::size_t>(_derivative)
+             > mInterpolator->getNumDerivatives())
   {
     _tangentVector.resize(mStateSpace->getDimension());
     _tangentVector.setZero();
+    return;
   }
 
-  // Compute the interpolated state at time t
-  auto iPt = mStateSpace->createState();
-  evaluate(_t, iPt);
-
-  // Compute the endpoint of the segment
-  try
-  {
-    int idx = getWaypointIndexAfterTime(_t);
+  const auto segmentTime = mWaypoints[_index].t - mWaypoints[_index - 1].t;
+  const auto alpha = (_t - mWaypoints[_index - 1].t) / segmentTime;
 
-    // Time before beginning of trajectory - return 0
-    if (idx == 0)
-      throw std::domain_error("Time is before the trajectory starts.");
+  mInterpolator->getDerivative(
+      mWaypoints[_index - 1].state,
+      mWaypoints[_index].state,
+      _derivative,
+      alpha,
+      _tangentVector);
 
-    const auto segmentTime = mWaypoints[idx].t - mWaypoints[idx - 1].t;
-    const auto alpha = (_t - mWaypoints[idx - 1].t) / segmentTime;
+  _tangentVector /= segmentTime;
+}
 
-    mInterpolator->getDerivative(
-        mWaypoints[idx - 1].state,
-        mWaypoints[idx].state,
-        _derivative,
-        alpha,
-        _tangentVector);
+//==============================================================================
+void Interpolated::evaluateBatch(
+    const Eigen::VectorXd& _times,
+    Eigen::MatrixXd& _values,
+    int _derivative,
+    common::ThreadPool* _threadPool) const
+{
+  if (mWaypoints.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
 
-    _tangentVector /= segmentTime;
-  }
-  // Time past end of trajectory - return zero
-  catch (const std::domain_error& e)
-  {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
-  }
+  if (_derivative < 0)
+    throw std::invalid_argument("Derivative must be non-negative.");
+
+  const auto dimension = mStateSpace->getDimension();
+  _values.resize(_times.size(), dimension);
+
+  forEachTimeRange(
+      _times.size(), _threadPool, [&](std::size_t begin, std::size_t end) {
+        auto state = mStateSpace->createState();
+        Eigen::VectorXd tangentVector(dimension);
+        std::size_t idx = 0;
+
+        for (auto i = begin; i < end; ++i)
+        {
+          idx = getWaypointIndexAfterTime(_times[i], idx);
+
+          if (_derivative == 0)
+          {
+            evaluateSegment(idx, _times[i], state);
+            mStateSpace->logMap(state, tangentVector);
+          }
+          else
+          {
+            evaluateSegmentDerivative(
+                idx, _times[i], _derivative, tangentVector);
+          }
+
+          _values.row(i) = tangentVector.transpose();
+        }
+      });
 }
 
 //==============================================================================
@@ -186,16 +234,38 @@ std::size_t Interpolated::getNumWaypoints() const
 }
 
 //==============================================================================
-int Interpolated::getWaypointIndexAfterTime(double _t) const
+std::size_t Interpolated::getWaypointIndexAfterTime(double _t) const
 {
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  if (it == mWaypoints.end())
-  {
-    throw std::domain_error(
-        "_t is larger than the time value on the last waypoint.");
-  }
+  const auto hint = mLastWaypointIndex.load(std::memory_order_relaxed);
+  const auto idx = getWaypointIndexAfterTime(_t, hint);
+  if (idx != hint)
+    mLastWaypointIndex.store(idx, std::memory_order_relaxed);
 
-  return std::distance(mWaypoints.begin(), it);
+  return idx;
+}
+
+//==============================================================================
+std::size_t Interpolated::getWaypointIndexAfterTime(
+    double _t, std::size_t _hint) const
+{
+  const auto numWaypoints = mWaypoints.size();
+  const auto isIndexAfterTime = [&](std::size_t idx) {
+    if (idx > numWaypoints)
+      return false;
+    if (idx > 0 && mWaypoints[idx - 1].t >= _t)
+      return false;
+    return idx == numWaypoints || mWaypoints[idx].t >= _t;
+  };
+
+  if (isIndexAfterTime(_hint))
+    return _hint;
+
+  if (isIndexAfterTime(_hint + 1))
+    return _hint + 1;
+
+  return std::distance(
+      mWaypoints.begin(),
+      std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t));
 }
 
 //==============================================================================
@@ -1,13 +1,13 @@
 #include "aikido/trajectory/Spline.hpp"
 
-#include "aikido/common/Spline.hpp"
+#include <algorithm>
 
 namespace aikido {
 namespace trajectory {
 
 //==============================================================================
 Spline::Spline(statespace::ConstStateSpacePtr _stateSpace, double _startTime)
-  : mStateSpace(std::move(_stateSpace)), mStartTime(_startTime)
+  : mStateSpace(std::move(_stateSpace)), mStartTime(_startTime), mDuration(0.)
 {
   if (mStateSpace == nullptr)
     throw std::invalid_argument("StateSpace is null.");
@@ -38,11 +38,32 @@ void Spline::addSegment(
 
   PolynomialSegment segment;
   segment.mCoefficients = _coefficients;
+
+  // Differentiate the polynomial once here, instead of on every evaluation.
+  const auto numCoefficients = _coefficients.cols();
+  segment.mDerivativeCoefficients.reserve(numCoefficients - 1);
+  for (int iderivative = 1; iderivative < numCoefficients; ++iderivative)
+  {
+    const auto& previous = iderivative == 1
+                               ? segment.mCoefficients
+                               : segment.mDerivativeCoefficients.back();
+
+    Eigen::MatrixXd derivative(previous.rows(), previous.cols() - 1);
+    for (int icoeff = 0; icoeff < derivative.cols(); ++icoeff)
+      derivative.col(icoeff) = (icoeff + 1) * previous.col(icoeff + 1);
+
+    segment.mDerivativeCoefficients.emplace_back(std::move(derivative));
+  }
   segment.mDuration = _duration;
   segment.mStartState = mStateSpace->allocateState();
   mStateSpace->copyState(_startState, segment.mStartState);
 
   mSegments.emplace_back(std::move(segment));
+
+  const auto segmentStartTime
+      = mSegmentEndTimes.empty() ? mStartTime : mSegmentEndTimes.back();
+  mSegmentEndTimes.emplace_back(segmentStartTime + _duration);
+  mDuration += _duration;
 }
 
 //==============================================================================
@@ -102,12 +123,7 @@ double Spline::getEndTime() const
 //==============================================================================
 double Spline::getDuration() const
 {
-  double duration = 0.;
-
-  for (const auto& segment : mSegments)
-    duration += segment.mDuration;
-
-  return duration;
+  return mDuration;
 }
 
 //==============================================================================
@@ -117,17 +133,16 @@ void Spline::evaluate(double _t, statespace::StateSpace::State* _out) const
     throw std::logic_error("Unable to evaluate empty trajectory.");
 
   const auto targetSegmentInfo = getSegmentForTime(_t);
-  const auto& targetSegment = mSegments[targetSegmentInfo.first];
-
-  mStateSpace->copyState(targetSegment.mStartState, _out);
-
-  const auto evaluationTime = _t - targetSegmentInfo.second;
-  const auto tangentVector
-      = evaluatePolynomial(targetSegment.mCoefficients, evaluationTime, 0);
 
+  Eigen::VectorXd tangentVector;
   auto relativeState = mStateSpace->createState();
-  mStateSpace->expMap(tangentVector, relativeState);
-  mStateSpace->compose(_out, relativeState);
+  evaluateSegment(
+      targetSegmentInfo.first,
+      targetSegmentInfo.second,
+      _t,
+      _out,
+      tangentVector,
+      relativeState);
 }
 
 //==============================================================================
@@ -140,66 +155,147 @@ void Spline::evaluateDerivative(
     throw std::logic_error("Derivative must be positive.");
 
   const auto targetSegmentInfo = getSegmentForTime(_t);
-  const auto& targetSegment = mSegments[targetSegmentInfo.first];
-  const auto evaluationTime = _t - targetSegmentInfo.second;
+  evaluateSegmentDerivative(
+      targetSegmentInfo.first,
+      targetSegmentInfo.second,
+      _t,
+      _derivative,
+      _tangentVector);
+}
 
-  // Return zero for higher-order derivatives.
-  if (_derivative < targetSegment.mCoefficients.cols())
-  {
-    // TODO: We should transform this into the body frame using the adjoint
-    // transformation.
-    _tangentVector = evaluatePolynomial(
-        targetSegment.mCoefficients, evaluationTime, _derivative);
-  }
-  else
-  {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
-  }
+//==============================================================================
+void Spline::evaluateBatch(
+    const Eigen::VectorXd& _times,
+    Eigen::MatrixXd& _values,
+    int _derivative,
+    common::ThreadPool* _threadPool) const
+{
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+  if (_derivative < 0)
+    throw std::logic_error("Derivative must be non-negative.");
+
+  const auto dimension = mStateSpace->getDimension();
+  _values.resize(_times.size(), dimension);
+
+  forEachTimeRange(
+      _times.size(), _threadPool, [&](std::size_t begin, std::size_t end) {
+        Cursor cursor(*this);
+        auto state = mStateSpace->createState();
+        Eigen::VectorXd tangentVector(dimension);
+
+        for (auto i = begin; i < end; ++i)
+        {
+          if (_derivative == 0)
+          {
+            cursor.evaluate(_times[i], state);
+            mStateSpace->logMap(state, tangentVector);
+          }
+          else
+          {
+            cursor.evaluateDerivative(_times[i], _derivative, tangentVector);
+          }
+
+          _values.row(i) = tangentVector.transpose();
+        }
+      });
 }
 
 //==============================================================================
 std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
 {
-  auto segmentStartTime = mStartTime;
+  // Find the first segment that ends at or after _t. Times after the end of
+  // the last segment are evaluated on the last segment.
+  auto isegment = static_cast<std::size_t>(
+      std::lower_bound(mSegmentEndTimes.begin(), mSegmentEndTimes.end(), _t)
+      - mSegmentEndTimes.begin());
+  isegment = std::min(isegment, mSegments.size() - 1);
 
-  for (std::size_t isegment = 0; isegment < mSegments.size(); ++isegment)
-  {
-    const auto& segment = mSegments[isegment];
-    const auto nextSegmentStartTime = segmentStartTime + segment.mDuration;
+  return std::make_pair(
+      isegment, isegment == 0 ? mStartTime : mSegmentEndTimes[isegment - 1]);
+}
 
-    if (_t <= nextSegmentStartTime)
-      return std::make_pair(isegment, segmentStartTime);
+//==============================================================================
+std::pair<std::size_t, double> Spline::getSegmentForTime(
+    double _t, std::size_t _hint) const
+{
+  if (_hint >= mSegments.size()
+      || (_hint > 0 && _t <= mSegmentEndTimes[_hint - 1]))
+    return getSegmentForTime(_t);
 
-    segmentStartTime = nextSegmentStartTime;
+  auto isegment = _hint;
+  if (_t > mSegmentEndTimes[isegment] && isegment + 1 < mSegments.size())
+  {
+    ++isegment;
+    if (_t > mSegmentEndTimes[isegment])
+      return getSegmentForTime(_t);
   }
 
-  // After the end of the last segment.
   return std::make_pair(
-      mSegments.size() - 1, segmentStartTime - mSegments.back().mDuration);
+      isegment, isegment == 0 ? mStartTime : mSegmentEndTimes[isegment - 1]);
 }
 
 //==============================================================================
-Eigen::VectorXd Spline::evaluatePolynomial(
-    const Eigen::MatrixXd& _coefficients, double _t, int _derivative)
+void Spline::evaluateSegment(
+    std::size_t _index,
+    double _segmentStartTime,
+    double _t,
+    statespace::StateSpace::State* _out,
+    Eigen::VectorXd& _tangentVector,
+    statespace::StateSpace::State* _relativeState) const
 {
-  const auto numOutputs = _coefficients.rows();
-  const auto numCoeffs = _coefficients.cols();
+  const auto& targetSegment = mSegments[_index];
 
-  const auto timeVector
-      = common::SplineProblem<>::createTimeVector(_t, _derivative, numCoeffs);
-  const auto derivativeMatrix
-      = common::SplineProblem<>::createCoefficientMatrix(numCoeffs);
-  const auto derivativeVector = derivativeMatrix.row(_derivative);
-  const auto evaluationVector
-      = derivativeVector.cwiseProduct(timeVector.transpose());
+  mStateSpace->copyState(targetSegment.mStartState, _out);
 
-  Eigen::VectorXd outputVector(numOutputs);
+  const auto evaluationTime = _t - _segmentStartTime;
+  evaluatePolynomial(
+      targetSegment.mCoefficients, evaluationTime, _tangentVector);
 
-  for (int ioutput = 0; ioutput < numOutputs; ++ioutput)
-    outputVector[ioutput] = _coefficients.row(ioutput).dot(evaluationVector);
+  mStateSpace->expMap(_tangentVector, _relativeState);
+  mStateSpace->compose(_out, _relativeState);
+}
 
-  return outputVector;
+//==============================================================================
+void Spline::evaluateSegmentDerivative(
+    std::size_t _index,
+    double _segmentStartTime,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _tangentVector) const
+{
+  const auto& targetSegment = mSegments[_index];
+  const auto evaluationTime = _t - _segmentStartTime;
+
+  // Return zero for higher-order derivatives.
+  if (_derivative < targetSegment.mCoefficients.cols())
+  {
+    // TODO: We should transform this into the body frame using the adjoint
+    // transformation.
+    evaluatePolynomial(
+        targetSegment.mDerivativeCoefficients[_derivative - 1],
+        evaluationTime,
+        _tangentVector);
+  }
+  else
+  {
+    _tangentVector.resize(mStateSpace->getDimension());
+    _tangentVector.setZero();
+  }
+}
+
+//==============================================================================
+void Spline::evaluatePolynomial(
+    const Eigen::MatrixXd& _coefficients, double _t, Eigen::VectorXd& _output)
+{
+  const auto numCoeffs = _coefficients.cols();
+
+  _output = _coefficients.col(numCoeffs - 1);
+  for (auto icoeff = numCoeffs - 1; icoeff > 0; --icoeff)
+  {
+    _output *= _t;
+    _output += _coefficients.col(icoeff - 1);
+  }
 }
 
 //==============================================================================
@@ -211,15 +307,10 @@ std::size_t Spline::getNumWaypoints() const
 //==============================================================================
 double Spline::getWaypointTime(std::size_t _index) const
 {
-  double waypointTime = mStartTime;
-
   if (_index >= getNumWaypoints())
     throw std::domain_error("Waypoint index is out of bounds.");
 
-  for (std::size_t i = 0; i < _index; ++i)
-    waypointTime += mSegments[i].mDuration;
-
-  return waypointTime;
+  return _index == 0 ? mStartTime : mSegmentEndTimes[_index - 1];
 }
 
 //==============================================================================
@@ -271,5 +362,63 @@ const aikido::statespace::StateSpace::State* Spline::getSegmentStartState(
   return mSegments[_index].mStartState;
 }
 
+//==============================================================================
+Spline::Cursor::Cursor(const Spline& _spline)
+  : mSpline(_spline)
+  , mSegmentIndex(0u)
+  , mRelativeState(mSpline.mStateSpace->createState())
+  , mTangentVector(mSpline.mStateSpace->getDimension())
+{
+  // Do nothing
+}
+
+//==============================================================================
+void Spline::Cursor::evaluate(double _t, statespace::StateSpace::State* _state)
+{
+  if (mSpline.mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  const auto targetSegmentInfo = mSpline.getSegmentForTime(_t, mSegmentIndex);
+  mSegmentIndex = targetSegmentInfo.first;
+  mSpline.evaluateSegment(
+      targetSegmentInfo.first,
+      targetSegmentInfo.second,
+      _t,
+      _state,
+      mTangentVector,
+      mRelativeState);
+}
+
+//==============================================================================
+void Spline::Cursor::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector)
+{
+  if (mSpline.mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+  if (_derivative < 1)
+    throw std::logic_error("Derivative must be positive.");
+
+  const auto targetSegmentInfo = mSpline.getSegmentForTime(_t, mSegmentIndex);
+  mSegmentIndex = targetSegmentInfo.first;
+  mSpline.evaluateSegmentDerivative(
+      targetSegmentInfo.first,
+      targetSegmentInfo.second,
+      _t,
+      _derivative,
+      _tangentVector);
+}
+
+//==============================================================================
+std::size_t Spline::Cursor::getSegmentIndex() const
+{
+  return mSegmentIndex;
+}
+
+//==============================================================================
+void Spline::Cursor::reset()
+{
+  mSegmentIndex = 0u;
+}
+
 } // namespace trajectory
 } // namespace aikido
@@ -0,0 +1,84 @@
+#include "aikido/trajectory/Trajectory.hpp"
+
+#include <algorithm>
+#include <future>
+
+namespace aikido {
+namespace trajectory {
+namespace {
+
+/// Batches with fewer times per thread than this are evaluated on the calling
+/// thread, where the overhead of synchronization would dominate.
+constexpr std::size_t minNumTimesPerThread = 256u;
+
+} // namespace
+
+//==============================================================================
+void Trajectory::evaluateBatch(
+    const Eigen::VectorXd& _times,
+    Eigen::MatrixXd& _values,
+    int _derivative,
+    common::ThreadPool* /*_threadPool*/) const
+{
+  const auto stateSpace = getStateSpace();
+  _values.resize(_times.size(), stateSpace->getDimension());
+
+  auto state = stateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < _times.size(); ++i)
+  {
+    if (_derivative == 0)
+    {
+      evaluate(_times[i], state);
+      stateSpace->logMap(state, tangentVector);
+    }
+    else
+    {
+      evaluateDerivative(_times[i], _derivative, tangentVector);
+    }
+
+    _values.row(i) = tangentVector.transpose();
+  }
+}
+
+//==============================================================================
+void Trajectory::forEachTimeRange(
+    std::size_t _numTimes,
+    common::ThreadPool* _threadPool,
+    const std::function<void(std::size_t, std::size_t)>& _function)
+{
+  std::size_t numRanges = 1u;
+  if (_threadPool)
+  {
+    numRanges = std::min(
+        _threadPool->getNumThreads(), _numTimes / minNumTimesPerThread);
+  }
+
+  if (numRanges <= 1u)
+  {
+    _function(0u, _numTimes);
+    return;
+  }
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(numRanges);
+
+  for (std::size_t irange = 0; irange < numRanges; ++irange)
+  {
+    const auto begin = _numTimes * irange / numRanges;
+    const auto end = _numTimes * (irange + 1) / numRanges;
+    futures.emplace_back(_threadPool->submit(
+        [&_function, begin, end]() { _function(begin, end); }));
+  }
+
+  // Wait for all ranges before rethrowing, since they refer to the caller's
+  // data.
+  for (auto& future : futures)
+    future.wait();
+
+  for (auto& future : futures)
+    future.get();
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -167,19 +167,28 @@ double findTimeOfClosestStateOnTrajectory(
   const common::StepSequence sequence(
       timeStep, true, true, traj.getStartTime(), traj.getEndTime());
 
+  Eigen::VectorXd times(sequence.getLength());
+  for (std::size_t i = 0; i < sequence.getLength(); ++i)
+    times[i] = sequence[i];
+
+  Eigen::MatrixXd positions;
+  traj.evaluateBatch(times, positions);
+
   auto metric = createDistanceMetric(stateSpace);
   auto currState = stateSpace->createState();
+  Eigen::VectorXd currPosition;
 
-  for (const double currTime : sequence)
+  for (int i = 0; i < times.size(); ++i)
   {
-    traj.evaluate(currTime, currState);
+    currPosition = positions.row(i).transpose();
+    stateSpace->expMap(currPosition, currState);
 
     auto currDist = metric->distance(currState, referenceState);
 
     if (currDist < minDist)
     {
       minDist = currDist;
-      timeOfClosestState = currTime;
+      timeOfClosestState = times[i];
     }
   }
 
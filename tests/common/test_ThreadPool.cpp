@@ -0,0 +1,67 @@
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <aikido/common/ThreadPool.hpp>
+
+using aikido::common::ThreadPool;
+
+//==============================================================================
+TEST(ThreadPool, DefaultNumThreadsIsPositive)
+{
+  ThreadPool pool;
+  EXPECT_GE(pool.getNumThreads(), 1u);
+  EXPECT_EQ(ThreadPool::getDefaultNumThreads(), pool.getNumThreads());
+}
+
+//==============================================================================
+TEST(ThreadPool, SubmitReturnsValue)
+{
+  ThreadPool pool(2);
+  EXPECT_EQ(2u, pool.getNumThreads());
+
+  auto future = pool.submit([]() { return 42; });
+  EXPECT_EQ(42, future.get());
+}
+
+//==============================================================================
+TEST(ThreadPool, ExecutesAllTasks)
+{
+  std::atomic<int> numCalled{0};
+
+  {
+    ThreadPool pool(4);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 100; ++i)
+      futures.emplace_back(pool.submit([&numCalled]() { ++numCalled; }));
+
+    for (auto& future : futures)
+      future.get();
+  }
+
+  EXPECT_EQ(100, numCalled.load());
+}
+
+//==============================================================================
+TEST(ThreadPool, DestructorFinishesQueuedTasks)
+{
+  std::atomic<int> numCalled{0};
+
+  {
+    ThreadPool pool(1);
+    for (int i = 0; i < 10; ++i)
+      pool.submit([&numCalled]() { ++numCalled; });
+  }
+
+  EXPECT_EQ(10, numCalled.load());
+}
+
+//==============================================================================
+TEST(ThreadPool, PropagatesExceptions)
+{
+  ThreadPool pool(1);
+  auto future
+      = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
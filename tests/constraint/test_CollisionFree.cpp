@@ -228,3 +228,72 @@ TEST_F(CollisionFreeTest, AddAndRemoveSelfCheckFails_IsSatisfied)
   constraint.removeSelfCheck(mCollisionGroup3);
   EXPECT_TRUE(constraint.isSatisfied(state));
 }
+
+TEST_F(CollisionFreeTest, IsSatisfiedBatchMatchesIsSatisfied)
+{
+  CollisionFree constraint(mStateSpace, mSkeleton, mCollisionDetector);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  EXPECT_EQ(1u, constraint.getNumBatchWorkers());
+  constraint.setNumBatchWorkers(3);
+  EXPECT_EQ(3u, constraint.getNumBatchWorkers());
+
+  const Eigen::VectorXd originalPositions = mSkeleton->getPositions();
+
+  std::vector<MetaSkeletonStateSpace::ScopedState> scopedStates;
+  std::vector<const aikido::statespace::StateSpace::State*> states;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+    position(4) = (i % 3 == 0) ? 0 : 5;
+
+    scopedStates.emplace_back(mStateSpace->createState());
+    mStateSpace->convertPositionsToState(position, scopedStates.back());
+  }
+  for (const auto& scopedState : scopedStates)
+    states.emplace_back(scopedState.getState());
+
+  const auto satisfied = constraint.isSatisfiedBatch(states);
+  ASSERT_EQ(states.size(), satisfied.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    EXPECT_EQ(i % 3 != 0, satisfied[i]);
+    EXPECT_EQ(constraint.isSatisfied(states[i]), satisfied[i]);
+  }
+
+  // The batch is tested on clones, so the MetaSkeleton is left untouched.
+  EXPECT_TRUE(mSkeleton->getPositions().isApprox(originalPositions));
+}
+
+TEST_F(CollisionFreeTest, IsSatisfiedBatchReportsFirstFailure)
+{
+  CollisionFree constraint(mStateSpace, mSkeleton, mCollisionDetector);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.setNumBatchWorkers(2);
+
+  std::vector<MetaSkeletonStateSpace::ScopedState> scopedStates;
+  std::vector<const aikido::statespace::StateSpace::State*> states;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+    position(4) = (i == 5 || i == 7) ? 0 : 5;
+
+    scopedStates.emplace_back(mStateSpace->createState());
+    mStateSpace->convertPositionsToState(position, scopedStates.back());
+  }
+  for (const auto& scopedState : scopedStates)
+    states.emplace_back(scopedState.getState());
+
+  std::size_t firstFailure = 0;
+  auto satisfied = constraint.isSatisfiedBatch(states, &firstFailure);
+  EXPECT_EQ(5u, firstFailure);
+  for (std::size_t i = 0; i < firstFailure; ++i)
+    EXPECT_TRUE(satisfied[i]);
+  EXPECT_FALSE(satisfied[firstFailure]);
+
+  // Re-registering the checks recreates the clones.
+  constraint.removePairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  states.resize(5);
+  satisfied = constraint.isSatisfiedBatch(states, &firstFailure);
+  EXPECT_EQ(states.size(), firstFailure);
+}
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <aikido/common/RNG.hpp>
+#include <aikido/common/ThreadPool.hpp>
 #include <aikido/constraint/CyclicSampleable.hpp>
 #include <aikido/constraint/FiniteSampleable.hpp>
 #include <aikido/constraint/dart/InverseKinematicsSampleable.hpp>
@@ -415,3 +416,120 @@ TEST_F(InverseKinematicsSampleableTest, SampleGeneratorIkInfeasible)
       = mStateSpace1->getScopedStateFromMetaSkeleton(mManipulator1.get());
   ASSERT_FALSE(generator->sample(state));
 }
+
+TEST_F(InverseKinematicsSampleableTest, ParallelSampleGeneratorMatchesSerial)
+{
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(2, 0) = 1;
+  Bw(2, 1) = 3;
+  mTsr->mBw = Bw;
+
+  auto seedState
+      = mStateSpace2->getScopedStateFromMetaSkeleton(mManipulator2.get());
+  Eigen::Isometry3d isometry(Eigen::Isometry3d::Identity());
+  isometry.translation() = Eigen::Vector3d(0.1, 0.1, 0.1);
+  seedState.getSubStateHandle<SE3>(0).setIsometry(isometry);
+  seedState.getSubStateHandle<SO2>(1).fromAngle(0.1);
+
+  std::shared_ptr<CyclicSampleable> seedConstraint(new CyclicSampleable(
+      std::make_shared<FiniteSampleable>(mStateSpace2, seedState)));
+
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace2,
+      mManipulator2,
+      mTsr,
+      seedConstraint,
+      mInverseKinematics2,
+      1);
+  EXPECT_EQ(1u, ikConstraint.getNumWorkers());
+
+  auto serialGenerator = ikConstraint.createSampleGenerator();
+
+  ikConstraint.setNumWorkers(4);
+  EXPECT_EQ(4u, ikConstraint.getNumWorkers());
+  auto parallelGenerator = ikConstraint.createSampleGenerator();
+
+  // With one trial per sample, both generators draw the same seeds and poses.
+  const Eigen::VectorXd positions = mManipulator2->getPositions();
+  for (int i = 0; i < 10; i++)
+  {
+    auto state1 = mStateSpace2->createState();
+    auto state2 = mStateSpace2->createState();
+
+    ASSERT_TRUE(parallelGenerator->sample(state2));
+    EXPECT_TRUE(positions.isApprox(mManipulator2->getPositions()));
+
+    ASSERT_TRUE(serialGenerator->sample(state1));
+    mManipulator2->setPositions(positions);
+
+    EXPECT_TRUE(state1.getSubStateHandle<SE3>(0).getIsometry().isApprox(
+        state2.getSubStateHandle<SE3>(0).getIsometry()));
+    EXPECT_DOUBLE_EQ(
+        state1.getSubStateHandle<SO2>(1).toAngle(),
+        state2.getSubStateHandle<SO2>(1).toAngle());
+  }
+
+  ikConstraint.setNumWorkers(0);
+  EXPECT_EQ(
+      aikido::common::ThreadPool::getDefaultNumThreads(),
+      ikConstraint.getNumWorkers());
+}
+
+TEST_F(InverseKinematicsSampleableTest, ParallelSampleGeneratorKeepsUnusedTrials)
+{
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(2, 0) = 1;
+  Bw(2, 1) = 3;
+  mTsr->mBw = Bw;
+
+  Eigen::Isometry3d isometry(Eigen::Isometry3d::Identity());
+  isometry.translation() = Eigen::Vector3d(0.1, 0.1, 0.1);
+
+  std::vector<MetaSkeletonStateSpace::ScopedState> seedStates;
+  std::vector<const aikido::statespace::StateSpace::State*> seeds;
+  for (int i = 0; i < 3; ++i)
+  {
+    seedStates.emplace_back(
+        mStateSpace2->getScopedStateFromMetaSkeleton(mManipulator2.get()));
+    seedStates.back().getSubStateHandle<SE3>(0).setIsometry(isometry);
+    seedStates.back().getSubStateHandle<SO2>(1).fromAngle(0.1 * (i + 1));
+  }
+  for (const auto& seedState : seedStates)
+    seeds.emplace_back(seedState.getState());
+
+  // Each sample succeeds on its first trial, so the first round of the
+  // parallel generator draws seeds that later samples need.
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace2,
+      mManipulator2,
+      mTsr,
+      std::make_shared<FiniteSampleable>(mStateSpace2, seeds),
+      mInverseKinematics2,
+      3);
+
+  auto serialGenerator = ikConstraint.createSampleGenerator();
+  ikConstraint.setNumWorkers(4);
+  auto parallelGenerator = ikConstraint.createSampleGenerator();
+
+  const Eigen::VectorXd positions = mManipulator2->getPositions();
+  for (int i = 0; i < 3; i++)
+  {
+    auto state1 = mStateSpace2->createState();
+    auto state2 = mStateSpace2->createState();
+
+    ASSERT_TRUE(parallelGenerator->canSample());
+    ASSERT_TRUE(parallelGenerator->sample(state2));
+
+    ASSERT_TRUE(serialGenerator->sample(state1));
+    mManipulator2->setPositions(positions);
+
+    EXPECT_TRUE(state1.getSubStateHandle<SE3>(0).getIsometry().isApprox(
+        state2.getSubStateHandle<SE3>(0).getIsometry()));
+    EXPECT_DOUBLE_EQ(
+        state1.getSubStateHandle<SO2>(1).toAngle(),
+        state2.getSubStateHandle<SO2>(1).toAngle());
+  }
+
+  EXPECT_FALSE(serialGenerator->canSample());
+  EXPECT_FALSE(parallelGenerator->canSample());
+}
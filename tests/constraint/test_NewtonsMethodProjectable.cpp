@@ -1,3 +1,6 @@
+#include <thread>
+#include <vector>
+
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
 
@@ -12,8 +15,56 @@ using aikido::constraint::NewtonsMethodProjectable;
 using aikido::constraint::Satisfied;
 using aikido::constraint::dart::TSR;
 using aikido::statespace::R1;
+using aikido::statespace::R2;
 using aikido::statespace::R3;
 
+/// Linear constraint A * x - b = 0 on R2.
+class LinearConstraint : public aikido::constraint::Differentiable
+{
+public:
+  LinearConstraint(const Eigen::Matrix2d& _a, const Eigen::Vector2d& _b)
+    : mA(_a), mB(_b), mStateSpace(std::make_shared<R2>())
+  {
+    // Do nothing
+  }
+
+  std::size_t getConstraintDimension() const override
+  {
+    return 2;
+  }
+
+  void getValue(
+      const aikido::statespace::StateSpace::State* _s,
+      Eigen::VectorXd& _out) const override
+  {
+    _out = mA * mStateSpace->getValue(static_cast<const R2::State*>(_s)) - mB;
+  }
+
+  void getJacobian(
+      const aikido::statespace::StateSpace::State* /*_s*/,
+      Eigen::MatrixXd& _out) const override
+  {
+    _out = mA;
+  }
+
+  std::vector<aikido::constraint::ConstraintType> getConstraintTypes()
+      const override
+  {
+    return std::vector<aikido::constraint::ConstraintType>(
+        2, aikido::constraint::ConstraintType::EQUALITY);
+  }
+
+  aikido::statespace::ConstStateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+private:
+  Eigen::Matrix2d mA;
+  Eigen::Vector2d mB;
+  std::shared_ptr<R2> mStateSpace;
+};
+
 TEST(NewtonsMethodProjectableTest, ConstructorThrowsOnNullDifferentiable)
 {
   EXPECT_THROW(
@@ -148,6 +199,45 @@ TEST(NewtonsMethodProjectable, ProjectPolynomialSecondOrder)
   EXPECT_TRUE(expected.isApprox(projected, 1e-5));
 }
 
+
+TEST(NewtonsMethodProjectable, ProjectConcurrently)
+{
+  // Constraint: x^2 - 1 = 0.
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      10,
+      1e-8);
+
+  R1 rvss;
+  std::vector<int> numFailures(4, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t ithread = 0; ithread < numFailures.size(); ++ithread)
+  {
+    threads.emplace_back([&, ithread]() {
+      // Threads with an even index project onto -1, the others onto 1.
+      const double sign = ithread % 2 == 0 ? -1. : 1.;
+      auto seedState = rvss.createState();
+      auto out = rvss.createState();
+      for (int i = 0; i < 100; ++i)
+      {
+        seedState.setValue(
+            Eigen::Matrix<double, 1, 1>(sign * (1.5 + 0.01 * i)));
+        if (!projector.project(seedState, out)
+            || std::abs(rvss.getValue(out)[0] - sign) > 1e-5)
+        {
+          ++numFailures[ithread];
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int numFailuresOfThread : numFailures)
+    EXPECT_EQ(0, numFailuresOfThread);
+}
 TEST(NewtonsMethodProjectable, ProjectTSRTranslation)
 {
   std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
@@ -211,3 +301,107 @@ TEST(NewtonsMethodProjectable, ProjectTSRRotation)
 
   EXPECT_TRUE(expected.isApprox(projected, 5e-4));
 }
+
+TEST(NewtonsMethodProjectable, SetLinearSolver)
+{
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({0.1}));
+  EXPECT_EQ(
+      NewtonsMethodProjectable::LinearSolver::PSEUDOINVERSE,
+      projector.getLinearSolver());
+
+  projector.setLinearSolver(
+      NewtonsMethodProjectable::LinearSolver::DAMPED_LEAST_SQUARES, 1e-2);
+  EXPECT_EQ(
+      NewtonsMethodProjectable::LinearSolver::DAMPED_LEAST_SQUARES,
+      projector.getLinearSolver());
+  EXPECT_DOUBLE_EQ(1e-2, projector.getDamping());
+
+  EXPECT_THROW(
+      projector.setLinearSolver(
+          NewtonsMethodProjectable::LinearSolver::DAMPED_LEAST_SQUARES, 0),
+      std::invalid_argument);
+}
+
+TEST(NewtonsMethodProjectable, ProjectTSRDampedLeastSquares)
+{
+  std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
+
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(0, 0) = 1;
+  Bw(0, 1) = 2;
+  Bw(3, 0) = M_PI_4;
+  Bw(3, 1) = M_PI_2;
+  tsr->mBw = Bw;
+
+  auto space = tsr->getSE3();
+  auto seedState = space->createState();
+
+  Eigen::Isometry3d isometry = Eigen::Isometry3d::Identity();
+  isometry.translation() = Eigen::Vector3d(-1, 0, 1);
+  seedState.setIsometry(isometry);
+
+  NewtonsMethodProjectable projector(
+      tsr, std::vector<double>(6, 1e-4), 1000, 1e-8);
+  projector.setLinearSolver(
+      NewtonsMethodProjectable::LinearSolver::DAMPED_LEAST_SQUARES);
+
+  auto out = space->createState();
+  ASSERT_TRUE(projector.project(seedState, out));
+
+  Eigen::VectorXd value;
+  tsr->getValue(out, value);
+  EXPECT_LE(value.lpNorm<Eigen::Infinity>(), 1e-4);
+}
+
+TEST(NewtonsMethodProjectable, ProjectWithWarmStart)
+{
+  // Constraint: x^2 - 1 = 0.
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      100,
+      1e-8);
+  EXPECT_FALSE(projector.getWarmStart());
+  projector.setWarmStart(true);
+  EXPECT_TRUE(projector.getWarmStart());
+
+  R1 rvss;
+  auto seedState = rvss.createState();
+  auto out = rvss.createState();
+
+  // A seed close to the singularity at x = 0 overshoots with a full step.
+  for (double seed : {0.01, 0.02, -2.0, 1.5})
+  {
+    Eigen::VectorXd v(1);
+    v(0) = seed;
+    seedState.setValue(v);
+
+    ASSERT_TRUE(projector.project(seedState, out));
+    EXPECT_NEAR(1.0, std::abs(rvss.getValue(out)(0)), 1e-5);
+  }
+}
+
+TEST(NewtonsMethodProjectable, ProjectSquareJacobianInvertsExactly)
+{
+  // The determinant of A is 1, so A is inverted exactly, although a
+  // thresholded SVD would drop its smallest singular value.
+  Eigen::Matrix2d a;
+  a << 1e7, 0, 0, 1e-7;
+  const Eigen::Vector2d expected(1, 2);
+
+  NewtonsMethodProjectable projector(
+      std::make_shared<LinearConstraint>(a, a * expected),
+      std::vector<double>({1e-9, 1e-9}),
+      1,
+      1e-8);
+
+  R2 rvss;
+  auto seedState = rvss.createState();
+  seedState.setValue(Eigen::Vector2d::Zero());
+
+  auto out = rvss.createState();
+  ASSERT_TRUE(projector.project(seedState, out));
+  EXPECT_TRUE(expected.isApprox(rvss.getValue(out)));
+}
@@ -631,6 +631,35 @@ TEST_F(RnBoxConstraintTests, Rx_createSampleGenerator)
   ASSERT_TRUE(result);
 }
 
+//==============================================================================
+TEST_F(RnBoxConstraintTests, Rx_sampleBatch)
+{
+  auto constraint = std::make_shared<RnBoxConstraint>(
+      mRxStateSpace, mRng->clone(), mLowerLimits, mUpperLimits);
+
+  auto generator1 = constraint->createSampleGenerator();
+  auto generator2 = constraint->createSampleGenerator();
+
+  std::vector<Rn::ScopedState> states;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    states.emplace_back(mRxStateSpace->createState());
+    batch.emplace_back(states.back());
+  }
+
+  EXPECT_THROW(generator1->sampleBatch(11, batch), std::invalid_argument);
+  ASSERT_EQ(10u, generator1->sampleBatch(10, batch));
+
+  auto state = mRxStateSpace->createState();
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(generator2->sample(state));
+    EXPECT_TRUE(state.getValue().isApprox(states[i].getValue()));
+    EXPECT_TRUE(constraint->isSatisfied(states[i]));
+  }
+}
+
 //==============================================================================
 TEST_F(RnBoxConstraintTests, R2_createSampleGenerator_RNGIsNull_Throws)
 {
@@ -79,3 +79,28 @@ TEST_F(SO2UniformSamplerTests, createSampleGenerator)
       NUM_SAMPLES);
   ASSERT_TRUE(result);
 }
+
+TEST_F(SO2UniformSamplerTests, sampleBatch)
+{
+  SO2UniformSampler constraint(mStateSpace, mRng->clone());
+  auto generator1 = constraint.createSampleGenerator();
+  auto generator2 = constraint.createSampleGenerator();
+
+  std::vector<SO2::ScopedState> states;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    states.emplace_back(mStateSpace->createState());
+    batch.emplace_back(states.back());
+  }
+
+  EXPECT_THROW(generator1->sampleBatch(11, batch), std::invalid_argument);
+  ASSERT_EQ(10u, generator1->sampleBatch(10, batch));
+
+  auto state = mStateSpace->createState();
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(generator2->sample(state));
+    EXPECT_DOUBLE_EQ(state.toAngle(), states[i].toAngle());
+  }
+}
@@ -83,3 +83,27 @@ TEST_F(SO3UniformSamplerTests, sampleGenerator)
       NUM_SAMPLES);
   ASSERT_TRUE(result);
 }
+
+TEST_F(SO3UniformSamplerTests, sampleBatch)
+{
+  SO3UniformSampler constraint(mStateSpace, mRng->clone());
+  auto generator1 = constraint.createSampleGenerator();
+  auto generator2 = constraint.createSampleGenerator();
+
+  std::vector<SO3::ScopedState> states;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    states.emplace_back(mStateSpace->createState());
+    batch.emplace_back(states.back());
+  }
+
+  ASSERT_EQ(10u, generator1->sampleBatch(10, batch));
+
+  auto state = mStateSpace->createState();
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(generator2->sample(state));
+    EXPECT_TRUE(state.getQuaternion().isApprox(states[i].getQuaternion()));
+  }
+}
@@ -0,0 +1,145 @@
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+
+#include <aikido/common/RNG.hpp>
+#include <aikido/constraint/dart/SelfCollisionMatrix.hpp>
+
+using aikido::common::RNGWrapper;
+using aikido::constraint::dart::SelfCollisionMatrix;
+
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+class SelfCollisionMatrixTest : public ::testing::Test
+{
+protected:
+  /// Creates a box BodyNode welded to mBase at \c offset.
+  BodyNode* createWeldedBox(
+      const std::string& name, const Eigen::Vector3d& offset)
+  {
+    WeldJoint::Properties properties;
+    properties.mName = name + "_joint";
+    properties.mT_ParentBodyToJoint.translation() = offset;
+
+    BodyNode::Properties bodyProperties;
+    bodyProperties.mName = name;
+
+    auto bodyNode = mSkeleton
+                        ->createJointAndBodyNodePair<WeldJoint>(
+                            mBase, properties, bodyProperties)
+                        .second;
+    bodyNode->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+    return bodyNode;
+  }
+
+  void SetUp() override
+  {
+    mSkeleton = Skeleton::create("Robot");
+
+    BodyNode::Properties baseProperties;
+    baseProperties.mName = "base";
+    mBase = mSkeleton
+                ->createJointAndBodyNodePair<RevoluteJoint>(
+                    nullptr, RevoluteJoint::Properties(), baseProperties)
+                .second;
+    mBase->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.2)));
+    mSkeleton->getDof(0)->setPositionLimits(-1.0, 1.0);
+    mSkeleton->enableSelfCollisionCheck();
+
+    // Siblings that always overlap, and a sibling that is out of reach.
+    createWeldedBox("sibling1", Eigen::Vector3d::Zero());
+    createWeldedBox("sibling2", Eigen::Vector3d::Zero());
+    createWeldedBox("far", Eigen::Vector3d(10.0, 0.0, 0.0));
+
+    mCollisionDetector = FCLCollisionDetector::create();
+    mRng = std::unique_ptr<RNGWrapper<std::default_random_engine>>(
+        new RNGWrapper<std::default_random_engine>(0));
+  }
+
+  SkeletonPtr mSkeleton;
+  BodyNode* mBase;
+  CollisionDetectorPtr mCollisionDetector;
+  std::unique_ptr<RNGWrapper<std::default_random_engine>> mRng;
+};
+
+//==============================================================================
+TEST_F(SelfCollisionMatrixTest, ComputeThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(
+      SelfCollisionMatrix::compute(nullptr, mCollisionDetector, mRng.get()),
+      std::invalid_argument);
+  EXPECT_THROW(
+      SelfCollisionMatrix::compute(mSkeleton, nullptr, mRng.get()),
+      std::invalid_argument);
+  EXPECT_THROW(
+      SelfCollisionMatrix::compute(mSkeleton, mCollisionDetector, nullptr),
+      std::invalid_argument);
+  EXPECT_THROW(
+      SelfCollisionMatrix::compute(
+          mSkeleton, mCollisionDetector, mRng.get(), 0u),
+      std::invalid_argument);
+}
+
+//==============================================================================
+TEST_F(SelfCollisionMatrixTest, DisableEnable)
+{
+  SelfCollisionMatrix matrix;
+  EXPECT_FALSE(matrix.isDisabled("a", "b"));
+
+  matrix.disable("b", "a");
+  EXPECT_TRUE(matrix.isDisabled("a", "b"));
+  EXPECT_TRUE(matrix.isDisabled("b", "a"));
+  ASSERT_EQ(1u, matrix.getDisabledPairs().size());
+  EXPECT_EQ("a", matrix.getDisabledPairs().begin()->first.first);
+  EXPECT_EQ(
+      SelfCollisionMatrix::Reason::USER,
+      matrix.getDisabledPairs().begin()->second);
+
+  matrix.enable("a", "b");
+  EXPECT_FALSE(matrix.isDisabled("a", "b"));
+}
+
+//==============================================================================
+TEST_F(SelfCollisionMatrixTest, ComputeClassifiesPairs)
+{
+  using Reason = SelfCollisionMatrix::Reason;
+
+  mSkeleton->setPosition(0, 0.5);
+  const auto matrix = SelfCollisionMatrix::compute(
+      mSkeleton, mCollisionDetector, mRng.get(), 100u);
+  EXPECT_DOUBLE_EQ(0.5, mSkeleton->getPosition(0));
+
+  const auto& pairs = matrix.getDisabledPairs();
+  EXPECT_EQ(Reason::ADJACENT, pairs.at(std::make_pair("base", "sibling1")));
+  EXPECT_EQ(Reason::ADJACENT, pairs.at(std::make_pair("base", "far")));
+  EXPECT_EQ(Reason::ALWAYS, pairs.at(std::make_pair("sibling1", "sibling2")));
+  EXPECT_EQ(Reason::NEVER, pairs.at(std::make_pair("far", "sibling1")));
+  EXPECT_EQ(Reason::NEVER, pairs.at(std::make_pair("far", "sibling2")));
+}
+
+//==============================================================================
+TEST_F(SelfCollisionMatrixTest, ApplySkipsDisabledPairs)
+{
+  const auto group = mCollisionDetector->createCollisionGroup(mSkeleton.get());
+  auto filter = std::make_shared<BodyNodeCollisionFilter>();
+  CollisionOption option(false, 1u, filter);
+
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+
+  const auto matrix = SelfCollisionMatrix::compute(
+      mSkeleton, mCollisionDetector, mRng.get(), 100u);
+  EXPECT_EQ(
+      matrix.getDisabledPairs().size(), matrix.apply(*mSkeleton, *filter));
+
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Pairs of BodyNodes that are not in the MetaSkeleton are skipped.
+  auto subset = Group::create();
+  subset->addBodyNode(mSkeleton->getBodyNode("sibling1"));
+  subset->addBodyNode(mSkeleton->getBodyNode("sibling2"));
+  EXPECT_EQ(1u, matrix.apply(*subset, *filter));
+}
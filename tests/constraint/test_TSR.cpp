@@ -182,6 +182,103 @@ TEST(TSRSampleGenerator, SampleSameSequence)
   }
 }
 
+TEST(TSRSampleGenerator, SampleBatchMatchesSample)
+{
+  TSR tsr;
+
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw.col(0) << -1, -2, -3, -M_PI, -M_PI_2, -M_PI;
+  Bw.col(1) << 1, 2, 3, M_PI, M_PI_2, M_PI;
+  tsr.mBw = Bw;
+  tsr.mT0_w.translate(Eigen::Vector3d(1, 2, 3));
+  tsr.mTw_e.rotate(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+
+  auto sampler1 = tsr.createSampleGenerator();
+  auto sampler2 = tsr.createSampleGenerator();
+
+  auto state = tsr.getSE3()->createState();
+  std::vector<SE3::ScopedState> batchStates;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (int i = 0; i < 10; i++)
+  {
+    batchStates.emplace_back(tsr.getSE3()->createState());
+    batch.emplace_back(batchStates.back());
+  }
+
+  EXPECT_THROW(sampler2->sampleBatch(11, batch), std::invalid_argument);
+  ASSERT_EQ(10u, sampler2->sampleBatch(10, batch));
+
+  for (int i = 0; i < 10; i++)
+  {
+    ASSERT_TRUE(sampler1->sample(state));
+    EXPECT_TRUE(state.getIsometry().isApprox(batchStates[i].getIsometry()));
+  }
+}
+
+TEST(TSRSampleGenerator, SampleBatchFixedRotation)
+{
+  TSR tsr;
+
+  // Only the translation is bounded to a range.
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw.col(0) << -1, -2, -3, 0.1, 0.2, 0.3;
+  Bw.col(1) << 1, 2, 3, 0.1, 0.2, 0.3;
+  tsr.mBw = Bw;
+  tsr.mT0_w.translate(Eigen::Vector3d(1, 2, 3));
+  tsr.mT0_w.rotate(Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitX()));
+  tsr.mTw_e.translate(Eigen::Vector3d(0.5, 0, 0));
+  tsr.mTw_e.rotate(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+
+  const Eigen::Matrix3d Rw_s
+      = (Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitZ())
+         * Eigen::AngleAxisd(0.2, Eigen::Vector3d::UnitY())
+         * Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitX()))
+            .toRotationMatrix();
+
+  auto generator = tsr.createSampleGenerator();
+  std::vector<SE3::ScopedState> batchStates;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (int i = 0; i < 10; i++)
+  {
+    batchStates.emplace_back(tsr.getSE3()->createState());
+    batch.emplace_back(batchStates.back());
+  }
+
+  ASSERT_EQ(10u, generator->sampleBatch(10, batch));
+
+  for (const auto& state : batchStates)
+  {
+    const Eigen::Isometry3d Tw_s
+        = tsr.mT0_w.inverse() * state.getIsometry() * tsr.mTw_e.inverse();
+    EXPECT_TRUE(Tw_s.linear().isApprox(Rw_s));
+    for (int i = 0; i < 3; i++)
+    {
+      EXPECT_LE(Bw(i, 0) - 1e-9, Tw_s.translation()[i]);
+      EXPECT_GE(Bw(i, 1) + 1e-9, Tw_s.translation()[i]);
+    }
+  }
+}
+
+TEST(TSRSampleGenerator, SampleBatchPointTSR)
+{
+  TSR tsr;
+
+  auto generator = tsr.createSampleGenerator();
+  std::vector<SE3::ScopedState> batchStates;
+  std::vector<aikido::statespace::StateSpace::State*> batch;
+  for (int i = 0; i < 3; i++)
+  {
+    batchStates.emplace_back(tsr.getSE3()->createState());
+    batch.emplace_back(batchStates.back());
+  }
+
+  ASSERT_EQ(1u, generator->sampleBatch(3, batch));
+  EXPECT_TRUE(
+      batchStates[0].getIsometry().isApprox(Eigen::Isometry3d::Identity()));
+  EXPECT_FALSE(generator->canSample());
+  EXPECT_EQ(0u, generator->sampleBatch(3, batch));
+}
+
 TEST(TSR, GetValue)
 {
   TSR tsr;
@@ -389,6 +486,75 @@ TEST(TSR, GetValueAndJacobian)
   EXPECT_TRUE(jacExpected.isApprox(jac));
 }
 
+TEST(TSR, GetJacobianMatchesFiniteDifferences)
+{
+  TSR tsr;
+  tsr.mT0_w.linear()
+      = Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, 2, 3).normalized())
+            .toRotationMatrix();
+  tsr.mT0_w.translation() = Eigen::Vector3d(0.5, -0.2, 1.0);
+  tsr.mTw_e.linear()
+      = Eigen::AngleAxisd(-0.4, Eigen::Vector3d(3, -1, 2).normalized())
+            .toRotationMatrix();
+  tsr.mTw_e.translation() = Eigen::Vector3d(0.1, 0.3, -0.2);
+  tsr.mBw(0, 1) = 0.1;
+  tsr.mBw(4, 0) = -0.1;
+
+  auto state = tsr.getSE3()->createState();
+  auto perturbed = tsr.getSE3()->createState();
+
+  for (int trial = 0; trial < 10; ++trial)
+  {
+    Eigen::Isometry3d isometry(Eigen::Isometry3d::Identity());
+    isometry.linear() = Eigen::AngleAxisd(
+                            0.2 * trial - 1.0,
+                            Eigen::Vector3d(1, trial, 2).normalized())
+                            .toRotationMatrix();
+    isometry.translation() = Eigen::Vector3d(0.3 * trial, -1.0, 0.2);
+    state.setIsometry(isometry);
+
+    Eigen::VectorXd value;
+    Eigen::MatrixXd jacobian;
+    tsr.getValueAndJacobian(state, value, jacobian);
+    ASSERT_EQ(6, jacobian.rows());
+    ASSERT_EQ(6, jacobian.cols());
+
+    // Perturb the rotation to exp(w) * R and the translation to p + v.
+    static constexpr double eps = 1e-6;
+    Eigen::Matrix6d expected;
+    for (int i = 0; i < 6; ++i)
+    {
+      Eigen::VectorXd values[2];
+      for (int j = 0; j < 2; ++j)
+      {
+        Eigen::Vector6d twist(Eigen::Vector6d::Zero());
+        twist(i) = j == 0 ? eps : -eps;
+
+        Eigen::Isometry3d perturbedIsometry(isometry);
+        if (twist.head<3>().norm() > 0)
+        {
+          perturbedIsometry.linear()
+              = Eigen::AngleAxisd(
+                    twist.head<3>().norm(), twist.head<3>().normalized())
+                    .toRotationMatrix()
+                * isometry.linear();
+        }
+        perturbedIsometry.translation() += twist.tail<3>();
+        perturbed.setIsometry(perturbedIsometry);
+        tsr.getValue(perturbed, values[j]);
+      }
+      expected.col(i) = (values[0] - values[1]) / (2 * eps);
+    }
+
+    EXPECT_TRUE(jacobian.isApprox(expected, 1e-5))
+        << "Analytic:\n" << jacobian << "\nFinite differences:\n" << expected;
+
+    Eigen::MatrixXd separateJacobian;
+    tsr.getJacobian(state, separateJacobian);
+    EXPECT_TRUE(separateJacobian.isApprox(jacobian));
+  }
+}
+
 TEST(TSR, GetConstraintTypes)
 {
   // This tests current behavior, but it may fail.
@@ -202,6 +202,140 @@ TEST_F(KunzRetimerTests, StraightLine_TriangularProfile)
   EXPECT_EIGEN_EQUAL(Vector2d(-1., -1.), tangentVector, 1e-6);
 }
 
+TEST_F(KunzRetimerTests, StraightLine_ManyWaypoints)
+{
+  Interpolated inputTrajectory(mStateSpace, mInterpolator);
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd positions(2);
+  Eigen::VectorXd tangentVector;
+
+  // The same straight line as in StraightLine_TriangularProfile, split into
+  // many collinear segments, should have the same timing. The integration
+  // stops at each waypoint, so a finer time step than for a single segment
+  // is needed to reach the peak velocity.
+  const std::size_t numSegments = 100;
+  for (std::size_t i = 0; i <= numSegments; ++i)
+  {
+    const double ratio = static_cast<double>(i) / numSegments;
+    positions << 1. + ratio, 2. + ratio;
+    mStateSpace->expMap(positions, state);
+    inputTrajectory.addWaypoint(2. * ratio, state);
+  }
+
+  double maxDeviation = 1e-2;
+  double timeStep = 0.01;
+  auto timedTrajectory = computeKunzTiming(
+      inputTrajectory,
+      Vector2d::Constant(2.),
+      Vector2d::Constant(1.),
+      maxDeviation,
+      timeStep);
+
+  double tolerance = 1e-3;
+  EXPECT_NEAR(2., timedTrajectory->getDuration(), tolerance);
+
+  timedTrajectory->evaluate(0., state);
+  mStateSpace->logMap(state, positions);
+  EXPECT_EIGEN_EQUAL(Vector2d(1.0, 2.0), positions, tolerance);
+
+  timedTrajectory->evaluate(1., state);
+  mStateSpace->logMap(state, positions);
+  EXPECT_EIGEN_EQUAL(Vector2d(1.5, 2.5), positions, tolerance);
+
+  timedTrajectory->evaluateDerivative(1.0, 1, tangentVector);
+  EXPECT_EIGEN_EQUAL(Vector2d(1.0, 1.0), tangentVector, tolerance);
+}
+
+TEST_F(KunzRetimerTests, SplineToleranceIsNegative_Throws)
+{
+  EXPECT_THROW(
+      {
+        computeKunzTiming(
+            *mStraightLine,
+            mMaxVelocity,
+            mMaxAcceleration,
+            1e-2,
+            0.1,
+            -1.);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(KunzRetimerTests, StraightLine_SplineTolerance)
+{
+  double maxDeviation = 1e-2;
+  double timeStep = 0.01;
+  auto denseTrajectory = computeKunzTiming(
+      *mStraightLine, mMaxVelocity, mMaxAcceleration, maxDeviation, timeStep);
+
+  double splineTolerance = 1e-6;
+  auto compactTrajectory = computeKunzTiming(
+      *mStraightLine,
+      mMaxVelocity,
+      mMaxAcceleration,
+      maxDeviation,
+      timeStep,
+      splineTolerance);
+
+  // Each constant-acceleration arc of the timed straight line fits in one
+  // cubic segment.
+  EXPECT_LT(
+      compactTrajectory->getNumSegments(),
+      denseTrajectory->getNumSegments() / 10);
+  EXPECT_NEAR(
+      denseTrajectory->getDuration(), compactTrajectory->getDuration(), 1e-9);
+
+  auto denseState = mStateSpace->createState();
+  auto compactState = mStateSpace->createState();
+  Eigen::VectorXd densePositions;
+  Eigen::VectorXd compactPositions;
+  for (double t = denseTrajectory->getStartTime();
+       t < denseTrajectory->getEndTime();
+       t += timeStep / 3.)
+  {
+    denseTrajectory->evaluate(t, denseState);
+    compactTrajectory->evaluate(t, compactState);
+    mStateSpace->logMap(denseState, densePositions);
+    mStateSpace->logMap(compactState, compactPositions);
+    EXPECT_EIGEN_EQUAL(densePositions, compactPositions, 1e-5);
+  }
+}
+
+TEST_F(KunzRetimerTests, StraightLine_SplineToleranceRespectsLimits)
+{
+  // The switching points of the timed straight line fall between the time
+  // steps, where a cubic segment would exceed the acceleration limits.
+  double maxDeviation = 1e-2;
+  double timeStep = 0.03;
+  double splineTolerance = 1e-6;
+  auto compactTrajectory = computeKunzTiming(
+      *mStraightLine,
+      mMaxVelocity,
+      mMaxAcceleration,
+      maxDeviation,
+      timeStep,
+      splineTolerance);
+  EXPECT_LT(compactTrajectory->getNumSegments(), 10u);
+
+  double limitTolerance = 1e-6;
+  Eigen::VectorXd velocity;
+  Eigen::VectorXd acceleration;
+  for (double t = compactTrajectory->getStartTime();
+       t < compactTrajectory->getEndTime();
+       t += timeStep / 10.)
+  {
+    compactTrajectory->evaluateDerivative(t, 1, velocity);
+    compactTrajectory->evaluateDerivative(t, 2, acceleration);
+    for (int i = 0; i < velocity.size(); ++i)
+    {
+      EXPECT_LE(std::abs(velocity[i]), mMaxVelocity[i] + limitTolerance);
+      EXPECT_LE(
+          std::abs(acceleration[i]), mMaxAcceleration[i] + limitTolerance);
+    }
+  }
+}
+
 TEST_F(KunzRetimerTests, StraightLine_TrapezoidalProfile)
 {
   Interpolated inputTrajectory(mStateSpace, mInterpolator);
@@ -130,3 +130,43 @@ TEST_F(MotionValidatorTest, BadValidationSmallResolution)
       = std::make_shared<aikido::planner::ompl::MotionValidator>(si, 0.5);
   EXPECT_TRUE(validator1->checkMotion(state1, state2));
 }
+
+TEST_F(MotionValidatorTest, IncrementalValidationMatchesValidation)
+{
+  setTranslationalState(Eigen::Vector3d(-5, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(-5, 5, 0), stateSpace, state2);
+
+  const std::size_t numPoints = validator->getNumCheckPoints(state1, state2);
+  EXPECT_EQ(129u, numPoints);
+
+  std::size_t numCheckedPoints = 0;
+  EXPECT_TRUE(validator->checkMotionIncrementally(
+      state1, state2, numCheckedPoints, 10));
+  EXPECT_EQ(10u, numCheckedPoints);
+
+  // Checking stops at the end of the sequence
+  EXPECT_TRUE(validator->checkMotionIncrementally(
+      state1, state2, numCheckedPoints, 1000));
+  EXPECT_EQ(numPoints, numCheckedPoints);
+
+  EXPECT_TRUE(validator->checkMotionIncrementally(
+      state1, state2, numCheckedPoints, 1));
+  EXPECT_EQ(numPoints, numCheckedPoints);
+}
+
+TEST_F(MotionValidatorTest, FailedIncrementalValidation)
+{
+  setTranslationalState(Eigen::Vector3d(0, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(0, 5, 0), stateSpace, state2);
+
+  // The endpoints and the midpoint of the segment are checked first, and the
+  // midpoint is in collision.
+  std::size_t numCheckedPoints = 0;
+  EXPECT_TRUE(validator->checkMotionIncrementally(
+      state1, state2, numCheckedPoints, 2));
+  EXPECT_EQ(2u, numCheckedPoints);
+
+  EXPECT_FALSE(validator->checkMotionIncrementally(
+      state1, state2, numCheckedPoints, 1));
+  EXPECT_EQ(2u, numCheckedPoints);
+}
@@ -174,6 +174,79 @@ TEST_F(PlannerTest, PlanConstrainedCRRTConnect)
   }
 }
 
+TEST_F(PlannerTest, PlanConstrainedCRRTConnectLazily)
+{
+  // The constraint plane x = 0 intersects the obstacle at the origin.
+  double constraintVal = 0;
+  Eigen::Vector3d startPose(constraintVal, -5, 0);
+
+  auto startState = stateSpace->createState();
+  auto subState1 = stateSpace->getSubStateHandle<R3>(startState, 0);
+  subState1.setValue(startPose);
+
+  auto boxConstraint = std::make_shared<aikido::constraint::R3BoxConstraint>(
+      stateSpace->getSubspace<R3>(0),
+      make_rng(),
+      Eigen::Vector3d(constraintVal - 1, 4, 0),
+      Eigen::Vector3d(constraintVal + 1, 5, 0));
+  std::vector<std::shared_ptr<aikido::constraint::Sampleable>> sConstraints;
+  sConstraints.push_back(boxConstraint);
+  aikido::constraint::SampleablePtr goalSampleable
+      = std::make_shared<aikido::constraint::CartesianProductSampleable>(
+          stateSpace, sConstraints);
+  std::vector<std::shared_ptr<const aikido::constraint::Testable>> tConstraints;
+  tConstraints.push_back(boxConstraint);
+  aikido::constraint::TestablePtr goalTestable
+      = std::make_shared<aikido::constraint::CartesianProductTestable>(
+          stateSpace, tConstraints);
+
+  auto trajConstraint = std::make_shared<MockProjectionConstraint>(
+      stateSpace, goalSampleable, constraintVal);
+  auto collisionConstraint = collConstraint;
+
+  // Plan
+  auto traj = aikido::planner::ompl::planCRRTConnect(
+      startState,
+      goalTestable,
+      trajConstraint,
+      trajConstraint,
+      stateSpace,
+      interpolator,
+      std::move(dmetric),
+      std::move(sampler),
+      std::move(collConstraint),
+      std::move(boundsConstraint),
+      std::move(boundsProjection),
+      5.0,
+      std::numeric_limits<double>::infinity(),
+      0.1,
+      0.05,
+      0.1,
+      true);
+
+  ASSERT_TRUE(traj != nullptr);
+
+  // Check the first waypoint
+  auto s0 = stateSpace->createState();
+  traj->evaluate(0, s0);
+  auto r0 = s0.getSubStateHandle<R3>(0);
+  EXPECT_TRUE(r0.getValue().isApprox(startPose));
+
+  // Check the last waypoint
+  traj->evaluate(traj->getEndTime(), s0);
+  EXPECT_TRUE(goalTestable->isSatisfied(s0));
+
+  // Check that the waypoints and the midpoints between them, which are all
+  // checked by the MotionValidator, are collision-free
+  aikido::common::StepSequence seq(
+      0.5, true, true, traj->getStartTime(), traj->getEndTime());
+  for (double t : seq)
+  {
+    traj->evaluate(t, s0);
+    EXPECT_TRUE(collisionConstraint->isSatisfied(s0));
+  }
+}
+
 TEST_F(PlannerTest, PlanConstrainedCRRT)
 {
   double constraintVal = -2;
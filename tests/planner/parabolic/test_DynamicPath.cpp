@@ -0,0 +1,168 @@
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "DynamicPath.h"
+
+using ParabolicRamp::DynamicPath;
+using ParabolicRamp::DynamicPathShortcut;
+using ParabolicRamp::RampFeasibilityChecker;
+using ParabolicRamp::Vector;
+
+/// Rejects the configurations inside an axis-aligned square.
+class SquareObstacleChecker : public ParabolicRamp::FeasibilityCheckerBase
+{
+public:
+  SquareObstacleChecker(const Vector& center, double halfWidth)
+    : mCenter(center), mHalfWidth(halfWidth)
+  {
+    // Do nothing
+  }
+
+  bool ConfigFeasible(const Vector& x) override
+  {
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+      if (std::abs(x[i] - mCenter[i]) >= mHalfWidth)
+        return true;
+    }
+    return false;
+  }
+
+  bool SegmentFeasible(const Vector& a, const Vector& b) override
+  {
+    const int numSteps = 20;
+    Vector x(a.size());
+    for (int step = 1; step < numSteps; ++step)
+    {
+      const double alpha = static_cast<double>(step) / numSteps;
+      for (std::size_t i = 0; i < a.size(); ++i)
+        x[i] = (1. - alpha) * a[i] + alpha * b[i];
+      if (!ConfigFeasible(x))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  Vector mCenter;
+  double mHalfWidth;
+};
+
+class DynamicPathTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // A staircase of eight ramps that stop at each milestone.
+    std::vector<Vector> milestones;
+    for (int i = 0; i < 9; ++i)
+      milestones.push_back(Vector{static_cast<double>((i + 1) / 2),
+                                  static_cast<double>(i / 2)});
+
+    mPath.Init(Vector{1., 1.}, Vector{2., 2.});
+    mPath.SetMilestones(milestones);
+    ASSERT_TRUE(mPath.IsValid());
+    ASSERT_EQ(8u, mPath.ramps.size());
+  }
+
+  /// Returns the time at which ramp \c index starts, plus \c fraction of its
+  /// duration.
+  double getRampTime(std::size_t index, double fraction) const
+  {
+    double time = 0.;
+    for (std::size_t i = 0; i < index; ++i)
+      time += mPath.ramps[i].endTime;
+    return time + fraction * mPath.ramps[index].endTime;
+  }
+
+  void expectSamePath(const DynamicPath& expected, const DynamicPath& actual)
+  {
+    ASSERT_EQ(expected.ramps.size(), actual.ramps.size());
+    ASSERT_DOUBLE_EQ(expected.GetTotalTime(), actual.GetTotalTime());
+
+    Vector expectedX, actualX;
+    for (double t = 0.; t < expected.GetTotalTime(); t += 0.01)
+    {
+      expected.Evaluate(t, expectedX);
+      actual.Evaluate(t, actualX);
+      for (std::size_t i = 0; i < expectedX.size(); ++i)
+        EXPECT_DOUBLE_EQ(expectedX[i], actualX[i]);
+    }
+  }
+
+  DynamicPath mPath;
+};
+
+TEST_F(DynamicPathTests, TryShortcut_MatchesPlanCheckApply)
+{
+  SquareObstacleChecker obstacle(Vector{2., 1.5}, 0.3);
+  RampFeasibilityChecker checker(&obstacle, 1e-3);
+
+  DynamicPath tried = mPath;
+  DynamicPath applied = mPath;
+
+  std::mt19937 rng(0);
+  int numShortcuts = 0;
+  for (int iteration = 0; iteration < 50; ++iteration)
+  {
+    std::uniform_real_distribution<> dist(0., tried.GetTotalTime());
+    const double t1 = dist(rng);
+    const double t2 = dist(rng);
+
+    const bool triedSuccess = tried.TryShortcut(t1, t2, checker);
+
+    DynamicPathShortcut shortcut;
+    const bool appliedSuccess = applied.PlanShortcut(t1, t2, shortcut)
+                                && applied.CheckShortcut(shortcut, checker);
+    if (appliedSuccess)
+      applied.ApplyShortcut(shortcut);
+
+    ASSERT_EQ(triedSuccess, appliedSuccess);
+    expectSamePath(tried, applied);
+
+    if (triedSuccess)
+      ++numShortcuts;
+  }
+
+  // The obstacle rejects some shortcuts, but not all of them.
+  EXPECT_GT(numShortcuts, 0);
+  EXPECT_LT(numShortcuts, 50);
+  EXPECT_TRUE(applied.IsValid());
+}
+
+TEST_F(DynamicPathTests, ApplyShortcut_NonOverlappingFromTheBack)
+{
+  SquareObstacleChecker obstacle(Vector{10., 10.}, 0.3);
+  RampFeasibilityChecker checker(&obstacle, 1e-3);
+
+  // Both shortcuts are planned on the same path.
+  DynamicPathShortcut front, back;
+  ASSERT_TRUE(
+      mPath.PlanShortcut(getRampTime(1, 0.5), getRampTime(3, 0.5), front));
+  ASSERT_TRUE(
+      mPath.PlanShortcut(getRampTime(5, 0.5), getRampTime(7, 0.5), back));
+  ASSERT_LT(front.i2, back.i1);
+  ASSERT_TRUE(mPath.CheckShortcut(front, checker));
+  ASSERT_TRUE(mPath.CheckShortcut(back, checker));
+
+  const double totalTime = mPath.GetTotalTime();
+  Vector start, goal;
+  mPath.Evaluate(0., start);
+  mPath.Evaluate(totalTime, goal);
+
+  mPath.ApplyShortcut(back);
+  mPath.ApplyShortcut(front);
+
+  EXPECT_TRUE(mPath.IsValid());
+  EXPECT_LT(mPath.GetTotalTime(), totalTime);
+  for (const auto& ramp : mPath.ramps)
+    EXPECT_TRUE(checker.Check(ramp));
+
+  Vector x;
+  mPath.Evaluate(0., x);
+  EXPECT_EQ(start, x);
+  mPath.Evaluate(mPath.GetTotalTime(), x);
+  for (std::size_t i = 0; i < goal.size(); ++i)
+    EXPECT_NEAR(goal[i], x[i], 1e-9);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <aikido/common/StepSequence.hpp>
+#include <aikido/common/ThreadPool.hpp>
 #include <aikido/constraint/Satisfied.hpp>
 #include <aikido/planner/parabolic/ParabolicSmoother.hpp>
 #include <aikido/planner/parabolic/ParabolicTimer.hpp>
@@ -11,6 +12,7 @@
 
 #include "eigen_tests.hpp"
 
+using aikido::common::ThreadPool;
 using aikido::constraint::Satisfied;
 using aikido::planner::parabolic::computeParabolicTiming;
 using aikido::planner::parabolic::doBlend;
@@ -256,6 +258,95 @@ TEST_F(ParabolicSmootherTests, doShortcut)
   EXPECT_TRUE(shortenTime < originTime);
 }
 
+TEST_F(ParabolicSmootherTests, doShortcutInParallel)
+{
+  ThreadPool threadPool(2);
+  std::vector<aikido::constraint::TestablePtr> testables;
+  for (std::size_t i = 0; i < 2; ++i)
+    testables.emplace_back(std::make_shared<Satisfied>(mStateSpace));
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory.get(),
+      threadPool,
+      testables,
+      4u,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      mTimelimit,
+      mCheckResolution);
+
+  // Position.
+  Eigen::VectorXd statePositions, startPositions, goalPositions;
+
+  evaluate(
+      mNonStraightLine.get(), mNonStraightLine->getStartTime(), startPositions);
+  evaluate(
+      smoothedTrajectory.get(),
+      smoothedTrajectory->getStartTime(),
+      statePositions);
+  EXPECT_EIGEN_EQUAL(startPositions, statePositions, mTolerance);
+
+  evaluate(
+      mNonStraightLine.get(), mNonStraightLine->getEndTime(), goalPositions);
+  evaluate(
+      smoothedTrajectory.get(),
+      smoothedTrajectory->getEndTime(),
+      statePositions);
+  EXPECT_EIGEN_EQUAL(goalPositions, statePositions, mTolerance);
+
+  double shortenLength = getLength(smoothedTrajectory.get());
+  EXPECT_TRUE(shortenLength < mNonStraightLineLength);
+
+  double originTime = mNonStraightLine->getDuration();
+  double shortenTime = smoothedTrajectory->getDuration();
+  EXPECT_TRUE(shortenTime < originTime);
+}
+
+TEST_F(ParabolicSmootherTests, doShortcutInParallelWithoutTestables_Throws)
+{
+  ThreadPool threadPool(2);
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_THROW(
+      doShortcut(
+          *splineTrajectory.get(),
+          threadPool,
+          {},
+          4u,
+          mMaxVelocity,
+          mMaxAcceleration,
+          mRng,
+          mTimelimit,
+          mCheckResolution),
+      std::invalid_argument);
+}
+
+TEST_F(ParabolicSmootherTests, doShortcutInParallelWithoutCandidates_Throws)
+{
+  ThreadPool threadPool(2);
+  std::vector<aikido::constraint::TestablePtr> testables{
+      std::make_shared<Satisfied>(mStateSpace)};
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_THROW(
+      doShortcut(
+          *splineTrajectory.get(),
+          threadPool,
+          testables,
+          0u,
+          mMaxVelocity,
+          mMaxAcceleration,
+          mRng,
+          mTimelimit,
+          mCheckResolution),
+      std::invalid_argument);
+}
+
 TEST_F(ParabolicSmootherTests, doBlend)
 {
   std::shared_ptr<Satisfied> testable
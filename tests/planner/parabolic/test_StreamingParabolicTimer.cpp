@@ -0,0 +1,280 @@
+#include <limits>
+#include <gtest/gtest.h>
+
+#include <aikido/planner/parabolic/ParabolicTimer.hpp>
+#include <aikido/planner/parabolic/StreamingParabolicTimer.hpp>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+using aikido::planner::parabolic::computeParabolicTiming;
+using aikido::planner::parabolic::StreamingParabolicTimer;
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R1;
+using aikido::statespace::SO2;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using Eigen::Vector2d;
+
+class StreamingParabolicTimerTests : public ::testing::Test
+{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+protected:
+  void SetUp() override
+  {
+    std::vector<aikido::statespace::ConstStateSpacePtr> subspaces;
+    subspaces.emplace_back(std::make_shared<R1>());
+    subspaces.emplace_back(std::make_shared<SO2>());
+    mStateSpace = std::make_shared<CartesianProduct>(subspaces);
+    mMaxVelocity = Eigen::Vector2d(1., 1.);
+    mMaxAcceleration = Eigen::Vector2d(2., 2.);
+
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+  }
+
+  void appendSegments(const Spline& _input, Spline& _output)
+  {
+    EXPECT_NEAR(_output.getEndTime(), _input.getStartTime(), 1e-9);
+    for (std::size_t i = 0; i < _input.getNumSegments(); ++i)
+    {
+      _output.addSegment(
+          _input.getSegmentCoefficients(i),
+          _input.getSegmentDuration(i),
+          _input.getSegmentStartState(i));
+    }
+  }
+
+  void expectEquivalent(const Spline& _expected, const Spline& _actual)
+  {
+    ASSERT_NEAR(_expected.getStartTime(), _actual.getStartTime(), 1e-9);
+    ASSERT_NEAR(_expected.getEndTime(), _actual.getEndTime(), 1e-9);
+
+    auto expectedState = mStateSpace->createState();
+    auto actualState = mStateSpace->createState();
+    Eigen::VectorXd expectedVector, actualVector;
+
+    // Compare positions by their geodesic distance, since the SO2 dimension
+    // may wrap around differently on either side.
+    const double step = 0.01;
+    for (double t = _expected.getStartTime(); t < _expected.getEndTime();
+         t += step)
+    {
+      _expected.evaluate(t, expectedState);
+      _actual.evaluate(t, actualState);
+      EXPECT_TRUE(mInterpolator->getTangentVector(expectedState, actualState)
+                      .isZero(1e-6));
+
+      _expected.evaluateDerivative(t, 1, expectedVector);
+      _actual.evaluateDerivative(t, 1, actualVector);
+      EXPECT_TRUE(expectedVector.isApprox(actualVector, 1e-6));
+    }
+  }
+
+  std::shared_ptr<CartesianProduct> mStateSpace;
+  Eigen::Vector2d mMaxVelocity;
+  Eigen::Vector2d mMaxAcceleration;
+
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+};
+
+TEST_F(StreamingParabolicTimerTests, InvalidArguments_Throws)
+{
+  EXPECT_THROW(
+      {
+        StreamingParabolicTimer timer(
+            mStateSpace, Vector2d(1., 0.), mMaxAcceleration);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        StreamingParabolicTimer timer(
+            mStateSpace, mMaxVelocity, Vector2d(-1., 1.));
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        StreamingParabolicTimer timer(
+            mStateSpace, mMaxVelocity, Eigen::VectorXd::Ones(3));
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        StreamingParabolicTimer timer(
+            mStateSpace, mMaxVelocity, mMaxAcceleration, 0., 0);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(StreamingParabolicTimerTests, MatchesParabolicTiming)
+{
+  // The third waypoint is a duplicate, which is only added to the streaming
+  // timer. The SO2 dimension wraps around between the last two waypoints.
+  const std::vector<Vector2d> waypoints{Vector2d(1., 2.),
+                                        Vector2d(2., 3.),
+                                        Vector2d(2., 3.),
+                                        Vector2d(0., 3.),
+                                        Vector2d(0., -3.)};
+
+  Interpolated interpolated(mStateSpace, mInterpolator);
+  StreamingParabolicTimer timer(
+      mStateSpace, mMaxVelocity, mMaxAcceleration, 2.);
+  Spline streamed(mStateSpace, 2.);
+
+  auto state = mStateSpace->createState();
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    mStateSpace->expMap(waypoints[i], state);
+    if (i != 2)
+      interpolated.addWaypoint(2. + i, state);
+
+    auto output = timer.addWaypoint(state);
+    EXPECT_EQ(0u, timer.getNumPendingSegments());
+
+    // Each waypoint except the first and the duplicate finalizes a segment.
+    if (i == 0 || i == 2)
+    {
+      EXPECT_EQ(nullptr, output.get());
+      continue;
+    }
+
+    ASSERT_NE(nullptr, output.get());
+    appendSegments(*output, streamed);
+    EXPECT_DOUBLE_EQ(timer.getEndTime(), streamed.getEndTime());
+  }
+  EXPECT_EQ(nullptr, timer.finish().get());
+
+  auto expected
+      = computeParabolicTiming(interpolated, mMaxVelocity, mMaxAcceleration);
+  expectEquivalent(*expected, streamed);
+}
+
+TEST_F(StreamingParabolicTimerTests, Lookahead_MergesCollinearWaypoints)
+{
+  const std::vector<Vector2d> waypoints{Vector2d(0., 0.),
+                                        Vector2d(0.5, 0.5),
+                                        Vector2d(1., 1.),
+                                        Vector2d(1.5, 1.5),
+                                        Vector2d(1.5, 0.)};
+
+  StreamingParabolicTimer stopping(mStateSpace, mMaxVelocity, mMaxAcceleration);
+  StreamingParabolicTimer timer(
+      mStateSpace, mMaxVelocity, mMaxAcceleration, 0., 2);
+  Spline streamed(mStateSpace, 0.);
+
+  auto state = mStateSpace->createState();
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    mStateSpace->expMap(waypoints[i], state);
+    stopping.addWaypoint(state);
+
+    auto output = timer.addWaypoint(state);
+    if (output)
+      appendSegments(*output, streamed);
+
+    // The lookahead is full at the third waypoint. The fourth continues the
+    // line, but starts a new run. The fifth changes direction.
+    const std::vector<std::size_t> expectedPending{0, 1, 0, 1, 1};
+    EXPECT_EQ(expectedPending[i], timer.getNumPendingSegments());
+    EXPECT_EQ(i == 2 || i == 4, output != nullptr);
+  }
+
+  auto output = timer.finish();
+  ASSERT_NE(nullptr, output.get());
+  appendSegments(*output, streamed);
+  EXPECT_EQ(0u, timer.getNumPendingSegments());
+  EXPECT_EQ(nullptr, timer.finish().get());
+
+  // Skipping the stop at the second waypoint takes less time.
+  EXPECT_LT(streamed.getEndTime(), stopping.getEndTime());
+
+  // The merged segment passes through the skipped waypoint.
+  Eigen::VectorXd position;
+  bool passesThrough = false;
+  for (double t = 0.; t < streamed.getEndTime(); t += 0.001)
+  {
+    streamed.evaluate(t, state);
+    mStateSpace->logMap(state, position);
+    passesThrough |= position.isApprox(waypoints[1], 1e-2);
+  }
+  EXPECT_TRUE(passesThrough);
+
+  // The output ends at the last waypoint at rest.
+  streamed.evaluate(streamed.getEndTime(), state);
+  mStateSpace->logMap(state, position);
+  EXPECT_TRUE(position.isApprox(waypoints.back(), 1e-6));
+  streamed.evaluateDerivative(streamed.getEndTime(), 1, position);
+  EXPECT_TRUE(position.isZero(1e-6));
+}
+
+TEST_F(StreamingParabolicTimerTests, Lookahead_BoundsDistanceOfMergedWaypoints)
+{
+  // Each step turns slightly, so every step is within the tolerance of the
+  // previous one, but the waypoints drift away from the line through the
+  // first two.
+  const double tolerance = 0.011;
+  std::vector<Vector2d> waypoints;
+  for (int i = 0; i < 7; ++i)
+    waypoints.emplace_back(0.5 * i, 0.002 * i * i);
+
+  StreamingParabolicTimer timer(
+      mStateSpace, mMaxVelocity, mMaxAcceleration, 0., 10, tolerance);
+  Spline streamed(mStateSpace, 0.);
+
+  auto state = mStateSpace->createState();
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    mStateSpace->expMap(waypoints[i], state);
+    auto output = timer.addWaypoint(state);
+    if (output)
+      appendSegments(*output, streamed);
+
+    // The fifth waypoint would be too far from the straight segment from the
+    // first to the sixth, so the sixth starts a new run.
+    const std::vector<std::size_t> expectedPending{0, 1, 2, 3, 4, 1, 2};
+    EXPECT_EQ(expectedPending[i], timer.getNumPendingSegments());
+    EXPECT_EQ(i == 5, output != nullptr);
+  }
+
+  auto output = timer.finish();
+  ASSERT_NE(nullptr, output.get());
+  appendSegments(*output, streamed);
+
+  // Every waypoint is within the tolerance of the output path.
+  Eigen::VectorXd position;
+  for (const auto& waypoint : waypoints)
+  {
+    double distance = std::numeric_limits<double>::infinity();
+    for (double t = 0.; t < streamed.getEndTime(); t += 0.001)
+    {
+      streamed.evaluate(t, state);
+      mStateSpace->logMap(state, position);
+      distance = std::min(distance, (position - waypoint).norm());
+    }
+    EXPECT_LE(distance, tolerance);
+  }
+}
+
+TEST_F(StreamingParabolicTimerTests, Reset_RestartsTiming)
+{
+  StreamingParabolicTimer timer(mStateSpace, mMaxVelocity, mMaxAcceleration);
+
+  auto state = mStateSpace->createState();
+  mStateSpace->expMap(Vector2d(0., 0.), state);
+  timer.addWaypoint(state);
+  mStateSpace->expMap(Vector2d(1., 1.), state);
+  EXPECT_NE(nullptr, timer.addWaypoint(state).get());
+  EXPECT_GT(timer.getEndTime(), 0.);
+
+  timer.reset(5.);
+  EXPECT_DOUBLE_EQ(5., timer.getEndTime());
+
+  // The first waypoint after a reset starts a new path.
+  EXPECT_EQ(nullptr, timer.addWaypoint(state).get());
+  mStateSpace->expMap(Vector2d(0., 0.), state);
+  auto output = timer.addWaypoint(state);
+  ASSERT_NE(nullptr, output.get());
+  EXPECT_DOUBLE_EQ(5., output->getStartTime());
+}
@@ -0,0 +1,226 @@
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+
+#include <aikido/planner/CachedTestable.hpp>
+#include <aikido/statespace/Rn.hpp>
+
+using aikido::constraint::DefaultTestableOutcome;
+using aikido::constraint::TestableOutcome;
+using aikido::planner::CachedTestable;
+using aikido::planner::World;
+using aikido::statespace::R1;
+using aikido::statespace::StateSpace;
+
+/// Testable that is satisfied for non-negative values and counts its calls.
+class CountingConstraint : public aikido::constraint::Testable
+{
+public:
+  explicit CountingConstraint(std::shared_ptr<const R1> stateSpace)
+    : mStateSpace(std::move(stateSpace)), mNumCalls(0)
+  {
+  }
+
+  bool isSatisfied(
+      const StateSpace::State* state,
+      TestableOutcome* /*outcome*/ = nullptr) const override
+  {
+    ++mNumCalls;
+    return mStateSpace->getValue(static_cast<const R1::State*>(state))[0]
+           >= 0.0;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(new DefaultTestableOutcome);
+  }
+
+  aikido::statespace::ConstStateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  std::shared_ptr<const R1> mStateSpace;
+  mutable int mNumCalls;
+};
+
+class CachedTestableTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R1>();
+    mConstraint = std::make_shared<CountingConstraint>(mStateSpace);
+  }
+
+  R1::ScopedState createState(double value)
+  {
+    auto state = mStateSpace->createState();
+    mStateSpace->setValue(state, Eigen::Matrix<double, 1, 1>(value));
+    return state;
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  std::shared_ptr<CountingConstraint> mConstraint;
+};
+
+TEST_F(CachedTestableTest, ConstructorThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(CachedTestable(nullptr, 0.1), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(mConstraint, 0.0), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(mConstraint, 0.1, 0u), std::invalid_argument);
+}
+
+TEST_F(CachedTestableTest, ReusesResultsWithinGridCell)
+{
+  CachedTestable cached(mConstraint, 0.1);
+  EXPECT_EQ(mStateSpace, cached.getStateSpace());
+
+  auto state1 = createState(0.51);
+  auto state2 = createState(0.52);
+  auto state3 = createState(-0.52);
+
+  EXPECT_TRUE(cached.isSatisfied(state1));
+  EXPECT_TRUE(cached.isSatisfied(state2));
+  EXPECT_FALSE(cached.isSatisfied(state3));
+  EXPECT_FALSE(cached.isSatisfied(state3));
+
+  EXPECT_EQ(2, mConstraint->mNumCalls);
+  EXPECT_EQ(2u, cached.getNumHits());
+  EXPECT_EQ(2u, cached.getNumMisses());
+  EXPECT_EQ(2u, cached.getSize());
+
+  cached.resetCounters();
+  EXPECT_EQ(0u, cached.getNumHits());
+  EXPECT_EQ(0u, cached.getNumMisses());
+
+  cached.clear();
+  EXPECT_EQ(0u, cached.getSize());
+  EXPECT_TRUE(cached.isSatisfied(state1));
+  EXPECT_EQ(3, mConstraint->mNumCalls);
+}
+
+TEST_F(CachedTestableTest, EvictsLeastRecentlyUsed)
+{
+  CachedTestable cached(mConstraint, 0.1, 2u);
+
+  auto state1 = createState(0.1);
+  auto state2 = createState(0.5);
+  auto state3 = createState(0.9);
+
+  cached.isSatisfied(state1);
+  cached.isSatisfied(state2);
+  cached.isSatisfied(state1);
+  cached.isSatisfied(state3); // Evicts state2.
+  EXPECT_EQ(2u, cached.getSize());
+  EXPECT_EQ(3, mConstraint->mNumCalls);
+
+  cached.isSatisfied(state1);
+  EXPECT_EQ(3, mConstraint->mNumCalls);
+
+  cached.isSatisfied(state2);
+  EXPECT_EQ(4, mConstraint->mNumCalls);
+}
+
+TEST_F(CachedTestableTest, OutcomeBypassesCache)
+{
+  CachedTestable cached(mConstraint, 0.1);
+  auto state = createState(0.5);
+
+  auto outcome = cached.createOutcome();
+  cached.isSatisfied(state, outcome.get());
+  cached.isSatisfied(state, outcome.get());
+  EXPECT_EQ(2, mConstraint->mNumCalls);
+
+  cached.isSatisfied(state);
+  EXPECT_EQ(2, mConstraint->mNumCalls);
+}
+
+TEST_F(CachedTestableTest, IsSatisfiedBatchUsesCache)
+{
+  CachedTestable cached(mConstraint, 0.1);
+
+  auto state1 = createState(0.5);
+  auto state2 = createState(-0.5);
+  auto state3 = createState(1.5);
+  cached.isSatisfied(state2);
+
+  std::vector<const StateSpace::State*> states{
+      state1.getState(), state2.getState(), state3.getState()};
+  std::size_t firstFailure = 0;
+  auto satisfied = cached.isSatisfiedBatch(states, &firstFailure);
+  EXPECT_EQ(1u, firstFailure);
+  EXPECT_TRUE(satisfied[0]);
+  EXPECT_FALSE(satisfied[1]);
+
+  satisfied = cached.isSatisfiedBatch(states);
+  EXPECT_TRUE(satisfied[0]);
+  EXPECT_FALSE(satisfied[1]);
+  EXPECT_TRUE(satisfied[2]);
+  EXPECT_EQ(3, mConstraint->mNumCalls);
+}
+
+TEST_F(CachedTestableTest, WorldChangesInvalidateCache)
+{
+  using dart::dynamics::RevoluteJoint;
+
+  auto world = World::create("world");
+  auto robot = dart::dynamics::Skeleton::create("robot");
+  robot->createJointAndBodyNodePair<RevoluteJoint>();
+  auto obstacle = dart::dynamics::Skeleton::create("obstacle");
+  obstacle->createJointAndBodyNodePair<RevoluteJoint>();
+  world->addSkeleton(robot);
+  world->addSkeleton(obstacle);
+
+  CachedTestable cached(mConstraint, 0.1, 100u, world, robot);
+  auto state = createState(0.5);
+
+  cached.isSatisfied(state);
+  cached.isSatisfied(state);
+  EXPECT_EQ(1, mConstraint->mNumCalls);
+
+  // The DOFs of the planned MetaSkeleton are ignored.
+  robot->setPosition(0, 1.0);
+  cached.isSatisfied(state);
+  EXPECT_EQ(1, mConstraint->mNumCalls);
+
+  obstacle->setPosition(0, 1.0);
+  cached.isSatisfied(state);
+  EXPECT_EQ(2, mConstraint->mNumCalls);
+
+  world->addSkeleton(dart::dynamics::Skeleton::create("new"));
+  cached.isSatisfied(state);
+  EXPECT_EQ(3, mConstraint->mNumCalls);
+}
+
+TEST_F(CachedTestableTest, DoesNotUnshareCopyOnWriteSkeletons)
+{
+  using dart::dynamics::RevoluteJoint;
+
+  auto world = World::create("world");
+  auto robot = dart::dynamics::Skeleton::create("robot");
+  robot->createJointAndBodyNodePair<RevoluteJoint>();
+  auto obstacle = dart::dynamics::Skeleton::create("obstacle");
+  obstacle->createJointAndBodyNodePair<RevoluteJoint>();
+  world->addSkeleton(robot);
+  world->addSkeleton(obstacle);
+
+  std::shared_ptr<World> clone
+      = world->clone("clone", World::CloneMode::COPY_ON_WRITE);
+  ASSERT_TRUE(clone->isSkeletonShared(0));
+  ASSERT_TRUE(clone->isSkeletonShared(1));
+
+  CachedTestable cached(mConstraint, 0.1, 100u, clone, robot);
+  auto state = createState(0.5);
+
+  cached.isSatisfied(state);
+  cached.isSatisfied(state);
+  EXPECT_EQ(1, mConstraint->mNumCalls);
+  EXPECT_TRUE(clone->isSkeletonShared(0));
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+
+  // Changes to an unshared Skeleton still invalidate the cache.
+  clone->getSkeleton(1)->setPosition(0, 1.0);
+  cached.isSatisfied(state);
+  EXPECT_EQ(2, mConstraint->mNumCalls);
+  EXPECT_TRUE(clone->isSkeletonShared(0));
+}
@@ -1,3 +1,5 @@
+#include <atomic>
+#include <thread>
 #include <tuple>
 
 #include <dart/dart.hpp>
@@ -5,11 +7,16 @@
 
 #include <aikido/common/RNG.hpp>
 #include <aikido/constraint/Testable.hpp>
+#include <aikido/constraint/dart/TSR.hpp>
 #include <aikido/distance/defaults.hpp>
 #include <aikido/planner/ConfigurationToConfiguration.hpp>
 #include <aikido/planner/ConfigurationToConfigurationPlanner.hpp>
+#include <aikido/planner/PlanningContextPool.hpp>
 #include <aikido/planner/SnapConfigurationToConfigurationPlanner.hpp>
+#include <aikido/planner/World.hpp>
+#include <aikido/planner/dart/ConfigurationToConfiguration_to_ConfigurationToConfigurations.hpp>
 #include <aikido/planner/dart/ConfigurationToConfiguration_to_ConfigurationToTSR.hpp>
+#include <aikido/planner/dart/ConfigurationToTSR.hpp>
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
@@ -24,7 +31,14 @@ using std::make_shared;
 using std::shared_ptr;
 
 using aikido::planner::ConfigurationToConfigurationPlanner;
+using aikido::planner::PlanningContextPool;
+using aikido::constraint::dart::TSR;
+using aikido::planner::World;
+using aikido::planner::dart::ConfigurationToConfigurations;
+using aikido::planner::dart::
+    ConfigurationToConfiguration_to_ConfigurationToConfigurations;
 using aikido::planner::dart::ConfigurationToConfiguration_to_ConfigurationToTSR;
+using aikido::planner::dart::ConfigurationToTSR;
 
 //==============================================================================
 class SnapPlannerTest : public ::testing::Test
@@ -91,6 +105,123 @@ public:
   }
 };
 
+//==============================================================================
+/// Snaps to goals beyond a threshold, and runs until it is stopped for the
+/// other goals.
+class StoppablePlanner : public ConfigurationToConfigurationPlanner
+{
+public:
+  StoppablePlanner(
+      aikido::statespace::ConstStateSpacePtr stateSpace,
+      aikido::statespace::ConstInterpolatorPtr interpolator)
+    : ConfigurationToConfigurationPlanner(stateSpace)
+    , mSnapPlanner(std::move(stateSpace), std::move(interpolator))
+    , mStopRequested(false)
+  {
+    // Do nothing
+  }
+
+  aikido::trajectory::TrajectoryPtr plan(
+      const SolvableProblem& problem, Result* result = nullptr) override
+  {
+    Eigen::VectorXd goal;
+    mStateSpace->logMap(problem.getGoalState(), goal);
+    if (goal[0] > 1.0)
+      return mSnapPlanner.plan(problem, result);
+
+    while (!mStopRequested)
+      std::this_thread::yield();
+    mStopRequested = false;
+    return nullptr;
+  }
+
+  bool stopPlanning() override
+  {
+    mStopRequested = true;
+    return true;
+  }
+
+  void clearStopRequest() override
+  {
+    mStopRequested = false;
+  }
+
+private:
+  SnapConfigurationToConfigurationPlanner mSnapPlanner;
+  std::atomic<bool> mStopRequested;
+};
+
+//==============================================================================
+TEST_F(SnapPlannerTest, PortfolioStopsSlowerGoals)
+{
+  aikido::planner::WorldPtr world = World::create("test");
+  world->addSkeleton(skel);
+
+  auto contextPool = std::make_shared<PlanningContextPool>(
+      world,
+      stateSpace,
+      skel,
+      2,
+      [](const PlanningContextPool::Context& context) {
+        return std::make_shared<PassingConstraint>(context.mStateSpace);
+      });
+
+  auto delegate = std::make_shared<SnapConfigurationToConfigurationPlanner>(
+      stateSpace, interpolator);
+  ConfigurationToConfiguration_to_ConfigurationToConfigurations planner(
+      delegate, skel);
+
+  EXPECT_THROW(
+      planner.setPortfolio(contextPool, nullptr), std::invalid_argument);
+  planner.setPortfolio(contextPool, [this]() {
+    return std::make_shared<StoppablePlanner>(stateSpace, interpolator);
+  });
+  EXPECT_EQ(contextPool, planner.getPortfolioContextPool());
+
+  // The nearest goal is ranked first and only finishes when it is stopped.
+  auto nearGoal = stateSpace->createState();
+  auto farGoal = stateSpace->createState();
+  stateSpace->convertPositionsToState(
+      Eigen::VectorXd::Constant(1, 0.5), nearGoal);
+  stateSpace->convertPositionsToState(
+      Eigen::VectorXd::Constant(1, 2.0), farGoal);
+
+  ConfigurationToConfigurations problem(
+      stateSpace,
+      startState->getState(),
+      {nearGoal.getState(), farGoal.getState()},
+      passingConstraint);
+
+  auto trajectory = planner.plan(problem, &planningResult);
+  ASSERT_NE(nullptr, trajectory);
+
+  auto endState = stateSpace->createState();
+  trajectory->evaluate(trajectory->getEndTime(), endState);
+  Eigen::VectorXd endPositions;
+  stateSpace->convertStateToPositions(endState, endPositions);
+  EXPECT_DOUBLE_EQ(2.0, endPositions[0]);
+
+  // The constraints of the contexts replace the constraint of the problem, so
+  // a constraint in another state space is rejected.
+  ConfigurationToConfigurations mismatchedProblem(
+      stateSpace,
+      startState->getState(),
+      {nearGoal.getState(), farGoal.getState()},
+      make_shared<PassingConstraint>(make_shared<SO2>()));
+  EXPECT_THROW(
+      planner.plan(mismatchedProblem, &planningResult), std::invalid_argument);
+
+  // Stop requests of the failed query do not abort the next one.
+  trajectory = planner.plan(problem, &planningResult);
+  ASSERT_NE(nullptr, trajectory);
+  trajectory->evaluate(trajectory->getEndTime(), endState);
+  stateSpace->convertStateToPositions(endState, endPositions);
+  EXPECT_DOUBLE_EQ(2.0, endPositions[0]);
+
+  planner.setPortfolio(nullptr, nullptr);
+  EXPECT_EQ(nullptr, planner.getPortfolioContextPool());
+}
+
 //==============================================================================
 TEST_F(SnapPlannerTest, DartConfigurationToTSRPlanner)
 {
@@ -102,4 +233,76 @@ TEST_F(SnapPlannerTest, DartConfigurationToTSRPlanner)
   auto planner
       = std::make_shared<ConfigurationToConfiguration_to_ConfigurationToTSR>(
           delegate, skel);
+
+  EXPECT_EQ(100u, planner->getMaxNumGoalSamples());
+  EXPECT_EQ(0u, planner->getGoalQueueCapacity());
+
+  planner->setMaxNumGoalSamples(10u);
+  planner->setGoalQueueCapacity(4u);
+  EXPECT_EQ(10u, planner->getMaxNumGoalSamples());
+  EXPECT_EQ(4u, planner->getGoalQueueCapacity());
+}
+
+//==============================================================================
+TEST_F(SnapPlannerTest, DartConfigurationToTSRPlannerStreamsGoals)
+{
+  auto delegate = std::make_shared<SnapConfigurationToConfigurationPlanner>(
+      stateSpace, interpolator);
+  ConfigurationToConfiguration_to_ConfigurationToTSR planner(delegate, skel);
+
+  // The planner stops sampling once the first goal is reached, long before
+  // the maximum number of samples.
+  planner.setMaxNumGoalSamples(1000u);
+  planner.setGoalQueueCapacity(2u);
+
+  // The joint rotates the end-effector about the z-axis.
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.linear() = Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ()).matrix();
+  auto tsr = std::make_shared<TSR>(T0_w);
+
+  ConfigurationToTSR problem(
+      stateSpace,
+      startState->getState(),
+      jn_bn.second,
+      1000u,
+      tsr,
+      passingConstraint);
+
+  auto trajectory = planner.plan(problem, &planningResult);
+  ASSERT_NE(nullptr, trajectory);
+
+  auto endState = stateSpace->createState();
+  trajectory->evaluate(trajectory->getEndTime(), endState);
+  Eigen::VectorXd endPositions;
+  stateSpace->convertStateToPositions(endState, endPositions);
+  EXPECT_NEAR(0.5, endPositions[0], 1e-3);
+
+  // Planning restores the positions of the MetaSkeleton.
+  EXPECT_DOUBLE_EQ(0.0, skel->getPosition(0));
+}
+
+//==============================================================================
+TEST_F(SnapPlannerTest, DartConfigurationToTSRPlannerStreamsFailingGoals)
+{
+  auto delegate = std::make_shared<SnapConfigurationToConfigurationPlanner>(
+      stateSpace, interpolator);
+  ConfigurationToConfiguration_to_ConfigurationToTSR planner(delegate, skel);
+
+  // The sampler waits on the full queue until the delegate fails each goal.
+  planner.setMaxNumGoalSamples(10u);
+  planner.setGoalQueueCapacity(1u);
+
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.linear() = Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ()).matrix();
+  auto tsr = std::make_shared<TSR>(T0_w);
+
+  ConfigurationToTSR problem(
+      stateSpace,
+      startState->getState(),
+      jn_bn.second,
+      10u,
+      tsr,
+      failingConstraint);
+
+  EXPECT_EQ(nullptr, planner.plan(problem, &planningResult));
 }
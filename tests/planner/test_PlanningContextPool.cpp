@@ -0,0 +1,137 @@
+#include <thread>
+
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+
+#include <aikido/constraint/Satisfied.hpp>
+#include <aikido/planner/PlanningContextPool.hpp>
+
+using aikido::planner::PlanningContextPool;
+using aikido::planner::World;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+
+class PlanningContextPoolTest : public ::testing::Test
+{
+public:
+  using SkeletonPtr = dart::dynamics::SkeletonPtr;
+
+  void SetUp() override
+  {
+    using dart::dynamics::RevoluteJoint;
+
+    mWorld = World::create("test");
+
+    mRobot = dart::dynamics::Skeleton::create("robot");
+    auto bn = mRobot->createJointAndBodyNodePair<RevoluteJoint>().second;
+    mRobot->createJointAndBodyNodePair<RevoluteJoint>(bn);
+    mWorld->addSkeleton(mRobot);
+
+    mObstacle = dart::dynamics::Skeleton::create("obstacle");
+    mObstacle->createJointAndBodyNodePair<RevoluteJoint>();
+    mWorld->addSkeleton(mObstacle);
+
+    mStateSpace = std::make_shared<MetaSkeletonStateSpace>(mRobot.get());
+  }
+
+  aikido::planner::WorldPtr mWorld;
+  SkeletonPtr mRobot;
+  SkeletonPtr mObstacle;
+  std::shared_ptr<MetaSkeletonStateSpace> mStateSpace;
+};
+
+TEST_F(PlanningContextPoolTest, ThrowsOnSkeletonNotInWorld)
+{
+  auto skeleton = dart::dynamics::Skeleton::create("other");
+  EXPECT_THROW(
+      PlanningContextPool(mWorld, mStateSpace, skeleton, 1),
+      std::invalid_argument);
+}
+
+TEST_F(PlanningContextPoolTest, ContextsAreIndependentClones)
+{
+  PlanningContextPool pool(mWorld, mStateSpace, mRobot, 2);
+  EXPECT_EQ(2u, pool.getNumContexts());
+  EXPECT_EQ(2u, pool.getNumAvailableContexts());
+
+  auto context1 = pool.acquire();
+  auto context2 = pool.acquire();
+  EXPECT_EQ(0u, pool.getNumAvailableContexts());
+  EXPECT_FALSE(pool.tryAcquire());
+
+  EXPECT_NE(mWorld, context1->mWorld);
+  EXPECT_NE(context1->mWorld, context2->mWorld);
+  EXPECT_NE(mRobot, context1->mSkeleton);
+  EXPECT_EQ(mRobot->getName(), context1->mSkeleton->getName());
+  EXPECT_EQ(mStateSpace, context1->mStateSpace);
+  EXPECT_EQ(mRobot->getNumDofs(), context1->mMetaSkeleton->getNumDofs());
+
+  context1->mMetaSkeleton->setPosition(0, 1.0);
+  EXPECT_DOUBLE_EQ(0.0, mRobot->getPosition(0));
+  EXPECT_DOUBLE_EQ(0.0, context2->mSkeleton->getPosition(0));
+
+  context1.release();
+  EXPECT_EQ(1u, pool.getNumAvailableContexts());
+}
+
+TEST_F(PlanningContextPoolTest, AcquireSynchronizesWithWorld)
+{
+  PlanningContextPool pool(mWorld, mStateSpace, mRobot, 1);
+
+  mRobot->setPosition(1, 0.5);
+  mObstacle->setPosition(0, -0.5);
+
+  {
+    auto context = pool.acquire();
+    EXPECT_DOUBLE_EQ(0.5, context->mSkeleton->getPosition(1));
+    EXPECT_DOUBLE_EQ(
+        -0.5, context->mWorld->getSkeleton("obstacle")->getPosition(0));
+
+    context->mSkeleton->setPosition(1, 2.0);
+  }
+
+  auto context = pool.acquire();
+  EXPECT_DOUBLE_EQ(0.5, context->mSkeleton->getPosition(1));
+}
+
+TEST_F(PlanningContextPoolTest, AcquireReclonesChangedWorld)
+{
+  int numConstraints = 0;
+  PlanningContextPool pool(
+      mWorld,
+      mStateSpace,
+      mRobot,
+      1,
+      [&](const PlanningContextPool::Context& context) {
+        ++numConstraints;
+        return std::make_shared<aikido::constraint::Satisfied>(
+            context.mStateSpace);
+      });
+  EXPECT_EQ(1, numConstraints);
+
+  mWorld->addSkeleton(dart::dynamics::Skeleton::create("new"));
+
+  auto context = pool.acquire();
+  EXPECT_EQ(2, numConstraints);
+  EXPECT_TRUE(context->mConstraint != nullptr);
+  EXPECT_EQ(3u, context->mWorld->getNumSkeletons());
+  EXPECT_TRUE(context->mWorld->getSkeleton("new") != nullptr);
+}
+
+TEST_F(PlanningContextPoolTest, AcquireBlocksUntilRelease)
+{
+  PlanningContextPool pool(mWorld, mStateSpace, mRobot, 1);
+
+  auto context = pool.acquire();
+  auto* contextPtr = context.get();
+
+  std::thread thread([&]() {
+    auto otherContext = pool.acquire();
+    EXPECT_EQ(contextPtr, otherContext.get());
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  context.release();
+  thread.join();
+
+  EXPECT_EQ(1u, pool.getNumAvailableContexts());
+}
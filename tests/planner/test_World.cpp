@@ -165,3 +165,159 @@ TEST_F(WorldTest, SetStateThrowsErrorsOnWorldsWithSkeletonsWithDifferentNames)
   state = clonedWorld->getState();
   EXPECT_THROW(mWorld->setState(state), std::invalid_argument);
 }
+
+TEST_F(WorldTest, VersionsIncreaseOnlyWhenPositionsChange)
+{
+  using dart::dynamics::RevoluteJoint;
+
+  skel1->createJointAndBodyNodePair<RevoluteJoint>();
+  skel2->createJointAndBodyNodePair<RevoluteJoint>();
+
+  const auto emptyVersion = mWorld->getVersion();
+  mWorld->addSkeleton(skel1);
+  mWorld->addSkeleton(skel2);
+  const auto version = mWorld->getVersion();
+  EXPECT_LT(emptyVersion, version);
+  EXPECT_EQ(version, mWorld->getVersion());
+  EXPECT_THROW(mWorld->getSkeletonVersion(2), std::out_of_range);
+
+  const auto version1 = mWorld->getSkeletonVersion(0);
+  const auto version2 = mWorld->getSkeletonVersion(1);
+  EXPECT_LE(version1, version);
+  EXPECT_LE(version2, version);
+
+  skel2->setPosition(0, 0.5);
+  EXPECT_EQ(version1, mWorld->getSkeletonVersion(0));
+  EXPECT_LT(version2, mWorld->getSkeletonVersion(1));
+  EXPECT_LT(version, mWorld->getVersion());
+
+  // Setting the same positions is not a change.
+  const auto newVersion = mWorld->getVersion();
+  skel2->setPosition(0, 0.5);
+  EXPECT_EQ(newVersion, mWorld->getVersion());
+
+  mWorld->removeSkeleton(skel1);
+  EXPECT_LT(newVersion, mWorld->getVersion());
+}
+
+TEST_F(WorldTest, RestoreSnapshotSetsOnlyChangedSkeletons)
+{
+  using dart::dynamics::RevoluteJoint;
+
+  skel1->createJointAndBodyNodePair<RevoluteJoint>();
+  skel2->createJointAndBodyNodePair<RevoluteJoint>();
+  skel3->createJointAndBodyNodePair<RevoluteJoint>();
+  mWorld->addSkeleton(skel1);
+  mWorld->addSkeleton(skel2);
+  mWorld->addSkeleton(skel3);
+  skel1->setPosition(0, 0.1);
+  skel2->setPosition(0, 0.2);
+  skel3->setPosition(0, 0.3);
+
+  const auto state = mWorld->getState();
+  const auto snapshot = mWorld->createSnapshot();
+  EXPECT_EQ(0u, mWorld->restoreSnapshot(snapshot));
+
+  skel2->setPosition(0, 1.0);
+  EXPECT_EQ(1u, mWorld->restoreSnapshot(snapshot));
+  EXPECT_DOUBLE_EQ(0.2, skel2->getPosition(0));
+  EXPECT_TRUE(state == mWorld->getState());
+
+  // Removed Skeletons are ignored.
+  skel1->setPosition(0, 1.0);
+  skel3->setPosition(0, 1.0);
+  mWorld->removeSkeleton(skel1);
+  EXPECT_EQ(1u, mWorld->restoreSnapshot(snapshot));
+  EXPECT_DOUBLE_EQ(1.0, skel1->getPosition(0));
+  EXPECT_DOUBLE_EQ(0.3, skel3->getPosition(0));
+}
+
+TEST_F(WorldTest, CopyOnWriteCloneClonesSkeletonsOnAccess)
+{
+  using aikido::planner::World;
+  using dart::dynamics::RevoluteJoint;
+
+  skel1->createJointAndBodyNodePair<RevoluteJoint>();
+  skel2->createJointAndBodyNodePair<RevoluteJoint>();
+  mWorld->addSkeleton(skel1);
+  mWorld->addSkeleton(skel2);
+  skel1->setPosition(0, 0.1);
+  skel2->setPosition(0, 0.2);
+
+  auto clone = mWorld->clone("clone", World::CloneMode::COPY_ON_WRITE);
+  ASSERT_EQ(2u, clone->getNumSkeletons());
+  EXPECT_TRUE(clone->isSkeletonShared(0));
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+
+  // Positions are recorded when cloning.
+  skel1->setPosition(0, 1.0);
+  const auto version = clone->getVersion();
+  EXPECT_TRUE(clone->isSkeletonShared(0));
+
+  auto clonedSkel1 = clone->getSkeleton("skel1");
+  ASSERT_TRUE(clonedSkel1 != nullptr);
+  EXPECT_NE(skel1, clonedSkel1);
+  EXPECT_EQ("skel1", clonedSkel1->getName());
+  EXPECT_DOUBLE_EQ(0.1, clonedSkel1->getPosition(0));
+  EXPECT_FALSE(clone->isSkeletonShared(0));
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+  EXPECT_EQ(clonedSkel1, clone->getSkeleton(0));
+  EXPECT_TRUE(clone->hasSkeleton(clonedSkel1));
+  EXPECT_EQ(version, clone->getVersion());
+
+  // Clones of a clone share the original Skeletons that are still shared.
+  auto clone2 = clone->clone("clone2", World::CloneMode::COPY_ON_WRITE);
+  EXPECT_DOUBLE_EQ(0.1, clone2->getSkeleton(0)->getPosition(0));
+  EXPECT_DOUBLE_EQ(0.2, clone2->getSkeleton(1)->getPosition(0));
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+
+  auto deepClone = clone->clone("deep");
+  EXPECT_FALSE(deepClone->isSkeletonShared(1));
+  EXPECT_EQ("skel2", deepClone->getSkeleton(1)->getName());
+  EXPECT_DOUBLE_EQ(0.2, deepClone->getSkeleton(1)->getPosition(0));
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+
+  // Snapshots refer to shared Skeletons through their source.
+  const auto snapshot = clone->createSnapshot();
+  EXPECT_TRUE(clone->isSkeletonShared(1));
+  clone->getSkeleton(1)->setPosition(0, 2.0);
+  EXPECT_EQ(1u, clone->restoreSnapshot(snapshot));
+  EXPECT_DOUBLE_EQ(0.2, clone->getSkeleton(1)->getPosition(0));
+  EXPECT_DOUBLE_EQ(1.0, skel1->getPosition(0));
+  EXPECT_DOUBLE_EQ(0.2, skel2->getPosition(0));
+}
+
+TEST_F(WorldTest, CopyOnWriteCloneReadsSharedSkeletonsWithoutCloning)
+{
+  using aikido::planner::World;
+  using dart::dynamics::RevoluteJoint;
+
+  skel1->createJointAndBodyNodePair<RevoluteJoint>();
+  mWorld->addSkeleton(skel1);
+  skel1->setPosition(0, 0.1);
+
+  // Cloning does not lock the mutexes of the Skeletons, so the caller may
+  // hold them.
+  std::unique_ptr<World> clone;
+  {
+    std::lock_guard<std::mutex> lock(skel1->getMutex());
+    clone = mWorld->clone("clone", World::CloneMode::COPY_ON_WRITE);
+  }
+
+  // The original stands in for the clone while it has not moved.
+  EXPECT_EQ(skel1, clone->getConstSkeleton(0));
+  EXPECT_EQ(skel1, clone->getConstSkeleton("skel1"));
+  const auto state = clone->getState();
+  EXPECT_TRUE(clone->isSkeletonShared(0));
+
+  skel1->setPosition(0, 1.0);
+  auto clonedSkel1 = clone->getConstSkeleton(0);
+  EXPECT_NE(skel1, clonedSkel1);
+  EXPECT_DOUBLE_EQ(0.1, clonedSkel1->getPosition(0));
+  EXPECT_FALSE(clone->isSkeletonShared(0));
+  EXPECT_EQ(clone->getSkeleton(0), clonedSkel1);
+  EXPECT_TRUE(state == clone->getState());
+
+  EXPECT_EQ(nullptr, clone->getConstSkeleton(1));
+  EXPECT_EQ(nullptr, clone->getConstSkeleton("skel2"));
+}
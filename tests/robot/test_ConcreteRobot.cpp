@@ -0,0 +1,119 @@
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+
+#include <aikido/common/RNG.hpp>
+#include <aikido/robot/ConcreteRobot.hpp>
+
+using aikido::common::RNGWrapper;
+using aikido::constraint::dart::SelfCollisionMatrix;
+using aikido::robot::ConcreteRobot;
+
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+class ConcreteRobotTest : public ::testing::Test
+{
+protected:
+  /// Creates a box BodyNode welded to mBase.
+  BodyNode* createWeldedBox(const std::string& name)
+  {
+    WeldJoint::Properties properties;
+    properties.mName = name + "_joint";
+
+    BodyNode::Properties bodyProperties;
+    bodyProperties.mName = name;
+
+    auto bodyNode = mSkeleton
+                        ->createJointAndBodyNodePair<WeldJoint>(
+                            mBase, properties, bodyProperties)
+                        .second;
+    bodyNode->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+    return bodyNode;
+  }
+
+  /// Creates a robot named \c name for \c metaSkeleton.
+  std::unique_ptr<ConcreteRobot> createRobot(
+      const std::string& name, MetaSkeletonPtr metaSkeleton)
+  {
+    return std::unique_ptr<ConcreteRobot>(new ConcreteRobot(
+        name,
+        std::move(metaSkeleton),
+        true,
+        aikido::common::UniqueRNGPtr(
+            new RNGWrapper<std::default_random_engine>(0)),
+        nullptr,
+        mCollisionDetector,
+        nullptr));
+  }
+
+  void SetUp() override
+  {
+    mSkeleton = Skeleton::create("Robot");
+
+    BodyNode::Properties baseProperties;
+    baseProperties.mName = "base";
+    mBase = mSkeleton
+                ->createJointAndBodyNodePair<RevoluteJoint>(
+                    nullptr, RevoluteJoint::Properties(), baseProperties)
+                .second;
+
+    // Siblings that always overlap.
+    createWeldedBox("sibling1");
+    createWeldedBox("sibling2");
+
+    mCollisionDetector = FCLCollisionDetector::create();
+  }
+
+  SkeletonPtr mSkeleton;
+  BodyNode* mBase;
+  CollisionDetectorPtr mCollisionDetector;
+};
+
+//==============================================================================
+TEST_F(ConcreteRobotTest, SubRobotSetsSelfCollisionMatrixOfRoot)
+{
+  auto robot = createRobot("robot", mSkeleton);
+  auto arm = createRobot(
+      "arm",
+      Group::create(
+          "arm",
+          {mBase,
+           mSkeleton->getBodyNode("sibling1"),
+           mSkeleton->getBodyNode("sibling2")}));
+  arm->setRoot(robot.get());
+
+  const auto space = robot->getStateSpace();
+  const auto state = space->getScopedStateFromMetaSkeleton(mSkeleton.get());
+  EXPECT_FALSE(
+      robot->getSelfCollisionConstraint(space, mSkeleton)->isSatisfied(state));
+
+  auto matrix = std::make_shared<SelfCollisionMatrix>();
+  matrix->disable("sibling1", "sibling2");
+  arm->setSelfCollisionMatrix(matrix);
+
+  // The constraint of the sub-robot is the one of its root.
+  EXPECT_EQ(matrix, robot->getSelfCollisionMatrix());
+  EXPECT_EQ(matrix, arm->getSelfCollisionMatrix());
+  EXPECT_TRUE(
+      robot->getSelfCollisionConstraint(space, mSkeleton)->isSatisfied(state));
+  EXPECT_TRUE(
+      arm->getSelfCollisionConstraint(space, mSkeleton)->isSatisfied(state));
+}
+
+//==============================================================================
+TEST_F(ConcreteRobotTest, SubRobotComputesSelfCollisionMatrixOfRoot)
+{
+  auto robot = createRobot("robot", mSkeleton);
+  auto arm = createRobot("arm", mSkeleton);
+  arm->setRoot(robot.get());
+
+  const auto matrix = arm->computeSelfCollisionMatrix(10u);
+  EXPECT_TRUE(matrix->isDisabled("sibling1", "sibling2"));
+  EXPECT_EQ(matrix, robot->getSelfCollisionMatrix());
+
+  const auto space = robot->getStateSpace();
+  const auto state = space->getScopedStateFromMetaSkeleton(mSkeleton.get());
+  EXPECT_TRUE(
+      robot->getSelfCollisionConstraint(space, mSkeleton)->isSatisfied(state));
+}
@@ -239,3 +239,63 @@ TEST(MetaSkeletonStateSpace, MultipleJoints_CreatesCartesianProduct)
   EXPECT_EQ(5 - 2 * M_PI, substate1.toAngle());
   EXPECT_TRUE(value2.isApprox(substate2.getValue()));
 }
+
+TEST(MetaSkeletonStateSpace, InterleavedDofs_MapsPositionsToJoints)
+{
+  auto skeleton = Skeleton::create();
+  auto joint1 = skeleton->createJointAndBodyNodePair<RevoluteJoint>().first;
+  auto joint2
+      = skeleton->createJointAndBodyNodePair<TranslationalJoint>().first;
+  joint1->setPositionLowerLimit(0, -10.);
+
+  // The DOFs of joint2 surround the DOF of joint1, so the joints are not in
+  // DOF order.
+  auto group = dart::dynamics::Group::create(
+      "group",
+      std::vector<dart::dynamics::DegreeOfFreedom*>{joint2->getDof(0),
+                                                    joint1->getDof(0),
+                                                    joint2->getDof(1),
+                                                    joint2->getDof(2)},
+      false,
+      false);
+
+  MetaSkeletonStateSpace space(group.get());
+  ASSERT_EQ(2, space.getNumSubspaces());
+
+  auto state = space.createState();
+  auto substate1 = state.getSubStateHandle<R3>(0);
+  auto substate2 = state.getSubStateHandle<R1>(1);
+
+  const Eigen::Vector4d positions(1., 2., 3., 4.);
+  group->setPositions(positions);
+  space.getState(group.get(), state);
+  EXPECT_TRUE(Vector3d(1., 3., 4.).isApprox(substate1.getValue()));
+  EXPECT_DOUBLE_EQ(2., substate2.getValue()[0]);
+
+  Eigen::VectorXd converted;
+  space.convertStateToPositions(state, converted);
+  EXPECT_TRUE(positions.isApprox(converted));
+
+  substate1.setValue(Vector3d(5., 6., 7.));
+  substate2.setValue(make_scalar(8.));
+  space.setState(group.get(), state);
+  EXPECT_TRUE(Eigen::Vector4d(5., 8., 6., 7.).isApprox(group->getPositions()));
+
+  auto roundTrip = space.createState();
+  space.convertPositionsToState(group->getPositions(), roundTrip);
+  space.convertStateToPositions(roundTrip, converted);
+  EXPECT_TRUE(group->getPositions().isApprox(converted));
+
+  EXPECT_THROW(
+      space.convertPositionsToState(Eigen::Vector3d::Zero(), roundTrip),
+      std::invalid_argument);
+
+  // A MetaSkeleton with a different number of DOFs is rejected both ways.
+  auto smallGroup = dart::dynamics::Group::create(
+      "smallGroup",
+      std::vector<dart::dynamics::DegreeOfFreedom*>{joint1->getDof(0)},
+      false,
+      false);
+  EXPECT_THROW(space.getState(smallGroup.get(), state), std::invalid_argument);
+  EXPECT_THROW(space.setState(smallGroup.get(), state), std::invalid_argument);
+}
@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include <aikido/statespace/ArenaStateAllocator.hpp>
+#include <aikido/statespace/PoolStateAllocator.hpp>
+#include <aikido/statespace/Rn.hpp>
+
+using aikido::statespace::ArenaStateAllocator;
+using aikido::statespace::PoolStateAllocator;
+using aikido::statespace::R3;
+
+namespace {
+
+//==============================================================================
+bool isAligned(const void* buffer)
+{
+  return reinterpret_cast<std::uintptr_t>(buffer) % alignof(std::max_align_t)
+         == 0u;
+}
+
+} // namespace
+
+//==============================================================================
+TEST(PoolStateAllocator, ThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(PoolStateAllocator(0u), std::invalid_argument);
+  EXPECT_THROW(PoolStateAllocator(8u, 0u), std::invalid_argument);
+
+  PoolStateAllocator allocator(8u);
+  EXPECT_THROW(
+      allocator.allocate(allocator.getBlockSize() + 1), std::invalid_argument);
+}
+
+//==============================================================================
+TEST(PoolStateAllocator, ReusesFreedBlocks)
+{
+  R3 space;
+  PoolStateAllocator allocator(space, 4u);
+  EXPECT_LE(space.getStateSizeInBytes(), allocator.getBlockSize());
+
+  std::set<void*> buffers;
+  for (int i = 0; i < 6; ++i)
+  {
+    void* buffer = allocator.allocate(space.getStateSizeInBytes());
+    EXPECT_TRUE(isAligned(buffer));
+    buffers.insert(buffer);
+  }
+  EXPECT_EQ(6u, buffers.size());
+  EXPECT_EQ(6u, allocator.getNumAllocatedBlocks());
+  EXPECT_EQ(2u, allocator.getNumChunks());
+
+  void* freed = *buffers.begin();
+  allocator.deallocate(freed, space.getStateSizeInBytes());
+  EXPECT_EQ(5u, allocator.getNumAllocatedBlocks());
+  EXPECT_EQ(freed, allocator.allocate(space.getStateSizeInBytes()));
+  EXPECT_EQ(2u, allocator.getNumChunks());
+
+  for (void* buffer : buffers)
+    allocator.deallocate(buffer, space.getStateSizeInBytes());
+  EXPECT_EQ(0u, allocator.getNumAllocatedBlocks());
+}
+
+//==============================================================================
+TEST(PoolStateAllocator, AllocatesStatesOfStateSpace)
+{
+  R3 space;
+  auto allocator = std::make_shared<PoolStateAllocator>(space);
+  space.setStateAllocator(allocator);
+  EXPECT_EQ(allocator, space.getStateAllocator());
+
+  auto state = static_cast<R3::State*>(space.allocateState());
+  space.setValue(state, Eigen::Vector3d(1., 2., 3.));
+  EXPECT_EQ(1u, allocator->getNumAllocatedBlocks());
+
+  {
+    auto scopedState = space.createState();
+    space.copyState(state, scopedState);
+    EXPECT_TRUE(
+        Eigen::Vector3d(1., 2., 3.).isApprox(space.getValue(scopedState)));
+  }
+
+  space.freeState(state);
+  EXPECT_EQ(0u, allocator->getNumAllocatedBlocks());
+
+  space.setStateAllocator(nullptr);
+  state = static_cast<R3::State*>(space.allocateState());
+  EXPECT_EQ(0u, allocator->getNumAllocatedBlocks());
+  space.freeState(state);
+}
+
+//==============================================================================
+TEST(ArenaStateAllocator, ReleasesAllChunks)
+{
+  EXPECT_THROW(ArenaStateAllocator(0u), std::invalid_argument);
+
+  ArenaStateAllocator allocator(64u);
+  EXPECT_EQ(0u, allocator.getNumChunks());
+
+  void* first = allocator.allocate(24u);
+  void* second = allocator.allocate(24u);
+  EXPECT_TRUE(isAligned(first));
+  EXPECT_TRUE(isAligned(second));
+  EXPECT_NE(first, second);
+  EXPECT_EQ(1u, allocator.getNumChunks());
+
+  // Oversized allocations get their own chunk.
+  allocator.allocate(256u);
+  EXPECT_EQ(2u, allocator.getNumChunks());
+
+  allocator.deallocate(first, 24u);
+  EXPECT_EQ(2u, allocator.getNumChunks());
+
+  allocator.release();
+  EXPECT_EQ(0u, allocator.getNumChunks());
+  EXPECT_TRUE(isAligned(allocator.allocate(8u)));
+}
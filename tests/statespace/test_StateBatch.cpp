@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/SO3.hpp>
+#include <aikido/statespace/StateBatch.hpp>
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::statespace::R3;
+using aikido::statespace::SO2;
+using aikido::statespace::SO3;
+using aikido::statespace::StateBatch;
+
+namespace {
+
+//==============================================================================
+std::shared_ptr<CartesianProduct> createVectorizedSpace()
+{
+  return std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::ConstStateSpacePtr>{
+          std::make_shared<R3>(), std::make_shared<SO2>()});
+}
+
+//==============================================================================
+std::shared_ptr<CartesianProduct> createMixedSpace()
+{
+  return std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::ConstStateSpacePtr>{
+          std::make_shared<SO2>(),
+          std::make_shared<R2>(),
+          std::make_shared<SO3>()});
+}
+
+//==============================================================================
+void testInterpolateAndDistance(const std::shared_ptr<CartesianProduct>& space)
+{
+  const std::size_t numStates = 10;
+  const auto dimension = space->getDimension();
+  GeodesicInterpolator interpolator(space);
+
+  StateBatch from(space, numStates);
+  StateBatch to(space, numStates);
+
+  auto fromState = space->createState();
+  auto toState = space->createState();
+  auto expected = space->createState();
+  auto actual = space->createState();
+
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    space->expMap(3.0 * Eigen::VectorXd::Random(dimension), fromState);
+    space->expMap(3.0 * Eigen::VectorXd::Random(dimension), toState);
+    from.setState(i, fromState);
+    to.setState(i, toState);
+  }
+
+  StateBatch out(space);
+  out.interpolate(from, to, 0.3);
+  ASSERT_EQ(numStates, out.getNumStates());
+
+  Eigen::VectorXd distances;
+  from.distance(to, distances);
+  ASSERT_EQ(static_cast<int>(numStates), distances.size());
+
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    from.getState(i, fromState);
+    to.getState(i, toState);
+
+    interpolator.interpolate(fromState, toState, 0.3, expected);
+    out.getState(i, actual);
+
+    Eigen::VectorXd expectedTangent;
+    Eigen::VectorXd actualTangent;
+    space->logMap(expected, expectedTangent);
+    space->logMap(actual, actualTangent);
+    EXPECT_TRUE(expectedTangent.isApprox(actualTangent, 1e-9));
+
+    double expectedDistance = 0.0;
+    for (std::size_t j = 0; j < space->getNumSubspaces(); ++j)
+    {
+      const auto subspace = space->getSubspace<>(j);
+      GeodesicInterpolator subInterpolator(subspace);
+      expectedDistance += subInterpolator
+                              .getTangentVector(
+                                  space->getSubState<>(fromState, j),
+                                  space->getSubState<>(toState, j))
+                              .norm();
+    }
+    EXPECT_NEAR(expectedDistance, distances[i], 1e-9);
+  }
+
+  // Distances to a single state
+  to.getState(0, toState);
+  from.distance(toState, distances);
+  Eigen::VectorXd pairDistances;
+  StateBatch toFirst(space, numStates);
+  for (std::size_t i = 0; i < numStates; ++i)
+    toFirst.setState(i, toState);
+  from.distance(toFirst, pairDistances);
+  EXPECT_TRUE(distances.isApprox(pairDistances));
+}
+
+} // namespace
+
+//==============================================================================
+TEST(StateBatch, ThrowsOnNullStateSpace)
+{
+  EXPECT_THROW(StateBatch(nullptr), std::invalid_argument);
+}
+
+//==============================================================================
+TEST(StateBatch, IsVectorized)
+{
+  EXPECT_TRUE(StateBatch(createVectorizedSpace()).isVectorized());
+  EXPECT_TRUE(StateBatch(std::make_shared<R3>()).isVectorized());
+  EXPECT_FALSE(StateBatch(createMixedSpace()).isVectorized());
+}
+
+//==============================================================================
+TEST(StateBatch, NewStatesAreIdentity)
+{
+  auto space = createMixedSpace();
+  StateBatch batch(space, 3);
+  EXPECT_EQ(3u, batch.getNumStates());
+
+  auto state = space->createState();
+  auto identity = space->createState();
+  space->getIdentity(identity);
+
+  Eigen::VectorXd tangent;
+  Eigen::VectorXd identityTangent;
+  space->logMap(identity, identityTangent);
+
+  batch.resize(5);
+  for (std::size_t i = 0; i < batch.getNumStates(); ++i)
+  {
+    batch.getState(i, state);
+    space->logMap(state, tangent);
+    EXPECT_TRUE(tangent.isApprox(identityTangent));
+  }
+
+  EXPECT_THROW(batch.getState(5, state), std::out_of_range);
+}
+
+//==============================================================================
+TEST(StateBatch, ExpMapWrapsAngles)
+{
+  auto space = createVectorizedSpace();
+  StateBatch batch(space);
+
+  Eigen::MatrixXd tangents(2, 4);
+  tangents << 1., 2., 3., 3. * M_PI, -1., -2., -3., -M_PI_2;
+  batch.expMap(tangents);
+  ASSERT_EQ(2u, batch.getNumStates());
+
+  Eigen::MatrixXd logs;
+  batch.logMap(logs);
+  EXPECT_DOUBLE_EQ(M_PI, logs(0, 3));
+  EXPECT_DOUBLE_EQ(-M_PI_2, logs(1, 3));
+  EXPECT_TRUE(logs.leftCols(3).isApprox(tangents.leftCols(3)));
+
+  EXPECT_THROW(batch.expMap(Eigen::MatrixXd(2, 3)), std::invalid_argument);
+}
+
+//==============================================================================
+TEST(StateBatch, InterpolateAndDistanceVectorized)
+{
+  testInterpolateAndDistance(createVectorizedSpace());
+}
+
+//==============================================================================
+TEST(StateBatch, InterpolateAndDistanceGeneric)
+{
+  testInterpolateAndDistance(createMixedSpace());
+}
+
+//==============================================================================
+TEST(StateBatch, InterpolateAlongSegment)
+{
+  for (const auto& space : {createVectorizedSpace(), createMixedSpace()})
+  {
+    GeodesicInterpolator interpolator(space);
+    const auto dimension = space->getDimension();
+
+    auto from = space->createState();
+    auto to = space->createState();
+    space->expMap(3.0 * Eigen::VectorXd::Random(dimension), from);
+    space->expMap(3.0 * Eigen::VectorXd::Random(dimension), to);
+
+    const Eigen::VectorXd alphas = Eigen::VectorXd::LinSpaced(11, 0.0, 1.0);
+    StateBatch batch(space);
+    batch.interpolate(from, to, alphas);
+    ASSERT_EQ(11u, batch.getNumStates());
+
+    auto expected = space->createState();
+    auto actual = space->createState();
+    for (int i = 0; i < alphas.size(); ++i)
+    {
+      interpolator.interpolate(from, to, alphas[i], expected);
+      batch.getState(i, actual);
+
+      Eigen::VectorXd expectedTangent;
+      Eigen::VectorXd actualTangent;
+      space->logMap(expected, expectedTangent);
+      space->logMap(actual, actualTangent);
+      EXPECT_TRUE(expectedTangent.isApprox(actualTangent, 1e-9));
+    }
+  }
+}
+
+//==============================================================================
+TEST(StateBatch, ThrowsOnMismatchedBatches)
+{
+  StateBatch batch1(createVectorizedSpace(), 2);
+  StateBatch batch2(createVectorizedSpace(), 2);
+  StateBatch batch3(batch1.getStateSpace(), 3);
+
+  Eigen::VectorXd distances;
+  EXPECT_THROW(batch1.distance(batch2, distances), std::invalid_argument);
+  EXPECT_THROW(batch1.distance(batch3, distances), std::invalid_argument);
+  EXPECT_THROW(batch1.interpolate(batch1, batch3, 0.5), std::invalid_argument);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE2.hpp>
 #include <aikido/trajectory/BSpline.hpp>
 
 using namespace aikido::statespace;
@@ -119,3 +120,67 @@ TEST_F(BSplineTest, evaluate_EvaluateEnd_ReturnsEnd)
   trajectory.evaluate(1.0, state);
   EXPECT_TRUE(end.isApprox(state.getValue()));
 }
+
+TEST_F(BSplineTest, evaluateBatch_MatchesEvaluate)
+{
+  BSpline::ControlPointVectorType controlPoints0(6);
+  controlPoints0 << 0., 1., 3., -1., 2., 4.;
+  BSpline::ControlPointVectorType controlPoints1(6);
+  controlPoints1 << 1., -2., 0.5, 2., 1., 0.;
+
+  BSpline trajectory(mStateSpace, 3, 6, 1.0, 3.0);
+  trajectory.setControlPoints(0, controlPoints0);
+  trajectory.setControlPoints(1, controlPoints1);
+
+  const Eigen::VectorXd times = Eigen::VectorXd::LinSpaced(2001, 1.0, 3.0);
+  Eigen::MatrixXd positions;
+  trajectory.evaluateBatch(times, positions);
+  ASSERT_EQ(times.size(), positions.rows());
+  ASSERT_EQ(2, positions.cols());
+
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    EXPECT_TRUE(positions.row(i).transpose().isApprox(state.getValue()));
+  }
+
+  // Compare the velocities to central differences of the positions.
+  Eigen::MatrixXd velocities;
+  trajectory.evaluateBatch(times, velocities, 1);
+  const double dt = times[1] - times[0];
+  for (int i = 1; i + 1 < times.size(); ++i)
+  {
+    const Eigen::Vector2d expected
+        = (positions.row(i + 1) - positions.row(i - 1)).transpose() / (2 * dt);
+    EXPECT_TRUE(expected.isApprox(velocities.row(i).transpose(), 1e-4));
+  }
+
+  Eigen::VectorXd tangentVector;
+  trajectory.evaluateDerivative(2.0, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(velocities.row(1000).transpose()));
+
+  trajectory.evaluateBatch(times, velocities, 4);
+  EXPECT_TRUE(velocities.isZero());
+
+  EXPECT_THROW(
+      trajectory.evaluateBatch(Eigen::VectorXd::Constant(1, 4.0), positions),
+      std::invalid_argument);
+}
+
+TEST_F(BSplineTest, evaluateDerivative_NonLinearCoordinates_Throws)
+{
+  BSpline trajectory(std::make_shared<SE2>(), 2, 3);
+
+  Eigen::VectorXd tangentVector;
+  EXPECT_THROW(
+      trajectory.evaluateDerivative(0.5, 1, tangentVector),
+      std::invalid_argument);
+
+  Eigen::MatrixXd values;
+  EXPECT_THROW(
+      trajectory.evaluateBatch(Eigen::VectorXd::Constant(1, 0.5), values, 1),
+      std::invalid_argument);
+  EXPECT_NO_THROW(
+      trajectory.evaluateBatch(Eigen::VectorXd::Constant(1, 0.5), values));
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <aikido/common/ThreadPool.hpp>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/trajectory/Interpolated.hpp>
 #include <aikido/trajectory/util.hpp>
@@ -86,6 +87,32 @@ TEST_F(InterpolatedTest, EvaluateDerivative)
   EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(5. / 4, -2. / 4)));
 }
 
+TEST_F(InterpolatedTest, EvaluateOutOfOrder)
+{
+  auto istate = rvss->createState();
+  Eigen::VectorXd tangentVector;
+
+  // Past the end, then back in time, then across a waypoint.
+  traj->evaluate(9, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(8, 1)));
+  traj->evaluateDerivative(9, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d::Zero()));
+
+  traj->evaluate(2, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(1.5, 1.5)));
+  traj->evaluate(5, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(5.5, 2)));
+  traj->evaluateDerivative(0, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d::Zero()));
+
+  // Waypoints added after a lookup are taken into account.
+  auto s4 = rvss->createState();
+  rvss->setValue(s4, Eigen::Vector2d(0, 1));
+  traj->addWaypoint(4, s4);
+  traj->evaluate(5, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(8. / 3, 1)));
+}
+
 TEST_F(InterpolatedTest, ConcatenateTwoTrajectories)
 {
   auto rvss = make_shared<R2>();
@@ -128,3 +155,39 @@ TEST_F(InterpolatedTest, ConcatenateTwoTrajectories)
   EXPECT_DOUBLE_EQ(
       traj1.getDuration() + traj2.getDuration(), newTraj->getDuration());
 }
+
+TEST_F(InterpolatedTest, EvaluateBatch)
+{
+  Eigen::VectorXd times(7);
+  times << 0, 1.5, 6, 3, 7, 8, 2;
+
+  Eigen::MatrixXd positions;
+  traj->evaluateBatch(times, positions);
+  ASSERT_EQ(7, positions.rows());
+  ASSERT_EQ(2, positions.cols());
+
+  Eigen::MatrixXd velocities;
+  traj->evaluateBatch(times, velocities, 1);
+  ASSERT_EQ(7, velocities.rows());
+
+  auto istate = rvss->createState();
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < times.size(); ++i)
+  {
+    traj->evaluate(times[i], istate);
+    EXPECT_TRUE(positions.row(i).transpose().isApprox(rvss->getValue(istate)));
+
+    traj->evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(velocities.row(i).transpose().isApprox(tangentVector));
+  }
+
+  // Large batches are split across the threads of the given pool.
+  aikido::common::ThreadPool threadPool(4);
+  const Eigen::VectorXd denseTimes = Eigen::VectorXd::LinSpaced(10000, 0, 8);
+  traj->evaluateBatch(denseTimes, positions, 0, &threadPool);
+  for (int i = 0; i < denseTimes.size(); i += 7)
+  {
+    traj->evaluate(denseTimes[i], istate);
+    EXPECT_TRUE(positions.row(i).transpose().isApprox(rvss->getValue(istate)));
+  }
+}
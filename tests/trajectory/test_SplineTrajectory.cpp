@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include <gtest/gtest.h>
 
 #include <aikido/statespace/CartesianProduct.hpp>
@@ -420,3 +422,137 @@ TEST_F(SplineTest, CreatePartialTrajectory)
 
   EXPECT_EQ(partialTraj->getDuration() + 1.0, trajectory.getDuration());
 }
+
+TEST_F(SplineTest, getWaypointTime_ReturnsCumulativeTime)
+{
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(Vector2d(4., 5.), 11., mStartState);
+  trajectory.addSegment(Vector2d(6., 7.), 13.);
+
+  EXPECT_DOUBLE_EQ(3., trajectory.getWaypointTime(0));
+  EXPECT_DOUBLE_EQ(14., trajectory.getWaypointTime(1));
+  EXPECT_DOUBLE_EQ(27., trajectory.getWaypointTime(2));
+  EXPECT_THROW(trajectory.getWaypointTime(3), std::domain_error);
+}
+
+TEST_F(SplineTest, Cursor_MatchesEvaluate)
+{
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(Matrix2d::Zero(), 0.5, mStartState);
+  for (int i = 1; i < 20; ++i)
+  {
+    Eigen::Matrix<double, 2, 3> coefficients;
+    coefficients << 0., i, 1., 0., -i, 2.;
+    trajectory.addSegment(coefficients, 0.1 * i);
+  }
+
+  Spline::Cursor cursor(trajectory);
+  auto expectedState = mStateSpace->createState();
+  auto actualState = mStateSpace->createState();
+  Eigen::VectorXd expected, actual;
+
+  // Sample in order, then jump backwards and past the end.
+  std::vector<double> times;
+  for (double t = 2.; t <= trajectory.getEndTime() + 1.; t += 0.01)
+    times.push_back(t);
+  times.push_back(3.2);
+  times.push_back(trajectory.getWaypointTime(7));
+  times.push_back(trajectory.getWaypointTime(15));
+
+  for (const auto t : times)
+  {
+    trajectory.evaluate(t, expectedState);
+    cursor.evaluate(t, actualState);
+    mStateSpace->logMap(expectedState, expected);
+    mStateSpace->logMap(actualState, actual);
+    EXPECT_TRUE(expected.isApprox(actual)) << "t = " << t;
+
+    trajectory.evaluateDerivative(t, 1, expected);
+    cursor.evaluateDerivative(t, 1, actual);
+    EXPECT_TRUE(expected.isApprox(actual)) << "t = " << t;
+  }
+
+  // Waypoints belong to the segment that ends at them.
+  cursor.evaluate(trajectory.getWaypointTime(15), actualState);
+  EXPECT_EQ(14u, cursor.getSegmentIndex());
+
+  cursor.reset();
+  EXPECT_EQ(0u, cursor.getSegmentIndex());
+}
+
+TEST_F(SplineTest, Cursor_IsEmpty_Throws)
+{
+  Spline trajectory(mStateSpace, 3.);
+  Spline::Cursor cursor(trajectory);
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  EXPECT_THROW(cursor.evaluate(3., state), std::logic_error);
+  EXPECT_THROW(
+      cursor.evaluateDerivative(3., 1, tangentVector), std::logic_error);
+}
+
+TEST_F(SplineTest, evaluateDerivative_MatchesPolynomialDerivatives)
+{
+  Eigen::Matrix<double, 2, 5> coefficients;
+  coefficients << 1., -2., 3., -4., 5., 0.5, 1.5, -2.5, 3.5, -4.5;
+
+  Spline trajectory(mStateSpace, 1.);
+  trajectory.addSegment(coefficients, 2., mStartState);
+
+  const double t = 0.7;
+  Eigen::VectorXd tangentVector;
+  for (int derivative = 1; derivative < 6; ++derivative)
+  {
+    Eigen::VectorXd expected = Eigen::VectorXd::Zero(2);
+    for (int i = derivative; i < coefficients.cols(); ++i)
+    {
+      double factor = 1.;
+      for (int j = 0; j < derivative; ++j)
+        factor *= i - j;
+      expected += factor * std::pow(t, i - derivative) * coefficients.col(i);
+    }
+
+    trajectory.evaluateDerivative(1. + t, derivative, tangentVector);
+    EXPECT_TRUE(expected.isApprox(tangentVector, 1e-12))
+        << "derivative = " << derivative;
+  }
+}
+
+TEST_F(SplineTest, evaluateBatch_MatchesEvaluate)
+{
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(Matrix2d::Zero(), 0.5, mStartState);
+  for (int i = 1; i < 50; ++i)
+  {
+    Eigen::Matrix<double, 2, 3> coefficients;
+    coefficients << 0., i, 1., 0., -i, 2.;
+    trajectory.addSegment(coefficients, 0.01 * i);
+  }
+
+  const Eigen::VectorXd times = Eigen::VectorXd::LinSpaced(
+      5000, trajectory.getStartTime(), trajectory.getEndTime());
+
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory.evaluateBatch(times, positions);
+  trajectory.evaluateBatch(times, velocities, 1);
+  ASSERT_EQ(times.size(), positions.rows());
+  ASSERT_EQ(2, positions.cols());
+  ASSERT_EQ(times.size(), velocities.rows());
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd expected;
+  for (int i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    mStateSpace->logMap(state, expected);
+    EXPECT_TRUE(expected.isApprox(positions.row(i).transpose()));
+
+    trajectory.evaluateDerivative(times[i], 1, expected);
+    EXPECT_TRUE(expected.isApprox(velocities.row(i).transpose()));
+  }
+
+  Spline empty(mStateSpace);
+  EXPECT_THROW(empty.evaluateBatch(times, positions), std::logic_error);
+}